@@ -0,0 +1,75 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions for the benchmark executable only, so every heap allocation is counted
+// whether or not it goes through MemoryTracker. The array and nothrow forms forward to these by default
+namespace {
+    std::atomic<uint64_t> heapAllocations{};
+
+    void* allocate(const size_t size) {
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* allocateAligned(const size_t size, const std::align_val_t alignment) {
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        const auto bytes = static_cast<size_t>(alignment);
+
+#ifdef _WIN32
+        return _aligned_malloc(size == 0 ? 1 : size, bytes);
+#else
+        // aligned_alloc wants the size rounded up to the alignment
+        return std::aligned_alloc(bytes, (std::max<size_t>(size, 1) + bytes - 1) / bytes * bytes);
+#endif
+    }
+
+    void freeAligned(void* pointer) {
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+namespace minecraft::benchmark {
+    uint64_t getHeapAllocationCount() {
+        return heapAllocations.load(std::memory_order_relaxed);
+    }
+}
+
+void* operator new(const size_t size) {
+    if (void* pointer = allocate(size)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new(const size_t size, const std::align_val_t alignment) {
+    if (void* pointer = allocateAligned(size, alignment)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    freeAligned(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+    freeAligned(pointer);
+}
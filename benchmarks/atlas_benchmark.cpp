@@ -0,0 +1,199 @@
+#include "benchmark.hpp"
+#include "block_compression.hpp"
+#include "rect_packer.hpp"
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace minecraft::benchmark {
+    bool runPackBenchmark(const uint64_t count) {
+        system::Random random(1);
+        std::vector<glm::ivec2> sizes(count);
+        long long area = 0;
+
+        for (auto& size : sizes) {
+            size = glm::ivec2(
+                PACK_BENCHMARK_MIN_SIDE + static_cast<int>(random.next() % (PACK_BENCHMARK_MAX_SIDE - PACK_BENCHMARK_MIN_SIDE + 1)),
+                PACK_BENCHMARK_MIN_SIDE + static_cast<int>(random.next() % (PACK_BENCHMARK_MAX_SIDE - PACK_BENCHMARK_MIN_SIDE + 1))
+            );
+            area += static_cast<long long>(size.x) * size.y;
+        }
+
+        // Larger first, as AtlasManager orders its textures
+        std::ranges::sort(sizes, [](const glm::ivec2 a, const glm::ivec2 b) {
+            return std::max(a.x, a.y) > std::max(b.x, b.y);
+        });
+
+        // Grown the way AtlasManager::repackAll grows the atlas, starting from the first size that could hold the area
+        glm::ivec2 atlasSize(static_cast<int>(system::MIN_ATLAS_SIZE));
+        const auto grow = [&atlasSize] {
+            (atlasSize.x < atlasSize.y ? atlasSize.x : atlasSize.y) *= 2;
+            return atlasSize.x <= static_cast<int>(system::MAX_ATLAS_SIZE) && atlasSize.y <= static_cast<int>(system::MAX_ATLAS_SIZE);
+        };
+
+        while (static_cast<long long>(atlasSize.x) * atlasSize.y < area) {
+            if (!grow()) {
+                std::cerr << "Rectangles don't fit a " << system::MAX_ATLAS_SIZE << " atlas" << std::endl;
+                return false;
+            }
+        }
+
+        system::RectPacker packer;
+        unsigned int attempts = 0;
+        double lastSeconds = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+
+        while (true) {
+            const auto attemptStart = std::chrono::steady_clock::now();
+            packer.reset(atlasSize.x, atlasSize.y);
+            attempts++;
+
+            const bool packed = std::ranges::all_of(sizes, [&packer](const glm::ivec2 size) {
+                return packer.insert(size.x, size.y).has_value();
+            });
+
+            lastSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - attemptStart).count();
+
+            if (packed) {
+                break;
+            }
+
+            if (!grow()) {
+                std::cerr << "Rectangles don't fit a " << system::MAX_ATLAS_SIZE << " atlas" << std::endl;
+                return false;
+            }
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Packed " << count << " rectangles into " << atlasSize.x << "x" << atlasSize.y << " in " << seconds * 1e3
+                  << "ms over " << attempts << " attempt(s), last one " << lastSeconds * 1e3 << "ms ("
+                  << static_cast<double>(count) / std::max(lastSeconds, 1e-9) / 1e3 << "k rectangles per second), "
+                  << packer.getOccupancy() * 100.0f << "% occupied" << std::endl;
+
+        return true;
+    }
+
+    bool runDecodeBenchmark(const uint64_t count) {
+        std::error_code error;
+        std::filesystem::create_directories(DECODE_BENCHMARK_DIR, error);
+
+        system::Random random(1);
+        std::vector<system::TextureSource> sources{};
+
+        // Noise compresses about as badly as real block textures, so the PNGs take a realistic time to inflate
+        for (uint64_t i = 0; i < count; i++) {
+            const std::string name = "texture_" + std::to_string(i);
+            const std::filesystem::path path = DECODE_BENCHMARK_DIR / (name + ".png");
+            sources.push_back(system::TextureSource { name, path.string() });
+
+            if (std::filesystem::exists(path)) {
+                continue;
+            }
+
+            const int size = i % 8 == 7 ? DECODE_BENCHMARK_TEXTURE_SIZE * 2 : DECODE_BENCHMARK_TEXTURE_SIZE;
+            std::vector<unsigned char> pixels(static_cast<size_t>(size) * size * 4);
+            std::ranges::generate(pixels, [&random] { return static_cast<unsigned char>(random.next() & 0x3f); });
+
+            if (!stbi_write_png(path.string().c_str(), size, size, STBI_rgb_alpha, pixels.data(), size * 4)) {
+                std::cerr << "Failed to write " << path << std::endl;
+                return false;
+            }
+        }
+
+        system::AtlasManager atlas;
+        const auto start = std::chrono::steady_clock::now();
+
+        if (!atlas.loadTextures(sources) || !atlas.pack()) {
+            return false;
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const system::AtlasStats stats = atlas.getStats();
+
+        std::cout << "Decoded " << count << " PNGs in " << stats.decodeMilliseconds << "ms ("
+                  << static_cast<double>(count) / std::max(stats.decodeMilliseconds, 1e-6) << "k per second) on "
+                  << system::WorkerPool::get().getThreadCount() << " thread(s)" << std::endl;
+        std::cout << "Packed them into " << stats.width << "x" << stats.height << " in " << stats.packMilliseconds << "ms, "
+                  << stats.occupancy * 100.0f << "% occupied, " << seconds * 1e3 << "ms from load to mip chain" << std::endl;
+
+        return true;
+    }
+
+    bool runCompressionBenchmark(const std::filesystem::path& directory) {
+        std::vector<system::TextureSource> sources{};
+        std::error_code error;
+
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".png") {
+                sources.push_back(system::TextureSource { entry.path().string(), std::filesystem::absolute(entry.path()).string() });
+            }
+        }
+
+        if (sources.empty()) {
+            std::cerr << "No PNGs found in " << directory << std::endl;
+            return false;
+        }
+
+        uint64_t pixelCount = 0;
+        double encodeSeconds = 0.0;
+        double decodeSeconds = 0.0;
+        float worstPSNR = std::numeric_limits<float>::infinity();
+        std::string worstTexture{};
+
+        for (const auto& [name, path] : sources) {
+            int width, height, channels;
+            unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+
+            if (!pixels) {
+                std::cerr << "Failed to load " << path << std::endl;
+                continue;
+            }
+
+            // Edge blocks of sizes that aren't a multiple of four clamp to the image
+            const std::vector<unsigned char> source(pixels, pixels + static_cast<size_t>(width) * height * 4);
+            stbi_image_free(pixels);
+
+            std::vector<unsigned char> blocks(system::getBC7Size(width, height));
+            std::vector<unsigned char> decoded(source.size());
+
+            const auto encodeStart = std::chrono::steady_clock::now();
+            system::compressBC7(source.data(), width, height, blocks.data());
+            const auto decodeStart = std::chrono::steady_clock::now();
+            system::decompressBC7(blocks.data(), width, height, decoded.data());
+            const auto decodeEnd = std::chrono::steady_clock::now();
+
+            encodeSeconds += std::chrono::duration<double>(decodeStart - encodeStart).count();
+            decodeSeconds += std::chrono::duration<double>(decodeEnd - decodeStart).count();
+            pixelCount += static_cast<uint64_t>(width) * height;
+
+            if (const float psnr = system::getPSNR(source.data(), decoded.data(), source.size()); psnr < worstPSNR) {
+                worstPSNR = psnr;
+                worstTexture = name;
+            }
+        }
+
+        const double megapixels = static_cast<double>(pixelCount) / 1e6;
+
+        std::cout << "BC7 encoded " << sources.size() << " textures (" << megapixels << "MP) in " << encodeSeconds * 1e3 << "ms ("
+                  << megapixels / std::max(encodeSeconds, 1e-9) << "MP/s), decoded in " << decodeSeconds * 1e3
+                  << "ms, worst PSNR " << worstPSNR << "dB in " << worstTexture << std::endl;
+
+        // The atlas path the game takes with ENABLE_ATLAS_COMPRESSION, mips and padding included
+        system::AtlasManager atlas(system::ATLAS_PADDING, system::AtlasFormat::BC7);
+        if (!atlas.loadTextures(sources) || !atlas.pack()) {
+            return false;
+        }
+
+        const system::AtlasStats stats = atlas.getStats();
+        std::cout << "Atlas of " << stats.width << "x" << stats.height << " with mips BC7 encoded in " << stats.encodeMilliseconds
+                  << "ms, PSNR " << stats.psnr << "dB" << std::endl;
+
+        return true;
+    }
+}
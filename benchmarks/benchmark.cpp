@@ -0,0 +1,52 @@
+#include "benchmark.hpp"
+
+#include <cmath>
+
+namespace minecraft::benchmark {
+    BenchmarkWorld::BenchmarkWorld(const int radius)
+        : m_world(radius),
+        m_random(1) {
+
+        m_world.generate();
+    }
+
+    world::World& BenchmarkWorld::getWorld() {
+        return m_world;
+    }
+
+    system::Random& BenchmarkWorld::getRandom() {
+        return m_random;
+    }
+
+    float BenchmarkWorld::randomUnit() {
+        return static_cast<float>(m_random.next() >> 40) / static_cast<float>(1u << 24);
+    }
+
+    glm::vec3 BenchmarkWorld::randomPosition() {
+        const glm::vec3 minBlock(m_world.getMinBlock());
+        const glm::vec3 extent = glm::vec3(m_world.getMaxBlock()) - minBlock;
+
+        const float x = randomUnit();
+        const float y = randomUnit();
+        const float z = randomUnit();
+        return minBlock + glm::vec3(x, y, z) * extent;
+    }
+
+    glm::vec3 BenchmarkWorld::randomSurfacePosition(const float height) {
+        const glm::vec3 minBlock(m_world.getMinBlock());
+        const glm::vec3 extent = glm::vec3(m_world.getMaxBlock()) - minBlock;
+
+        const float x = minBlock.x + randomUnit() * extent.x;
+        const float z = minBlock.z + randomUnit() * extent.z;
+        const int ground = world::Chunk::getTerrainHeight(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(z)));
+
+        return glm::vec3(x, static_cast<float>(ground) + height, z);
+    }
+
+    glm::vec3 BenchmarkWorld::randomDirection() {
+        const float x = randomUnit();
+        const float y = randomUnit();
+        const float z = randomUnit();
+        return glm::vec3(x, y, z) * 2.0f - 1.0f;
+    }
+}
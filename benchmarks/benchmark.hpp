@@ -0,0 +1,84 @@
+#pragma once
+
+#include "world.hpp"
+#include "random.hpp"
+#include "atlas_manager.hpp"
+
+#include <glm.hpp>
+#include <cstdint>
+#include <filesystem>
+
+namespace minecraft::benchmark {
+    // Water cells released at once by --dam-break
+    constexpr uint64_t DAM_BREAK_CELLS = 100000;
+    // Mobs walking the terrain under physics in the --entities benchmark, next to the free moving entities
+    constexpr uint64_t ENTITY_BENCHMARK_MOBS = 50000;
+    constexpr uint64_t ENTITY_BENCHMARK_TICKS = 300;
+    constexpr uint64_t ENTITY_BENCHMARK_QUERIES = 500;
+    constexpr float ENTITY_BENCHMARK_QUERY_RADIUS = 4.0f;
+    // The --culling camera walks a circle this far from the origin at head height, looking along the path
+    constexpr float CULLING_BENCHMARK_PATH_RADIUS = 24.0f;
+    // Sides of the random rectangles --pack places, mixed like block, item and GUI textures
+    constexpr int PACK_BENCHMARK_MIN_SIDE = 4;
+    constexpr int PACK_BENCHMARK_MAX_SIDE = 64;
+    // Written once by --decode and reused by later runs, every eighth texture is twice the size of the rest
+    const std::filesystem::path DECODE_BENCHMARK_DIR = system::CACHE_DIR / "benchmark_textures";
+    constexpr int DECODE_BENCHMARK_TEXTURE_SIZE = 16;
+    // Well past DEFAULT_REACH, so --raycast measures long walks over the grid and not just picking
+    constexpr float RAYCAST_BENCHMARK_DISTANCE = 64.0f;
+    // Large enough for a million distinct blocks with a tick pending, delays spread over several level 1 laps
+    constexpr int TICK_BENCHMARK_WORLD_RADIUS = 16;
+    constexpr uint32_t TICK_BENCHMARK_MAX_DELAY = 4096;
+
+    // Generated terrain and a fixed seed, so every world benchmark starts from the same state on every run
+    class BenchmarkWorld {
+    public:
+        explicit BenchmarkWorld(int radius = world::DEFAULT_WORLD_RADIUS);
+
+        BenchmarkWorld(const BenchmarkWorld&) = delete;
+        BenchmarkWorld& operator=(const BenchmarkWorld&) = delete;
+
+        [[nodiscard]]
+        world::World& getWorld();
+        [[nodiscard]]
+        system::Random& getRandom();
+
+        // In [0, 1)
+        float randomUnit();
+        // Anywhere in the world's volume
+        glm::vec3 randomPosition();
+        // Anywhere over the terrain, height above the surface
+        glm::vec3 randomSurfacePosition(float height);
+        // Each component in [-1, 1), not normalised
+        glm::vec3 randomDirection();
+
+    private:
+        world::World m_world;
+        system::Random m_random;
+    };
+
+    // Heap allocations made so far by any thread, counted by the replacement operator new in allocation_counter.cpp
+    uint64_t getHeapAllocationCount();
+
+    // Steps the simulation with scripted input and reports the tick rate
+    bool runSimulationBenchmark(uint64_t ticks);
+    // Releases DAM_BREAK_CELLS of water over the terrain and reports fluid cells stepped per second
+    bool runDamBreakBenchmark(uint64_t ticks);
+    // Moves count free entities, then ticks ENTITY_BENCHMARK_MOBS mobs with physics and neighbour queries
+    bool runEntityBenchmark(uint64_t count);
+    // Schedules count block ticks at random positions and delays, then advances until all have come due
+    bool runBlockTickBenchmark(uint64_t count);
+    // Culls the generated terrain from a camera walking over it with the CPU frustum and occlusion cullers and the
+    // visibility graph
+    bool runCullingBenchmark(uint64_t frames);
+    // Refaces and remeshes every chunk passes times, reporting the heap allocations each chunk costs
+    bool runMeshBenchmark(uint64_t passes);
+    // Casts count random rays over the terrain one at a time and through raycastBatch, reporting Mrays/s
+    bool runRaycastBenchmark(uint64_t count);
+    // Packs count random rectangles into the smallest atlas RectPacker fits them in and reports time and occupancy
+    bool runPackBenchmark(uint64_t count);
+    // Decodes count synthetic PNGs and packs them into an atlas without a GL context, reporting AtlasManager's stats
+    bool runDecodeBenchmark(uint64_t count);
+    // BC7 encodes every PNG in directory on its own and then as one atlas, reporting encode speed and PSNR
+    bool runCompressionBenchmark(const std::filesystem::path& directory);
+}
@@ -0,0 +1,91 @@
+#include "benchmark.hpp"
+#include "chunk_culler.hpp"
+#include "occlusion_culler.hpp"
+#include "player_camera.hpp"
+#include "visibility_graph.hpp"
+#include "physics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace minecraft::benchmark {
+    bool runCullingBenchmark(const uint64_t frames) {
+        BenchmarkWorld fixture;
+        world::World& world = fixture.getWorld();
+        world.remeshDirtySections();
+
+        // The same records the GPU would get, nothing is uploaded
+        const std::vector<primitive::ChunkDrawRecord>& records = world.getDrawRecords();
+
+        system::ChunkCuller chunkCuller;
+        world::VisibilityGraph visibilityGraph;
+        system::OcclusionCuller occlusionCuller;
+        occlusionCuller.setScene(world.getOccluders(), world.getOccludees());
+
+        system::PlayerCamera camera(glm::vec3(0.0f), 16.0f / 9.0f);
+        std::vector<primitive::DrawElementsIndirectCommand> commands{};
+
+        uint64_t frustumVisible = 0;
+        uint64_t occluded = 0;
+        uint64_t visitedSections = 0;
+        uint64_t graphVisible = 0;
+        double graphMicroseconds = 0.0;
+        double frustumSeconds = 0.0;
+        double occlusionMicroseconds = 0.0;
+        double coverage = 0.0;
+
+        for (uint64_t frame = 0; frame < frames; frame++) {
+            const float angle = static_cast<float>(frame) / static_cast<float>(frames) * 360.0f;
+            const glm::vec2 offset = glm::vec2(std::cos(glm::radians(angle)), std::sin(glm::radians(angle))) * CULLING_BENCHMARK_PATH_RADIUS;
+            const int ground = world::Chunk::getTerrainHeight(static_cast<int>(offset.x), static_cast<int>(offset.y));
+
+            camera.Position = glm::vec3(offset.x, static_cast<float>(ground) + world::PLAYER_EYE_HEIGHT, offset.y);
+            camera.setOrientation(angle + 90.0f, 0.0f);
+            const glm::mat4 viewProj = camera.getProjectionMatrix() * camera.getViewMatrix();
+
+            const auto frustumStart = std::chrono::steady_clock::now();
+            frustumVisible += chunkCuller.cull(records, viewProj, nullptr, commands);
+            frustumSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - frustumStart).count();
+
+            const world::VisibilityStats graphStats = visibilityGraph.traverse(world, camera.Position, system::Frustum::fromMatrix(viewProj));
+            visitedSections += graphStats.visitedSections;
+            graphMicroseconds += graphStats.microseconds;
+
+            for (const auto& command : commands) {
+                graphVisible += visibilityGraph.isChunkVisible(command.baseInstance) ? 1 : 0;
+            }
+
+            // Waited on every frame, so each result belongs to this camera rather than the one before
+            occlusionCuller.submit(viewProj);
+            occlusionCuller.finish();
+            occlusionMicroseconds += occlusionCuller.getStats().microseconds;
+
+            for (const auto& command : commands) {
+                occluded += occlusionCuller.isOccluded(command.baseInstance) ? 1 : 0;
+            }
+
+            const std::vector<float>& depth = occlusionCuller.getDepth();
+            coverage += static_cast<double>(std::ranges::count_if(depth, [](const float value) { return value < 1.0f; }))
+                / static_cast<double>(depth.size());
+        }
+
+        const double frameCount = static_cast<double>(std::max<uint64_t>(frames, 1));
+
+        std::cout << "Culled " << records.size() << " chunks over " << frames << " frames: "
+                  << static_cast<double>(frustumVisible) / frameCount << " in the frustum per frame ("
+                  << frustumSeconds * 1e6 / frameCount << "us)" << std::endl;
+        std::cout << static_cast<double>(occluded) / frameCount << " of them occluded per frame ("
+                  << static_cast<double>(occluded) / static_cast<double>(std::max<uint64_t>(frustumVisible, 1)) * 100.0
+                  << "%), occlusion pass " << occlusionMicroseconds / frameCount << "us, "
+                  << coverage / frameCount * 100.0 << "% of the depth buffer covered" << std::endl;
+        std::cout << "Visibility graph visited " << static_cast<double>(visitedSections) / frameCount << " of "
+                  << records.size() * world::CHUNK_SECTION_COUNT << " sections per frame ("
+                  << graphMicroseconds / frameCount << "us), leaving " << static_cast<double>(graphVisible) / frameCount
+                  << " chunks in the frustum" << std::endl;
+
+        return true;
+    }
+}
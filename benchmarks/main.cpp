@@ -0,0 +1,78 @@
+#include "benchmark.hpp"
+
+#include <charconv>
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+namespace {
+    struct CountBenchmark {
+        std::string_view flag;
+        std::string_view countName;
+        bool (*run)(uint64_t count);
+    };
+
+    constexpr CountBenchmark COUNT_BENCHMARKS[] = {
+        { "--simulate", "ticks", minecraft::benchmark::runSimulationBenchmark },
+        { "--dam-break", "ticks", minecraft::benchmark::runDamBreakBenchmark },
+        { "--entities", "count", minecraft::benchmark::runEntityBenchmark },
+        { "--ticks", "count", minecraft::benchmark::runBlockTickBenchmark },
+        { "--culling", "frames", minecraft::benchmark::runCullingBenchmark },
+        { "--mesh", "passes", minecraft::benchmark::runMeshBenchmark },
+        { "--raycast", "rays", minecraft::benchmark::runRaycastBenchmark },
+        { "--pack", "rects", minecraft::benchmark::runPackBenchmark },
+        { "--decode", "textures", minecraft::benchmark::runDecodeBenchmark },
+    };
+
+    void printUsage() {
+        std::cerr << "Usage: minecraft_benchmark [";
+        for (const auto& [flag, countName, run] : COUNT_BENCHMARKS) {
+            std::cerr << flag << " <" << countName << "> | ";
+        }
+        std::cerr << "--bc7 <directory>]" << std::endl;
+    }
+
+    // Whole positive decimals only, a run of zero or a typo would otherwise report nothing
+    std::optional<uint64_t> parseCount(const std::string_view text) {
+        uint64_t count = 0;
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), count);
+
+        if (error != std::errc() || end != text.data() + text.size() || count == 0) {
+            return std::nullopt;
+        }
+
+        return count;
+    }
+}
+
+int main(const int argc, char** argv) {
+    if (argc != 3) {
+        printUsage();
+        return 1;
+    }
+
+    const std::string_view flag = argv[1];
+    const std::string_view value = argv[2];
+
+    if (flag == "--bc7") {
+        return minecraft::benchmark::runCompressionBenchmark(value) ? 0 : 1;
+    }
+
+    for (const auto& [benchmarkFlag, countName, run] : COUNT_BENCHMARKS) {
+        if (flag != benchmarkFlag) {
+            continue;
+        }
+
+        const auto count = parseCount(value);
+        if (!count) {
+            std::cerr << flag << " takes a positive number of " << countName << ", not '" << value << "'" << std::endl;
+            return 1;
+        }
+
+        return run(*count) ? 0 : 1;
+    }
+
+    std::cerr << "Unknown benchmark: " << flag << std::endl;
+    printUsage();
+    return 1;
+}
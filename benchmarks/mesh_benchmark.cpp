@@ -0,0 +1,48 @@
+#include "benchmark.hpp"
+#include "linear_arena.hpp"
+
+#include <chrono>
+#include <iostream>
+
+namespace minecraft::benchmark {
+    bool runMeshBenchmark(const uint64_t passes) {
+        BenchmarkWorld fixture;
+        world::World& world = fixture.getWorld();
+
+        system::LinearArena& arena = world::Chunk::getMeshArena();
+        const auto chunkCount = static_cast<double>(world.getChunkCount());
+
+        // The first pass builds every face list and sizes the arena, later ones remesh the same terrain in place
+        for (uint64_t pass = 0; pass < passes; pass++) {
+            const uint64_t faceAllocations = getHeapAllocationCount();
+            const auto faceStart = std::chrono::steady_clock::now();
+
+            world.invalidateFaces();
+            world.remeshDirtySections();
+
+            const double faceSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - faceStart).count();
+            const uint64_t vertexAllocations = getHeapAllocationCount();
+            const auto vertexStart = std::chrono::steady_clock::now();
+            uint64_t vertexCount = 0;
+
+            // buildMesh without the upload, which needs a GL context
+            for (unsigned int index = 0; index < world.getChunkCount(); index++) {
+                vertexCount += world.getChunk(index).buildVertices(arena).size();
+                arena.reset();
+            }
+
+            const double vertexSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - vertexStart).count();
+            const uint64_t endAllocations = getHeapAllocationCount();
+
+            std::cout << "Pass " << pass + 1 << ": faced " << world.getChunkCount() << " chunks in " << faceSeconds * 1e3
+                      << "ms, " << static_cast<double>(vertexAllocations - faceAllocations) / chunkCount
+                      << " heap allocations per chunk" << std::endl;
+            std::cout << "Pass " << pass + 1 << ": meshed " << vertexCount / primitive::QUAD_VERTEX_COUNT << " quads in "
+                      << vertexSeconds * 1e3 << "ms, " << static_cast<double>(endAllocations - vertexAllocations) / chunkCount
+                      << " heap allocations per mesh, arena " << arena.getCapacity() / 1024 << "KiB from "
+                      << arena.getBlockAllocations() << " block(s)" << std::endl;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,69 @@
+#include "benchmark.hpp"
+#include "raycast.hpp"
+#include "physics.hpp"
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+namespace minecraft::benchmark {
+    bool runRaycastBenchmark(const uint64_t count) {
+        BenchmarkWorld fixture;
+        world::World& world = fixture.getWorld();
+
+        // From head height anywhere on the terrain, in any direction, so rays hit ground, walls and open sky
+        std::vector<world::Ray> rays(count);
+        for (auto& ray : rays) {
+            ray.origin = fixture.randomSurfacePosition(world::PLAYER_EYE_HEIGHT);
+            ray.direction = fixture.randomDirection();
+            ray.maxDistance = RAYCAST_BENCHMARK_DISTANCE;
+        }
+
+        std::vector<std::optional<world::RaycastHit>> serialHits(count);
+        const auto serialStart = std::chrono::steady_clock::now();
+
+        for (uint64_t i = 0; i < count; i++) {
+            serialHits[i] = world::raycast(world, rays[i]);
+        }
+
+        const double serialSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - serialStart).count();
+
+        std::vector<std::optional<world::RaycastHit>> hits(count);
+        const auto batchStart = std::chrono::steady_clock::now();
+        world::raycastBatch(world, rays, hits);
+        const double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - batchStart).count();
+
+        uint64_t hitCount = 0;
+        double hitDistance = 0.0;
+
+        for (uint64_t i = 0; i < count; i++) {
+            const bool same = hits[i].has_value() == serialHits[i].has_value()
+                && (!hits[i] || (hits[i]->block == serialHits[i]->block && hits[i]->face == serialHits[i]->face));
+
+            if (!same) {
+                std::cerr << "raycastBatch disagrees with raycast on ray " << i << std::endl;
+                return false;
+            }
+
+            if (hits[i]) {
+                hitCount++;
+                hitDistance += hits[i]->distance;
+            }
+        }
+
+        const double megaRays = static_cast<double>(count) / 1e6;
+
+        std::cout << "Cast " << count << " rays of up to " << RAYCAST_BENCHMARK_DISTANCE << " blocks: "
+                  << megaRays / std::max(serialSeconds, 1e-9) << " Mrays/s on one thread, "
+                  << megaRays / std::max(batchSeconds, 1e-9) << " Mrays/s batched on "
+                  << system::WorkerPool::get().getThreadCount() << " thread(s)" << std::endl;
+        std::cout << static_cast<double>(hitCount) / static_cast<double>(std::max<uint64_t>(count, 1)) * 100.0
+                  << "% hit a block, " << hitDistance / static_cast<double>(std::max<uint64_t>(hitCount, 1))
+                  << " blocks away on average" << std::endl;
+
+        return true;
+    }
+}
@@ -0,0 +1,246 @@
+#include "benchmark.hpp"
+#include "simulation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace minecraft::benchmark {
+    bool runSimulationBenchmark(const uint64_t ticks) {
+        BenchmarkWorld fixture;
+        world::World& world = fixture.getWorld();
+
+        world::Simulation simulation(world);
+        simulation.setPlayerPosition(glm::vec3(0.5f, world::CHUNK_HEIGHT, 0.5f));
+
+        const auto start = std::chrono::steady_clock::now();
+
+        // Circles the origin, jumping every second, so the run covers walking, landing and walls
+        for (uint64_t tick = 0; tick < ticks; tick++) {
+            const float time = static_cast<float>(tick) * world::SIMULATION_TIMESTEP;
+            simulation.tick(world::SimulationInput {
+                glm::vec3(0.0f, tick % static_cast<uint64_t>(world::SIMULATION_TICK_RATE) == 0 ? 1.0f : 0.0f, 1.0f),
+                time * 20.0f,
+            });
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const glm::vec3 position = simulation.getPlayer().Position;
+
+        std::cout << "Simulated " << ticks << " ticks in " << seconds * 1e3 << "ms ("
+                  << seconds * 1e6 / static_cast<double>(std::max<uint64_t>(ticks, 1)) << "us per tick), player at "
+                  << position.x << " " << position.y << " " << position.z << std::endl;
+
+        return true;
+    }
+
+    bool runDamBreakBenchmark(const uint64_t ticks) {
+        BenchmarkWorld fixture;
+        world::World& world = fixture.getWorld();
+
+        world::Simulation simulation(world);
+        simulation.setPlayerPosition(glm::vec3(0.5f, world::CHUNK_HEIGHT, 0.5f));
+
+        // Fills the air over the terrain column by column from the low x edge, then lets it all go at once
+        const glm::ivec3 minBlock = world.getMinBlock();
+        const glm::ivec3 maxBlock = world.getMaxBlock();
+        uint64_t placed = 0;
+
+        for (int x = minBlock.x; x < maxBlock.x && placed < DAM_BREAK_CELLS; x++) {
+            for (int z = minBlock.z; z < maxBlock.z && placed < DAM_BREAK_CELLS; z++) {
+                for (int y = world::Chunk::getTerrainHeight(x, z); y < maxBlock.y && placed < DAM_BREAK_CELLS; y++) {
+                    placed += simulation.getFluids().addFluid(glm::ivec3(x, y, z), world::BlockType::WATER) ? 1 : 0;
+                }
+            }
+        }
+
+        world.remeshDirtySections();
+
+        world.discardPendingUpload();
+
+        double slowestTick = 0.0;
+        uint64_t remeshedChunks = 0;
+        uint64_t uploadedBytes = 0;
+        uint64_t fullUploads = 0;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint64_t tick = 0; tick < ticks; tick++) {
+            const auto tickStart = std::chrono::steady_clock::now();
+
+            simulation.tick(world::SimulationInput { glm::vec3(0.0f), 0.0f });
+            remeshedChunks += world.remeshDirtySections();
+
+            slowestTick = std::max(slowestTick, std::chrono::duration<double>(std::chrono::steady_clock::now() - tickStart).count());
+
+            // There's no GL context to time the upload with, so what updateFaces would send is counted instead
+            const world::FaceUpload upload = world.getPendingUpload();
+            uploadedBytes += upload.bytes;
+            fullUploads += upload.full ? 1 : 0;
+            world.discardPendingUpload();
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const uint64_t cellsUpdated = simulation.getFluids().getCellsUpdated();
+
+        std::cout << "Dam break of " << placed << " water cells, " << ticks << " ticks in " << seconds * 1e3 << "ms ("
+                  << seconds * 1e6 / static_cast<double>(std::max<uint64_t>(ticks, 1)) << "us per tick, slowest "
+                  << slowestTick * 1e3 << "ms)" << std::endl;
+        std::cout << cellsUpdated << " cell updates, " << static_cast<double>(cellsUpdated) / std::max(seconds, 1e-9) / 1e6
+                  << "M cells per second, " << simulation.getFluids().getFlowCount() << " flows, "
+                  << remeshedChunks << " chunk remeshes, " << simulation.getBlockTicks().getPendingCount()
+                  << " cells still active" << std::endl;
+        std::cout << "Face uploads would send " << static_cast<double>(uploadedBytes) / 1024.0 / static_cast<double>(std::max<uint64_t>(ticks, 1))
+                  << "KiB per tick, " << fullUploads << " of the " << ticks << " ticks relaid the whole "
+                  << static_cast<double>(world.getFaceBufferSize()) / 1024.0 << "KiB buffer out" << std::endl;
+
+        return placed == DAM_BREAK_CELLS;
+    }
+
+    bool runEntityBenchmark(const uint64_t count) {
+        BenchmarkWorld fixture;
+        world::World& world = fixture.getWorld();
+
+        // Free movers scattered through the world's volume, drifting in random directions
+        world::EntityRegistry movers;
+        for (uint64_t i = 0; i < count; i++) {
+            const world::Entity entity = movers.create(world::COMPONENT_TRANSFORM | world::COMPONENT_VELOCITY);
+            movers.get<world::Transform>(entity)->Position = fixture.randomPosition();
+            movers.get<world::Velocity>(entity)->Linear = fixture.randomDirection();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (uint64_t tick = 0; tick < ENTITY_BENCHMARK_TICKS; tick++) {
+            world::runMovementSystem(movers, world::SIMULATION_TIMESTEP);
+        }
+
+        const double moveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Moved " << count << " entities for " << ENTITY_BENCHMARK_TICKS << " ticks in " << moveSeconds * 1e3 << "ms ("
+                  << moveSeconds * 1e6 / ENTITY_BENCHMARK_TICKS << "us per tick, "
+                  << static_cast<double>(count * ENTITY_BENCHMARK_TICKS) / std::max(moveSeconds, 1e-9) / 1e6
+                  << "M entities per second)" << std::endl;
+
+        // Mobs standing on the terrain and walking off in random directions until something stops them
+        world::Simulation simulation(world);
+        world::EntityRegistry& mobs = simulation.getEntities();
+        std::vector<world::Entity> spawned{};
+
+        for (uint64_t i = 0; i < ENTITY_BENCHMARK_MOBS; i++) {
+            const glm::vec3 position = fixture.randomSurfacePosition(0.0f);
+            const float yaw = fixture.randomUnit() * 360.0f;
+
+            const world::Entity entity = mobs.create(
+                world::COMPONENT_TRANSFORM | world::COMPONENT_VELOCITY | world::COMPONENT_COLLIDER | world::COMPONENT_RENDERABLE
+            );
+
+            *mobs.get<world::Transform>(entity) = world::Transform { position, yaw };
+            mobs.get<world::Velocity>(entity)->Linear = glm::vec3(std::cos(glm::radians(yaw)), 0.0f, std::sin(glm::radians(yaw))) * world::PLAYER_WALK_SPEED;
+            mobs.get<world::Collider>(entity)->HalfExtents = world::PLAYER_HALF_EXTENTS;
+
+            spawned.push_back(entity);
+        }
+
+        std::vector<world::Entity> neighbours{};
+        uint64_t neighbourCount = 0;
+        double slowestTick = 0.0;
+        double querySeconds = 0.0;
+        start = std::chrono::steady_clock::now();
+
+        for (uint64_t tick = 0; tick < ENTITY_BENCHMARK_TICKS; tick++) {
+            const auto tickStart = std::chrono::steady_clock::now();
+            simulation.tick(world::SimulationInput { glm::vec3(0.0f), 0.0f });
+            const auto queryStart = std::chrono::steady_clock::now();
+
+            // A slice of the mobs look for others close by, as avoidance or targeting would
+            for (uint64_t i = 0; i < ENTITY_BENCHMARK_QUERIES; i++) {
+                const world::Entity mob = spawned[(tick * ENTITY_BENCHMARK_QUERIES + i) % spawned.size()];
+
+                neighbours.clear();
+                simulation.getEntityHash().query(mobs.get<world::Transform>(mob)->Position, ENTITY_BENCHMARK_QUERY_RADIUS, neighbours);
+                neighbourCount += neighbours.size();
+            }
+
+            const auto tickEnd = std::chrono::steady_clock::now();
+            slowestTick = std::max(slowestTick, std::chrono::duration<double>(queryStart - tickStart).count());
+            querySeconds += std::chrono::duration<double>(tickEnd - queryStart).count();
+        }
+
+        const double mobSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() - querySeconds;
+
+        std::cout << "Ticked " << ENTITY_BENCHMARK_MOBS << " mobs for " << ENTITY_BENCHMARK_TICKS << " ticks in " << mobSeconds * 1e3 << "ms ("
+                  << mobSeconds * 1e6 / ENTITY_BENCHMARK_TICKS << "us per tick, slowest " << slowestTick * 1e3 << "ms)" << std::endl;
+        std::cout << ENTITY_BENCHMARK_QUERIES << " neighbour queries per tick took " << querySeconds * 1e6 / ENTITY_BENCHMARK_TICKS << "us, "
+                  << static_cast<double>(neighbourCount) / static_cast<double>(ENTITY_BENCHMARK_TICKS * ENTITY_BENCHMARK_QUERIES)
+                  << " neighbours each" << std::endl;
+
+        return true;
+    }
+
+    bool runBlockTickBenchmark(const uint64_t count) {
+        BenchmarkWorld fixture(TICK_BENCHMARK_WORLD_RADIUS);
+        const world::World& world = fixture.getWorld();
+
+        const glm::ivec3 minBlock = world.getMinBlock();
+        const glm::ivec3 extent = world.getMaxBlock() - minBlock;
+        const uint64_t blockCount = static_cast<uint64_t>(world.getChunkCount()) * world::CHUNK_VOLUME;
+
+        // Each block holds one pending tick at most, so a few must stay free for the random picks to land on
+        if (count > blockCount / 2) {
+            std::cerr << "--ticks takes at most " << blockCount / 2 << " ticks" << std::endl;
+            return false;
+        }
+
+        world::BlockTickScheduler scheduler(world);
+        system::Random& random = fixture.getRandom();
+
+        const auto scheduleStart = std::chrono::steady_clock::now();
+        uint64_t scheduled = 0;
+
+        while (scheduled < count) {
+            const glm::ivec3 position = minBlock + glm::ivec3(
+                static_cast<int>(random.nextBelow(static_cast<uint32_t>(extent.x))),
+                static_cast<int>(random.nextBelow(static_cast<uint32_t>(extent.y))),
+                static_cast<int>(random.nextBelow(static_cast<uint32_t>(extent.z)))
+            );
+
+            scheduled += scheduler.schedule(position, 1 + random.nextBelow(TICK_BENCHMARK_MAX_DELAY)) ? 1 : 0;
+        }
+
+        const double scheduleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - scheduleStart).count();
+
+        std::vector<glm::ivec3> due{};
+        uint64_t processed = 0;
+        size_t busiestTick = 0;
+
+        const auto advanceStart = std::chrono::steady_clock::now();
+
+        while (scheduler.getPendingCount() > 0) {
+            due.clear();
+            scheduler.advance(due);
+
+            processed += due.size();
+            busiestTick = std::max(busiestTick, due.size());
+        }
+
+        const double advanceSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - advanceStart).count();
+
+        if (processed != count) {
+            std::cerr << "Scheduled " << count << " ticks but " << processed << " came due" << std::endl;
+            return false;
+        }
+
+        const uint64_t ticks = scheduler.getCurrentTick();
+
+        std::cout << "Scheduled " << count << " block ticks over " << world.getChunkCount() << " chunks in "
+                  << scheduleSeconds * 1e3 << "ms (" << scheduleSeconds * 1e9 / static_cast<double>(count) << "ns each)" << std::endl;
+        std::cout << "Processed them over " << ticks << " ticks in " << advanceSeconds * 1e3 << "ms ("
+                  << advanceSeconds * 1e9 / static_cast<double>(count) << "ns per block tick, "
+                  << advanceSeconds * 1e6 / static_cast<double>(std::max<uint64_t>(ticks, 1)) << "us per game tick, up to "
+                  << busiestTick << " due at once)" << std::endl;
+
+        return true;
+    }
+}
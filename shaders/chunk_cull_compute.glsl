@@ -0,0 +1,117 @@
+#version 460 core
+
+layout (local_size_x = 64) in;
+
+#include "chunk_record.glsl"
+
+struct DrawElementsIndirectCommand {
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+layout (std430, binding = 2) writeonly buffer CommandBuffer {
+    DrawElementsIndirectCommand commands[];
+};
+
+layout (std430, binding = 3) buffer CountBuffer {
+    uint drawCount;
+};
+
+layout (binding = 1) uniform sampler2D hizTexture;
+
+uniform mat4 viewProj;
+uniform vec4 frustumPlanes[6];
+uniform uint recordCount;
+uniform int hizLevels;
+
+// Mirrors system::Frustum::intersects
+bool intersectsFrustum(vec3 aabbMin, vec3 aabbMax) {
+    for (int i = 0; i < 6; i++) {
+        vec4 plane = frustumPlanes[i];
+        vec3 positive = mix(aabbMin, aabbMax, greaterThanEqual(plane.xyz, vec3(0.0)));
+
+        if (dot(plane.xyz, positive) + plane.w < 0.0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+float fetchHiZ(int level, ivec2 texel) {
+    ivec2 size = textureSize(hizTexture, level);
+    return texelFetch(hizTexture, clamp(texel, ivec2(0), size - 1), level).r;
+}
+
+// Mirrors system::ChunkCuller::occluded
+bool occluded(vec3 aabbMin, vec3 aabbMax) {
+    vec2 uvMin = vec2(1.0);
+    vec2 uvMax = vec2(0.0);
+    float nearestDepth = 1.0;
+
+    for (int i = 0; i < 8; i++) {
+        vec3 corner = vec3(
+            (i & 1) != 0 ? aabbMax.x : aabbMin.x,
+            (i & 2) != 0 ? aabbMax.y : aabbMin.y,
+            (i & 4) != 0 ? aabbMax.z : aabbMin.z
+        );
+
+        vec4 clip = viewProj * vec4(corner, 1.0);
+        if (clip.w <= 0.0) {
+            return false;
+        }
+
+        vec3 ndc = clip.xyz / clip.w;
+        vec2 uv = ndc.xy * 0.5 + 0.5;
+
+        uvMin = min(uvMin, uv);
+        uvMax = max(uvMax, uv);
+        nearestDepth = min(nearestDepth, ndc.z * 0.5 + 0.5);
+    }
+
+    uvMin = clamp(uvMin, vec2(0.0), vec2(1.0));
+    uvMax = clamp(uvMax, vec2(0.0), vec2(1.0));
+
+    vec2 baseSize = vec2(textureSize(hizTexture, 0));
+    vec2 extent = (uvMax - uvMin) * baseSize;
+    float footprint = max(max(extent.x, extent.y), 1.0);
+    int level = clamp(int(ceil(log2(footprint))), 0, hizLevels - 1);
+
+    vec2 levelSize = vec2(textureSize(hizTexture, level));
+    ivec2 texelMin = ivec2(uvMin * levelSize);
+    ivec2 texelMax = ivec2(uvMax * levelSize);
+
+    float maxDepth = max(
+        max(fetchHiZ(level, texelMin), fetchHiZ(level, ivec2(texelMax.x, texelMin.y))),
+        max(fetchHiZ(level, ivec2(texelMin.x, texelMax.y)), fetchHiZ(level, texelMax))
+    );
+
+    return nearestDepth > maxDepth;
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= recordCount) {
+        return;
+    }
+
+    ChunkDrawRecord record = records[index];
+    vec3 aabbMin = record.aabbMin.xyz;
+    vec3 aabbMax = record.aabbMax.xyz;
+
+    if (record.faceCount == 0 || !intersectsFrustum(aabbMin, aabbMax)) {
+        return;
+    }
+
+    if (hizLevels > 0 && occluded(aabbMin, aabbMax)) {
+        return;
+    }
+
+    uint slot = atomicAdd(drawCount, 1);
+    commands[slot] = DrawElementsIndirectCommand(
+        record.faceCount * 6u, 1u, 0u, int(record.firstFace * 4u), index
+    );
+}
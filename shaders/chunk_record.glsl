@@ -0,0 +1,15 @@
+#pragma once
+
+// Layout matches primitive::ChunkDrawRecord
+struct ChunkDrawRecord {
+    vec4 origin;
+    vec4 aabbMin;
+    vec4 aabbMax;
+    uint firstFace;
+    uint faceCount;
+    uint padding[2];
+};
+
+layout (std430, binding = 1) readonly buffer RecordBuffer {
+    ChunkDrawRecord records[];
+};
@@ -0,0 +1,56 @@
+#version 460 core
+
+#include "chunk_record.glsl"
+
+layout (std430, binding = 0) readonly buffer FaceBuffer {
+    uint faces[];
+};
+
+out vec2 texCoord;
+out float shading;
+flat out uint layer;
+
+uniform mat4 cameraView;
+uniform mat4 cameraProj;
+
+// up, down, right, left, front, back
+const vec3 faceCorners[24] = vec3[24](
+    vec3(0.0, 0.0, 1.0), vec3(1.0, 0.0, 1.0), vec3(1.0, 0.0, 0.0), vec3(0.0, 0.0, 0.0),
+    vec3(0.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0), vec3(1.0, 0.0, 1.0), vec3(0.0, 0.0, 1.0),
+    vec3(0.0, 1.0, 0.0), vec3(0.0, 1.0, 1.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, 0.0),
+    vec3(0.0, 0.0, 0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 1.0, 1.0), vec3(0.0, 1.0, 0.0),
+    vec3(1.0, 0.0, 0.0), vec3(1.0, 1.0, 0.0), vec3(0.0, 1.0, 0.0), vec3(0.0, 0.0, 0.0),
+    vec3(0.0, 0.0, 0.0), vec3(0.0, 1.0, 0.0), vec3(1.0, 1.0, 0.0), vec3(1.0, 0.0, 0.0)
+);
+
+const vec2 cornerTexCoords[4] = vec2[4](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
+
+const float normalShade[6] = float[6](
+    1.0, 0.4, // up, down
+    0.4, 0.7, // right, left
+    0.4, 0.7 // front, back
+);
+
+void main() {
+    // Drawn with the shared quad index buffer, baseVertex selects the chunk's first face
+    uint face = faces[gl_VertexID >> 2];
+    uint corner = gl_VertexID & 3;
+    vec3 chunkOrigin = records[gl_BaseInstance].origin.xyz;
+
+    vec3 position = vec3(
+        bitfieldExtract(face, 0, 5),
+        bitfieldExtract(face, 5, 8),
+        bitfieldExtract(face, 13, 5)
+    );
+    uint direction = bitfieldExtract(face, 18, 3);
+    uint light = bitfieldExtract(face, 28, 4);
+    layer = bitfieldExtract(face, 21, 7);
+
+    vec3 worldPosition = chunkOrigin + position + faceCorners[direction * 4 + corner];
+
+    gl_Position = cameraProj * cameraView * vec4(worldPosition, 1.0);
+    texCoord = cornerTexCoords[corner];
+    shading = normalShade[direction] * (float(light) / 15.0);
+}
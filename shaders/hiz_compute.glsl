@@ -0,0 +1,41 @@
+#version 460 core
+
+layout (local_size_x = 8, local_size_y = 8) in;
+
+layout (binding = 1) uniform sampler2D sourceDepth;
+layout (r32f, binding = 0) uniform writeonly image2D targetLevel;
+
+uniform int sourceLevel;
+uniform bool reduce;
+
+// Mirrors system::HiZPyramid::build
+void main() {
+    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = imageSize(targetLevel);
+
+    if (texel.x >= size.x || texel.y >= size.y) {
+        return;
+    }
+
+    if (!reduce) {
+        imageStore(targetLevel, texel, vec4(texelFetch(sourceDepth, texel, 0).r));
+        return;
+    }
+
+    // Odd source sizes fold the trailing row/column into the last texel
+    ivec2 sourceSize = textureSize(sourceDepth, sourceLevel);
+    ivec2 start = texel * 2;
+    ivec2 end = ivec2(
+        texel.x == size.x - 1 ? sourceSize.x : start.x + 2,
+        texel.y == size.y - 1 ? sourceSize.y : start.y + 2
+    );
+
+    float maxDepth = 0.0;
+    for (int y = start.y; y < end.y; y++) {
+        for (int x = start.x; x < end.x; x++) {
+            maxDepth = max(maxDepth, texelFetch(sourceDepth, ivec2(x, y), sourceLevel).r);
+        }
+    }
+
+    imageStore(targetLevel, texel, vec4(maxDepth));
+}
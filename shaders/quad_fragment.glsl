@@ -3,12 +3,21 @@
 in vec2 texCoord;
 in float shading;
 
-uniform sampler2D sampledTexture;
+#ifdef TEXTURE_ARRAY
+flat in uint layer;
+
+layout (binding = 0) uniform sampler2DArray sampledTextures;
+#else
+layout (binding = 0) uniform sampler2D sampledTexture;
+#endif
 
 out vec4 fragColor;
 
 void main() {
+#ifdef TEXTURE_ARRAY
+    vec4 texColor = texture(sampledTextures, vec3(texCoord, float(layer)));
+#else
     vec4 texColor = texture(sampledTexture, texCoord);
+#endif
     fragColor = vec4(texColor.rgb * shading, texColor.a);
 }
-
@@ -9,6 +9,7 @@ out float shading;
 
 uniform mat4 cameraView;
 uniform mat4 cameraProj;
+uniform vec3 chunkOrigin;
 
 const float normalShade[6] = float[6](
     1.0, 0.4, // up, down
@@ -17,7 +18,7 @@ const float normalShade[6] = float[6](
 );
 
 void main() {
-    gl_Position = cameraProj * cameraView * mat4(1.0) * vec4(inPosition, 1.0);
+    gl_Position = cameraProj * cameraView * mat4(1.0) * vec4(chunkOrigin + inPosition, 1.0);
     texCoord = inTexCoord;
     shading = normalShade[0];
 }
\ No newline at end of file
@@ -1,53 +1,395 @@
 #include "game.hpp"
+#include "profiler.hpp"
+#include "memory_tracker.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
 namespace minecraft {
-    Game::Game()
-        : m_chunk(glm::ivec2(0)),
-        m_window(opengl::Window("minecraft-opengl", 1280, 720)),
-        m_renderProgram(opengl::ShaderProgram("quad_vertex.glsl", "quad_fragment.glsl")),
-        m_camera(system::PlayerCamera(glm::vec3(0.0f, 0.0f, 3.0f), m_window.getAspectRatio())) {
+    std::optional<GameOptions> parseGameOptions(const int argc, char** argv) {
+        GameOptions options{};
+
+        for (int i = 1; i < argc; i++) {
+            const std::string_view argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (argument == "--record" && hasValue) {
+                options.cameraMode = CameraMode::RECORD;
+                options.cameraPath = argv[++i];
+            } else if (argument == "--replay" && hasValue) {
+                options.cameraMode = CameraMode::REPLAY;
+                options.cameraPath = argv[++i];
+            } else if (argument == "--output" && hasValue) {
+                options.benchmarkOutput = argv[++i];
+            } else if (argument == "--headless") {
+                options.headless = true;
+            } else {
+                std::cerr << "Unknown argument: " << argument << std::endl;
+                std::cerr << "Usage: minecraft_opengl [--record <path> | --replay <path> [--output <path>] [--headless]]" << std::endl;
+                return std::nullopt;
+            }
+        }
+
+        // Nothing would ever close a hidden window outside of a replay
+        if (options.headless && options.cameraMode != CameraMode::REPLAY) {
+            std::cerr << "--headless needs --replay" << std::endl;
+            return std::nullopt;
+        }
+
+        return options;
+    }
+
+    Game::Game(GameOptions options)
+        : m_options(std::move(options)),
+        m_world(world::DEFAULT_WORLD_RADIUS),
+        m_window(opengl::Window("minecraft-opengl", 1280, 720, !m_options.headless)),
+        m_renderPermutations(ENABLE_VERTEX_PULLING ? "face_vertex.glsl" : "quad_vertex.glsl", "quad_fragment.glsl"),
+        m_renderProgram(m_renderPermutations.get(
+            ENABLE_TEXTURE_ARRAY ? system::ShaderDefines { { "TEXTURE_ARRAY", "" } } : system::ShaderDefines{}
+        )),
+        m_camera(system::PlayerCamera(glm::vec3(0.0f, world::CHUNK_HEIGHT + 4.0f, 3.0f), m_window.getAspectRatio())),
+        m_simulation(m_world) {
 
         m_window.setCameraRefs(m_camera, m_renderProgram);
+        m_window.setGpuTimer(m_gpuTimer);
+        m_window.setFrameStats(m_frameStats);
+        m_window.setFreeMovement(!ENABLE_PLAYER_PHYSICS);
 
-        m_atlasManager = system::AtlasManager();
-        m_atlasManager.loadTexture("test", "test.png");
+        m_simulation.setPlayerPosition(m_camera.Position - glm::vec3(0.0f, world::PLAYER_EYE_HEIGHT, 0.0f));
 
-        if (!m_atlasManager.build()) {
-            std::cout << "Failed to build texture atlas!" << std::endl;
-            return;
+        if (m_options.cameraMode == CameraMode::REPLAY) {
+            if (!m_cameraPath.load(m_options.cameraPath)) {
+                glfwSetWindowShouldClose(m_window.getWindow(), true);
+            }
+
+            // Frame times are the measurement, so they mustn't be capped by the display
+            m_window.setInputEnabled(false);
+            glfwSwapInterval(0);
         }
 
-        if (!m_atlasManager.save("atlas.png")) {
-            std::cout << "Failed to save texture atlas!" << std::endl;
+        if (ENABLE_TEXTURE_ARRAY) {
+            m_textureArrayManager.loadTexture("test", "test.png");
+
+            if (!m_textureArrayManager.build()) {
+                std::cout << "Failed to build texture array!" << std::endl;
+                return;
+            }
+        } else {
+            m_atlasManager = system::AtlasManager(
+                system::ATLAS_PADDING,
+                ENABLE_ATLAS_COMPRESSION ? system::AtlasFormat::BC7 : system::AtlasFormat::RGBA8
+            );
+            m_atlasManager.loadTexture("test", "test.png");
+
+            if (!m_atlasManager.build()) {
+                std::cout << "Failed to build texture atlas!" << std::endl;
+                return;
+            }
         }
 
-        m_chunk.buildData();
-        m_chunk.buildMesh();
+        m_world.generate();
 
-        m_renderProgram.use();
+        if (ENABLE_VERTEX_PULLING) {
+            m_world.buildFaces();
+            m_gpuCuller.setRecords(m_world.getRecordBuffer(), static_cast<unsigned int>(m_world.getDrawRecords().size()));
+
+            // Only the CPU culling path reads it, and the scene is what starts its worker thread
+            if (!ENABLE_GPU_CULLING && ENABLE_OCCLUSION_CULLING) {
+                m_occlusionCuller.setScene(m_world.getOccluders(), m_world.getOccludees());
+            }
+        } else {
+            m_world.buildMeshes();
+        }
+
+        // Samplers are bound to unit 0 in the shaders, so nothing here waits on the program link
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_atlasManager.getID());
-        glUniform1i(glGetUniformLocation(m_renderProgram.Program, "sampledTexture"), 0);
+
+        if (ENABLE_TEXTURE_ARRAY) {
+            glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureArrayManager.getID());
+        } else {
+            glBindTexture(GL_TEXTURE_2D, m_atlasManager.getID());
+        }
+
+        if (ENABLE_HOT_RELOAD) {
+            m_fileWatcher.watch(opengl::SHADERS_DIR);
+            m_fileWatcher.watch(system::ASSETS_DIR);
+        }
     }
 
     Game::~Game() {
         m_atlasManager.unloadAll();
+        m_textureArrayManager.unloadAll();
         glfwTerminate();
     }
 
     void Game::run() {
+        auto lastFrame = std::chrono::steady_clock::now();
+
         while (!glfwWindowShouldClose(m_window.getWindow())) {
             update();
+
+            const auto now = std::chrono::steady_clock::now();
+            if (m_replayedTick) {
+                m_frameTimes.addFrame(std::chrono::duration<double, std::milli>(now - lastFrame).count());
+            }
+
+            lastFrame = now;
         }
+
+        finishCameraPath();
     }
 
     void Game::update() {
+        // Previous frame's zones, including the outer update zone, which has closed by now
+        system::Profiler::get().collect();
+        system::ProfileZone zone("Game::update");
+
+        m_frameStats.beginFrame();
+
+        m_frameStats.beginPhase(system::FramePhase::INPUT);
+        m_window.pollEvents();
+
+        if (ENABLE_HOT_RELOAD) {
+            m_frameStats.beginPhase(system::FramePhase::UPLOAD);
+            reloadChangedFiles();
+        }
+
+        // Programs that missed the cache are still compiling, keep presenting frames until they land
+        m_frameStats.beginPhase(system::FramePhase::UPDATE);
+        const bool ready = m_renderProgram.isReady() && (!ENABLE_GPU_CULLING || m_gpuCuller.isReady());
+        updateCameraPath(ready);
+
+        if (ENABLE_PLAYER_PHYSICS) {
+            updatePlayer();
+        }
+
+        editTargetBlock();
+
+        // Ticks that moved fluid and edited blocks leave dirty sections, only those are refaced and uploaded
+        m_frameStats.beginPhase(system::FramePhase::UPLOAD);
+
+        if (ENABLE_VERTEX_PULLING) {
+            // The occlusion scene holds copies of the bounds, so it's rebuilt whenever they move
+            if (m_world.updateFaces() && !ENABLE_GPU_CULLING && ENABLE_OCCLUSION_CULLING) {
+                m_occlusionCuller.setScene(m_world.getOccluders(), m_world.getOccludees());
+            }
+        } else {
+            m_world.updateMeshes();
+        }
+
+        m_frameStats.beginPhase(system::FramePhase::DRAW);
+        m_gpuTimer.beginFrame();
+
+        m_gpuTimer.beginPass("clear");
         glClearColor(0.2f, 0.227f, 0.251f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        m_gpuTimer.endPass();
+
+        if (ready && ENABLE_VERTEX_PULLING) {
+            drawWorld();
+        } else if (ready) {
+            m_gpuTimer.beginPass("terrain");
+            for (unsigned int index = 0; index < m_world.getChunkCount(); index++) {
+                const world::Chunk& chunk = m_world.getChunk(index);
+                m_renderProgram.setUniformVec3("chunkOrigin", chunk.getOrigin());
+                chunk.draw();
+            }
+            m_gpuTimer.endPass();
+        }
+
+        m_frameStats.beginPhase(system::FramePhase::SWAP);
+        m_window.swapBuffers();
+
+        m_frameStats.endFrame();
+    }
+
+    void Game::updateCameraPath(const bool ready) {
+        if (m_options.cameraMode == CameraMode::RECORD) {
+            // Sampled at the path's tick rate whatever the frame rate, so a replay steps at a fixed timestep
+            const float tickLength = 1.0f / m_cameraPath.getTickRate();
+            m_recordAccumulator += m_window.getDeltaTime();
+
+            while (m_recordAccumulator >= tickLength) {
+                m_cameraPath.append(system::CameraPose { m_camera.Position, m_camera.getYaw(), m_camera.getPitch() });
+                m_recordAccumulator -= tickLength;
+            }
+
+            return;
+        }
+
+        m_replayedTick = false;
+
+        // Ticks only advance once everything draws, so shader compilation stays out of the numbers
+        if (m_options.cameraMode != CameraMode::REPLAY || !ready) {
+            return;
+        }
+
+        if (m_replayTick >= m_cameraPath.getTickCount()) {
+            glfwSetWindowShouldClose(m_window.getWindow(), true);
+            return;
+        }
+
+        const auto& [position, yaw, pitch] = m_cameraPath.getPose(m_replayTick++);
+        m_camera.Position = position;
+        m_camera.setOrientation(yaw, pitch);
+        m_camera.updateUniforms(m_renderProgram);
+
+        m_replayedTick = true;
+    }
 
-        m_chunk.draw();
-        m_window.update();
+    void Game::updatePlayer() {
+        // Replays own the camera
+        if (m_options.cameraMode == CameraMode::REPLAY) {
+            return;
+        }
+
+        m_simulation.advance(m_window.getDeltaTime(), world::SimulationInput { m_window.getMovementInput(), m_camera.getYaw() });
+
+        m_camera.Position = m_simulation.getInterpolatedEyePosition();
+        m_camera.updateUniforms(m_renderProgram);
+    }
+
+    void Game::editTargetBlock() {
+        const world::Ray ray { m_camera.Position, m_camera.getFront(), world::DEFAULT_REACH };
+        m_targetBlock = world::raycast(m_world, ray);
+
+        // Taken either way, so a click with nothing in reach isn't applied once something is
+        const bool breakClicked = m_window.takeBreakClick();
+        const bool placeClicked = m_window.takePlaceClick();
+
+        if (!m_targetBlock) {
+            return;
+        }
+
+        glm::ivec3 changed = m_targetBlock->block;
+
+        if (breakClicked) {
+            m_world.setBlock(changed, world::Block());
+        } else if (placeClicked) {
+            changed += primitive::getDirectionOffset(m_targetBlock->face);
+
+            const world::Block* current = m_world.getBlock(changed);
+            if (!current || current->solid()) {
+                return;
+            }
+
+            // The player mustn't end up inside what they placed
+            if (ENABLE_PLAYER_PHYSICS) {
+                const primitive::BoundingBox body = world::getBodyBounds(m_simulation.getPlayer());
+                const glm::vec3 cell(changed);
+
+                if (glm::all(glm::lessThan(body.min, cell + 1.0f)) && glm::all(glm::greaterThan(body.max, cell))) {
+                    return;
+                }
+            }
+
+            m_world.setBlock(changed, world::Block(world::BlockType::TEST));
+        } else {
+            return;
+        }
+
+        // Fluid next to the change may have somewhere new to flow, or have lost it
+        m_simulation.getFluids().scheduleAround(changed);
+        m_targetBlock = world::raycast(m_world, ray);
+    }
+
+    void Game::finishCameraPath() {
+        if (m_options.cameraMode == CameraMode::RECORD && m_cameraPath.save(m_options.cameraPath)) {
+            std::cout << "Recorded " << m_cameraPath.getTickCount() << " camera ticks to " << m_options.cameraPath << std::endl;
+        }
+
+        if (m_options.cameraMode != CameraMode::REPLAY || m_replayTick == 0) {
+            return;
+        }
+
+        const auto [frames, mean, p50, p95, p99, max] = m_frameTimes.getSummary();
+        std::cout << "Replayed " << frames << " frames: mean " << mean << "ms, p50 " << p50 << "ms, p95 " << p95
+                  << "ms, p99 " << p99 << "ms, max " << max << "ms" << std::endl;
+        system::MemoryTracker::printStats();
+
+        if (m_frameTimes.writeJson(m_options.benchmarkOutput)) {
+            std::cout << "Wrote frame time histogram to " << m_options.benchmarkOutput << std::endl;
+        }
+    }
+
+    void Game::reloadChangedFiles() {
+        system::ProfileZone zone("Game::reloadChangedFiles");
+
+        std::vector<std::filesystem::path> shaders;
+
+        for (const auto& path : m_fileWatcher.poll()) {
+            if (path.extension() == ".glsl") {
+                shaders.push_back(path);
+            } else if (path.extension() == ".png" && ENABLE_TEXTURE_ARRAY) {
+                m_textureArrayManager.reloadTexture(path);
+            } else if (path.extension() == ".png" && m_atlasManager.reloadTexture(path)) {
+                // A resized texture reallocates the atlas, so its name changes
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, m_atlasManager.getID());
+            }
+        }
+
+        if (!shaders.empty()) {
+            m_renderPermutations.reload(shaders);
+            m_gpuCuller.reloadShaders(shaders);
+        }
+
+        // Replacements link in the background, the old programs keep drawing until they're swapped in
+        if (m_renderPermutations.update()) {
+            m_camera.updateUniforms(m_renderProgram);
+        }
+
+        m_gpuCuller.updateShaders();
+    }
+
+    void Game::drawWorld() {
+        system::ProfileZone zone("Game::drawWorld");
+
+        const glm::mat4 viewProj = m_camera.getProjectionMatrix() * m_camera.getViewMatrix();
+
+        if (!ENABLE_GPU_CULLING) {
+            m_chunkCuller.cull(m_world.getDrawRecords(), viewProj, nullptr, m_drawCommands);
+
+            if (ENABLE_VISIBILITY_GRAPH) {
+                m_visibilityGraph.traverse(m_world, m_camera.Position, system::Frustum::fromMatrix(viewProj));
+
+                std::erase_if(m_drawCommands, [this](const primitive::DrawElementsIndirectCommand& command) {
+                    return !m_visibilityGraph.isChunkVisible(command.baseInstance);
+                });
+            }
+
+            if (ENABLE_OCCLUSION_CULLING) {
+                std::erase_if(m_drawCommands, [this](const primitive::DrawElementsIndirectCommand& command) {
+                    return m_occlusionCuller.isOccluded(command.baseInstance);
+                });
+
+                m_occlusionCuller.submit(viewProj);
+            }
+
+            m_gpuTimer.beginPass("terrain");
+            m_world.draw(m_drawCommands);
+            m_gpuTimer.endPass();
+            return;
+        }
+
+        m_gpuTimer.beginPass("cull");
+        m_gpuCuller.cull(viewProj);
+        m_gpuTimer.endPass();
+
+        m_gpuTimer.beginPass("terrain");
+        m_renderProgram.use();
+        m_world.bind();
+        m_gpuCuller.draw();
+        m_gpuTimer.endPass();
+
+        int width, height;
+        glfwGetFramebufferSize(m_window.getWindow(), &width, &height);
+
+        m_gpuTimer.beginPass("hiz");
+        m_gpuCuller.updateHiZ(width, height);
+        m_gpuTimer.endPass();
+
+        m_renderProgram.use();
     }
 }
@@ -1,25 +1,96 @@
 #pragma once
 
 #include "window.hpp"
+#include "shader_permutations.hpp"
 #include "atlas_manager.hpp"
-#include "chunk.hpp"
+#include "texture_array_manager.hpp"
+#include "world.hpp"
+#include "visibility_graph.hpp"
+#include "raycast.hpp"
+#include "simulation.hpp"
+#include "gpu_culler.hpp"
+#include "chunk_culler.hpp"
+#include "occlusion_culler.hpp"
+#include "file_watcher.hpp"
+#include "camera_path.hpp"
+#include "frame_time_histogram.hpp"
+#include "frame_stats.hpp"
+
+#include <optional>
 
 namespace minecraft {
+    constexpr bool ENABLE_VERTEX_PULLING = true;
+    constexpr bool ENABLE_TEXTURE_ARRAY = ENABLE_VERTEX_PULLING;
+    constexpr bool ENABLE_GPU_CULLING = true;
+    constexpr bool ENABLE_OCCLUSION_CULLING = true;
+    constexpr bool ENABLE_VISIBILITY_GRAPH = true;
+    constexpr bool ENABLE_ATLAS_COMPRESSION = false;
+    constexpr bool ENABLE_HOT_RELOAD = true;
+    constexpr bool ENABLE_PLAYER_PHYSICS = true;
+
+    const std::filesystem::path BENCHMARK_OUTPUT_PATH = std::filesystem::path(PROJECT_SOURCE_DIR) / "cache" / "benchmark.json";
+
+    enum class CameraMode {
+        FREE,
+        RECORD,
+        REPLAY,
+    };
+
+    struct GameOptions {
+        CameraMode cameraMode = CameraMode::FREE;
+        std::filesystem::path cameraPath{};
+        std::filesystem::path benchmarkOutput = BENCHMARK_OUTPUT_PATH;
+        bool headless = false;
+    };
+
+    // --record <path>, --replay <path> [--output <path>] [--headless]. Headless benchmarks live in minecraft_benchmark
+    std::optional<GameOptions> parseGameOptions(int argc, char** argv);
+
     class Game {
     public:
-        Game();
+        explicit Game(GameOptions options = {});
         ~Game();
 
         void run();
 
     private:
         void update();
+        void drawWorld();
+        void reloadChangedFiles();
+        void updateCameraPath(bool ready);
+        void updatePlayer();
+        // Left click breaks the target block, right click places one against the face it's aimed at
+        void editTargetBlock();
+        void finishCameraPath();
 
-        world::Chunk m_chunk;
+        GameOptions m_options;
+        world::World m_world;
 
         opengl::Window m_window;
-        opengl::ShaderProgram m_renderProgram;
+        opengl::ShaderPermutations m_renderPermutations;
+        opengl::ShaderProgram& m_renderProgram;
+        opengl::GpuCuller m_gpuCuller;
+        opengl::GpuTimer m_gpuTimer;
         system::PlayerCamera m_camera;
         system::AtlasManager m_atlasManager;
+        system::TextureArrayManager m_textureArrayManager;
+        system::ChunkCuller m_chunkCuller;
+        system::OcclusionCuller m_occlusionCuller;
+        world::VisibilityGraph m_visibilityGraph;
+        system::FileWatcher m_fileWatcher;
+
+        std::vector<primitive::DrawElementsIndirectCommand> m_drawCommands{};
+
+        system::CameraPath m_cameraPath{};
+        system::FrameTimeHistogram m_frameTimes{};
+        system::FrameStats m_frameStats{};
+        size_t m_replayTick{};
+        bool m_replayedTick{};
+        float m_recordAccumulator{};
+
+        world::Simulation m_simulation;
+
+        // Block under the crosshair, refreshed every frame before the clicks are applied
+        std::optional<world::RaycastHit> m_targetBlock{};
     };
 }
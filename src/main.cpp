@@ -1,7 +1,12 @@
 #include "game.hpp"
 
-int main() {
-    minecraft::Game game{};
+int main(const int argc, char** argv) {
+    const auto options = minecraft::parseGameOptions(argc, argv);
+    if (!options) {
+        return 1;
+    }
+
+    minecraft::Game game(*options);
     game.run();
     return 0;
 }
@@ -0,0 +1,155 @@
+#include "gpu_culler.hpp"
+#include "chunk_culler.hpp"
+#include "draw_command.hpp"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+
+namespace minecraft::opengl {
+
+    GpuCuller::GpuCuller()
+        : m_cullPermutations("chunk_cull_compute.glsl"),
+        m_hizPermutations("hiz_compute.glsl"),
+        m_cullProgram(m_cullPermutations.get({})),
+        m_hizProgram(m_hizPermutations.get({})) {
+
+        glCreateBuffers(1, &m_commandBuffer);
+        glCreateBuffers(1, &m_countBuffer);
+        glNamedBufferStorage(m_countBuffer, sizeof(unsigned int), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    }
+
+    GpuCuller::~GpuCuller() {
+        glDeleteBuffers(1, &m_commandBuffer);
+        glDeleteBuffers(1, &m_countBuffer);
+        glDeleteTextures(1, &m_depthTexture);
+        glDeleteTextures(1, &m_hizTexture);
+    }
+
+    void GpuCuller::setRecords(const unsigned int recordBuffer, const unsigned int recordCount) {
+        m_recordBuffer = recordBuffer;
+        m_recordCount = recordCount;
+
+        glNamedBufferData(
+            m_commandBuffer,
+            recordCount * sizeof(primitive::DrawElementsIndirectCommand), nullptr,
+            GL_DYNAMIC_DRAW
+        );
+        m_bufferMemory.set(sizeof(unsigned int) + recordCount * sizeof(primitive::DrawElementsIndirectCommand));
+    }
+
+    bool GpuCuller::isReady() const {
+        return m_cullProgram.isReady() && m_hizProgram.isReady();
+    }
+
+    void GpuCuller::reloadShaders(const std::vector<std::filesystem::path>& changed) {
+        m_cullPermutations.reload(changed);
+        m_hizPermutations.reload(changed);
+    }
+
+    void GpuCuller::updateShaders() {
+        // Uniforms are set before every dispatch, so nothing needs restoring after a swap
+        m_cullPermutations.update();
+        m_hizPermutations.update();
+    }
+
+    void GpuCuller::cull(const glm::mat4& viewProj) const {
+        if (m_recordCount == 0) {
+            return;
+        }
+
+        constexpr unsigned int zero = 0;
+        glClearNamedBufferData(m_countBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+
+        const auto frustum = system::Frustum::fromMatrix(viewProj);
+
+        m_cullProgram.setUniformMat4("viewProj", viewProj);
+        m_cullProgram.setUniformVec4Array("frustumPlanes", frustum.planes, 6);
+        m_cullProgram.setUniformUInt("recordCount", m_recordCount);
+        m_cullProgram.setUniformInt("hizLevels", m_hizValid ? m_hizLevels : 0);
+
+        glBindTextureUnit(HIZ_TEXTURE_UNIT, m_hizTexture);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, primitive::RECORD_BUFFER_BINDING, m_recordBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, primitive::COMMAND_BUFFER_BINDING, m_commandBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, primitive::COUNT_BUFFER_BINDING, m_countBuffer);
+
+        m_cullProgram.dispatch((m_recordCount + CULL_WORKGROUP_SIZE - 1) / CULL_WORKGROUP_SIZE, 1, 1);
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+
+    void GpuCuller::draw() const {
+        if (m_recordCount == 0) {
+            return;
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+        glBindBuffer(GL_PARAMETER_BUFFER, m_countBuffer);
+
+        glMultiDrawElementsIndirectCount(
+            GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, 0,
+            static_cast<int>(m_recordCount), sizeof(primitive::DrawElementsIndirectCommand)
+        );
+    }
+
+    void GpuCuller::updateHiZ(const int width, const int height) {
+        if (width <= 0 || height <= 0) {
+            m_hizValid = false;
+            return;
+        }
+
+        if (width != m_hizWidth || height != m_hizHeight) {
+            resizeHiZ(width, height);
+        }
+
+        glCopyTextureSubImage2D(m_depthTexture, 0, 0, 0, 0, 0, width, height);
+
+        for (int level = 0; level < m_hizLevels; level++) {
+            const int levelWidth = std::max(width >> level, 1);
+            const int levelHeight = std::max(height >> level, 1);
+
+            glBindTextureUnit(HIZ_TEXTURE_UNIT, level == 0 ? m_depthTexture : m_hizTexture);
+            glBindImageTexture(0, m_hizTexture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+
+            m_hizProgram.setUniformInt("sourceLevel", std::max(level - 1, 0));
+            m_hizProgram.setUniformInt("reduce", level > 0);
+            m_hizProgram.dispatch(
+                (levelWidth + HIZ_WORKGROUP_SIZE - 1) / HIZ_WORKGROUP_SIZE,
+                (levelHeight + HIZ_WORKGROUP_SIZE - 1) / HIZ_WORKGROUP_SIZE,
+                1
+            );
+
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+        }
+
+        m_hizValid = true;
+    }
+
+    void GpuCuller::resizeHiZ(const int width, const int height) {
+        glDeleteTextures(1, &m_depthTexture);
+        glDeleteTextures(1, &m_hizTexture);
+
+        m_hizWidth = width;
+        m_hizHeight = height;
+        m_hizLevels = static_cast<int>(std::floor(std::log2(std::max(width, height)))) + 1;
+
+        // DSA calls keep the atlas bound on texture unit 0 untouched
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_depthTexture);
+        glTextureStorage2D(m_depthTexture, 1, GL_DEPTH_COMPONENT32F, width, height);
+        glTextureParameteri(m_depthTexture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTextureParameteri(m_depthTexture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_hizTexture);
+        glTextureStorage2D(m_hizTexture, m_hizLevels, GL_R32F, width, height);
+        glTextureParameteri(m_hizTexture, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTextureParameteri(m_hizTexture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        // One 32 bit depth level plus the full 32 bit float pyramid
+        size_t textureBytes = static_cast<size_t>(width) * height * sizeof(float);
+        for (int level = 0; level < m_hizLevels; level++) {
+            textureBytes += static_cast<size_t>(std::max(width >> level, 1)) * std::max(height >> level, 1) * sizeof(float);
+        }
+        m_textureMemory.set(textureBytes);
+
+        m_hizValid = false;
+    }
+}
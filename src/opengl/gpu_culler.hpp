@@ -0,0 +1,55 @@
+#pragma once
+
+#include "shader_permutations.hpp"
+#include "memory_tracker.hpp"
+
+namespace minecraft::opengl {
+    constexpr unsigned int CULL_WORKGROUP_SIZE = 64;
+    constexpr unsigned int HIZ_WORKGROUP_SIZE = 8;
+
+    constexpr unsigned int HIZ_TEXTURE_UNIT = 1;
+
+    // Compute-shader counterpart of system::ChunkCuller, draws with glMultiDrawElementsIndirectCount
+    class GpuCuller {
+    public:
+        GpuCuller();
+        ~GpuCuller();
+
+        GpuCuller(const GpuCuller&) = delete;
+        GpuCuller& operator=(const GpuCuller&) = delete;
+
+        void setRecords(unsigned int recordBuffer, unsigned int recordCount);
+        [[nodiscard]]
+        bool isReady() const;
+
+        void reloadShaders(const std::vector<std::filesystem::path>& changed);
+        void updateShaders();
+
+        void cull(const glm::mat4& viewProj) const;
+        void draw() const;
+        void updateHiZ(int width, int height);
+
+    private:
+        void resizeHiZ(int width, int height);
+
+        ShaderPermutations m_cullPermutations;
+        ShaderPermutations m_hizPermutations;
+        ShaderProgram& m_cullProgram;
+        ShaderProgram& m_hizProgram;
+
+        unsigned int m_recordBuffer{};
+        unsigned int m_recordCount{};
+        unsigned int m_commandBuffer{};
+        unsigned int m_countBuffer{};
+
+        unsigned int m_depthTexture{};
+        unsigned int m_hizTexture{};
+        int m_hizWidth{};
+        int m_hizHeight{};
+        int m_hizLevels{};
+        bool m_hizValid{};
+
+        system::MemoryReservation m_bufferMemory{system::MemoryTag::GPU_BUFFERS, sizeof(unsigned int)};
+        system::MemoryReservation m_textureMemory{system::MemoryTag::GPU_TEXTURES};
+    };
+}
@@ -0,0 +1,53 @@
+#include "gpu_timer.hpp"
+
+#include <glad/glad.h>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace minecraft::opengl {
+
+    unsigned int GLQueryBackend::create() {
+        unsigned int query = 0;
+        glGenQueries(1, &query);
+        return query;
+    }
+
+    void GLQueryBackend::destroy(const unsigned int query) {
+        glDeleteQueries(1, &query);
+    }
+
+    void GLQueryBackend::timestamp(const unsigned int query) {
+        glQueryCounter(query, GL_TIMESTAMP);
+    }
+
+    bool GLQueryBackend::isAvailable(const unsigned int query) {
+        int available = 0;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        return available != 0;
+    }
+
+    uint64_t GLQueryBackend::getResult(const unsigned int query) {
+        GLuint64 result = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+        return result;
+    }
+
+    void printTimings(const GpuTimer& timer) {
+        std::ostringstream table;
+        table << std::left << std::setw(32) << "GPU pass" << std::right
+              << std::setw(10) << "Samples" << std::setw(12) << "Min ms" << std::setw(12) << "Avg ms" << std::setw(12) << "Max ms"
+              << "\n" << std::fixed << std::setprecision(3);
+
+        for (const auto& [name, samples, min, avg, max] : timer.getTimings()) {
+            table << std::left << std::setw(32) << name << std::right
+                  << std::setw(10) << samples << std::setw(12) << min << std::setw(12) << avg << std::setw(12) << max << "\n";
+        }
+
+        if (timer.getDroppedFrames() > 0) {
+            table << timer.getDroppedFrames() << " GPU frames dropped while the GPU was behind\n";
+        }
+
+        std::cout << table.str() << std::flush;
+    }
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace minecraft::opengl {
+    // Frames in flight before a frame's queries are read back, deep enough that reading never waits on the GPU
+    constexpr size_t GPU_TIMER_LATENCY = 3;
+    constexpr size_t GPU_TIMER_WINDOW = 128;
+
+    struct PassTiming {
+        std::string name;
+        uint64_t samples;
+        double minMilliseconds;
+        double avgMilliseconds;
+        double maxMilliseconds;
+    };
+
+    // GL_TIMESTAMP counters, the default backend of GpuTimer
+    struct GLQueryBackend {
+        unsigned int create();
+        void destroy(unsigned int query);
+        void timestamp(unsigned int query);
+        bool isAvailable(unsigned int query);
+        uint64_t getResult(unsigned int query);
+    };
+
+    // Brackets each render pass with a pair of timestamp queries. Every frame gets its own query set
+    // and is read back GPU_TIMER_LATENCY - 1 frames later, only once the driver says it's available.
+    // The backend is a template parameter so the ring can be driven by a fake clock without a GPU
+    template <typename Backend = GLQueryBackend>
+    class BasicGpuTimer {
+    public:
+        explicit BasicGpuTimer(Backend backend = {})
+            : m_backend(std::move(backend)) {}
+
+        ~BasicGpuTimer() {
+            for (const auto& frame : m_frames) {
+                for (const auto& pass : frame.passes) {
+                    m_backend.destroy(pass.start);
+                    m_backend.destroy(pass.end);
+                }
+            }
+        }
+
+        BasicGpuTimer(const BasicGpuTimer&) = delete;
+        BasicGpuTimer& operator=(const BasicGpuTimer&) = delete;
+
+        void beginFrame() {
+            for (size_t i = 1; i < GPU_TIMER_LATENCY; i++) {
+                readBack(m_frames[(m_current + i) % GPU_TIMER_LATENCY]);
+            }
+
+            m_current = (m_current + 1) % GPU_TIMER_LATENCY;
+            Frame& frame = m_frames[m_current];
+
+            // Still unread after a full lap means the GPU is that far behind, drop it rather than wait
+            if (frame.pending) {
+                m_droppedFrames++;
+            }
+
+            frame.used = 0;
+            frame.pending = true;
+        }
+
+        // Passes can't nest, each one ends where the next begins
+        void beginPass(const char* name) {
+            Frame& frame = m_frames[m_current];
+
+            if (frame.used == frame.passes.size()) {
+                frame.passes.push_back(Pass { nullptr, m_backend.create(), m_backend.create() });
+            }
+
+            Pass& pass = frame.passes[frame.used++];
+            pass.name = name;
+            m_backend.timestamp(pass.start);
+        }
+
+        void endPass() {
+            const Frame& frame = m_frames[m_current];
+            m_backend.timestamp(frame.passes[frame.used - 1].end);
+        }
+
+        [[nodiscard]]
+        std::vector<PassTiming> getTimings() const {
+            std::vector<PassTiming> timings;
+
+            for (const auto& name : m_passOrder) {
+                const PassHistory& history = m_history.at(name);
+                const size_t count = std::min<uint64_t>(history.samples, GPU_TIMER_WINDOW);
+
+                uint64_t total = 0, min = UINT64_MAX, max = 0;
+                for (size_t i = 0; i < count; i++) {
+                    total += history.durations[i];
+                    min = std::min(min, history.durations[i]);
+                    max = std::max(max, history.durations[i]);
+                }
+
+                timings.push_back(PassTiming {
+                    name, history.samples,
+                    static_cast<double>(min) / 1e6,
+                    static_cast<double>(total) / static_cast<double>(count) / 1e6,
+                    static_cast<double>(max) / 1e6,
+                });
+            }
+
+            return timings;
+        }
+
+        [[nodiscard]]
+        uint64_t getDroppedFrames() const {
+            return m_droppedFrames;
+        }
+
+        Backend& getBackend() {
+            return m_backend;
+        }
+
+    private:
+        struct Pass {
+            const char* name;
+            unsigned int start;
+            unsigned int end;
+        };
+
+        struct Frame {
+            std::vector<Pass> passes{};
+            size_t used{};
+            bool pending{};
+        };
+
+        struct PassHistory {
+            std::array<uint64_t, GPU_TIMER_WINDOW> durations{};
+            uint64_t samples{};
+        };
+
+        void readBack(Frame& frame) {
+            if (frame.used == 0) {
+                frame.pending = false;
+            }
+
+            // Queries complete in order, so the frame's last counter stands for all of them
+            if (!frame.pending || !m_backend.isAvailable(frame.passes[frame.used - 1].end)) {
+                return;
+            }
+
+            for (size_t i = 0; i < frame.used; i++) {
+                const Pass& pass = frame.passes[i];
+                const uint64_t start = m_backend.getResult(pass.start);
+                const uint64_t end = m_backend.getResult(pass.end);
+
+                auto [history, inserted] = m_history.try_emplace(pass.name);
+                if (inserted) {
+                    m_passOrder.emplace_back(pass.name);
+                }
+
+                history->second.durations[history->second.samples % GPU_TIMER_WINDOW] = end > start ? end - start : 0;
+                history->second.samples++;
+            }
+
+            frame.pending = false;
+        }
+
+        Backend m_backend;
+        std::array<Frame, GPU_TIMER_LATENCY> m_frames{};
+        size_t m_current{};
+
+        std::unordered_map<std::string, PassHistory> m_history{};
+        std::vector<std::string> m_passOrder{};
+        uint64_t m_droppedFrames{};
+    };
+
+    using GpuTimer = BasicGpuTimer<>;
+
+    void printTimings(const GpuTimer& timer);
+}
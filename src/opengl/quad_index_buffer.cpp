@@ -0,0 +1,51 @@
+#include "quad_index_buffer.hpp"
+
+#include <glad/glad.h>
+#include <vector>
+
+namespace minecraft::opengl {
+
+    QuadIndexBuffer::~QuadIndexBuffer() {
+        if (m_indexBuffer != 0) {
+            glDeleteBuffers(1, &m_indexBuffer);
+        }
+    }
+
+    void QuadIndexBuffer::create(const unsigned int quadCount) {
+        // Only ever grows, every draw of up to m_quadCount quads keeps working
+        if (m_indexBuffer != 0 && quadCount <= m_quadCount) {
+            return;
+        }
+
+        std::vector<unsigned int> indices(quadCount * 6);
+
+        for (unsigned int quad = 0; quad < quadCount; quad++) {
+            const unsigned int index = quad * 4;
+
+            indices[quad * 6 + 0] = index;
+            indices[quad * 6 + 1] = index + 1;
+            indices[quad * 6 + 2] = index + 2;
+            indices[quad * 6 + 3] = index;
+            indices[quad * 6 + 4] = index + 2;
+            indices[quad * 6 + 5] = index + 3;
+        }
+
+        // DSA, so filling it never touches the element binding of whichever vertex array is bound
+        if (m_indexBuffer == 0) {
+            glCreateBuffers(1, &m_indexBuffer);
+        }
+
+        glNamedBufferData(m_indexBuffer, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        m_memory.set(indices.size() * sizeof(unsigned int));
+
+        m_quadCount = quadCount;
+    }
+
+    void QuadIndexBuffer::bind() const {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+    }
+
+    unsigned int QuadIndexBuffer::getQuadCount() const {
+        return m_quadCount;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "memory_tracker.hpp"
+
+namespace minecraft::opengl {
+
+    // Static 0,1,2,0,2,3 index pattern offset by 4 per quad, shared by every chunk draw
+    class QuadIndexBuffer {
+    public:
+        QuadIndexBuffer() = default;
+        ~QuadIndexBuffer();
+
+        QuadIndexBuffer(const QuadIndexBuffer&) = delete;
+        QuadIndexBuffer& operator=(const QuadIndexBuffer&) = delete;
+
+        void create(unsigned int quadCount);
+        // Attaches the buffer to the bound vertex array
+        void bind() const;
+
+        [[nodiscard]]
+        unsigned int getQuadCount() const;
+
+    private:
+        unsigned int m_indexBuffer{};
+        unsigned int m_quadCount{};
+        system::MemoryReservation m_memory{system::MemoryTag::GPU_BUFFERS};
+    };
+}
@@ -1,91 +1,307 @@
 #include "shader.hpp"
+#include "shader_cache.hpp"
 
 #include <glad/glad.h>
+#include <GLFW/glfw3.h>
 #include <gtc/type_ptr.hpp>
+#include <algorithm>
 #include <iostream>
-#include <fstream>
 
 namespace minecraft::opengl {
 
-    ShaderProgram::ShaderProgram(const std::string_view vertexName, const std::string_view fragmentName) {
-        const std::filesystem::path vertexPath = SHADERS_DIR / vertexName;
-        const std::filesystem::path fragmentPath = SHADERS_DIR / fragmentName;
+    namespace {
+        // KHR_parallel_shader_compile isn't part of the core loader, so it's fetched by hand
+        constexpr unsigned int GL_MAX_SHADER_COMPILER_THREADS_KHR = 0x91B0;
+        constexpr unsigned int GL_COMPLETION_STATUS_KHR = 0x91B1;
+        constexpr unsigned int DRIVER_CHOOSES_THREAD_COUNT = 0xFFFFFFFF;
 
-        std::string vertexProgram;
-        std::string fragmentProgram;
+        using MaxShaderCompilerThreadsFunction = void (*)(unsigned int);
 
-        std::ifstream vertexFile;
-        std::ifstream fragmentFile;
+        bool hasExtension(const std::string_view name) {
+            int count = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &count);
 
-        vertexFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        fragmentFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+            for (int i = 0; i < count; i++) {
+                const auto* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+                if (extension && name == extension) {
+                    return true;
+                }
+            }
 
-        try {
-            vertexFile.open(vertexPath);
-            fragmentFile.open(fragmentPath);
+            return false;
+        }
+
+        bool hasParallelCompile() {
+            static const bool supported = [] {
+                if (!hasExtension("GL_KHR_parallel_shader_compile") && !hasExtension("GL_ARB_parallel_shader_compile")) {
+                    return false;
+                }
+
+                auto maxThreads = reinterpret_cast<MaxShaderCompilerThreadsFunction>(glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+                if (!maxThreads) {
+                    maxThreads = reinterpret_cast<MaxShaderCompilerThreadsFunction>(glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+                }
 
-            std::stringstream vertexStream, fragmentStream;
-            vertexStream << vertexFile.rdbuf();
-            fragmentStream << fragmentFile.rdbuf();
+                if (maxThreads) {
+                    maxThreads(DRIVER_CHOOSES_THREAD_COUNT);
+                }
 
-            vertexFile.close();
-            fragmentFile.close();
+                return true;
+            }();
 
-            vertexProgram = vertexStream.str();
-            fragmentProgram = fragmentStream.str();
+            return supported;
         }
-        catch (std::ifstream::failure &err) {
-            std::cout << "Shader Loading Error: " << err.what() << std::endl;
+
+        const std::string& getDriverString() {
+            static const std::string driver = [] {
+                std::string result;
+
+                for (const unsigned int name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+                    const auto* value = reinterpret_cast<const char*>(glGetString(name));
+                    result += value ? value : "";
+                    result += '\n';
+                }
+
+                return result;
+            }();
+
+            return driver;
         }
 
-        const char* vertexStr = vertexProgram.c_str();
-        const char* fragmentStr = fragmentProgram.c_str();
+        const system::ShaderPreprocessor& getPreprocessor() {
+            static const system::ShaderPreprocessor preprocessor(SHADERS_DIR);
+            return preprocessor;
+        }
 
-        unsigned int vertex, fragment;
-        int success;
-        char infoLog[512];
+        const system::ShaderCache& getShaderCache() {
+            static const system::ShaderCache cache(SHADER_CACHE_DIR);
+            return cache;
+        }
+    }
 
-        vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vertexStr, nullptr);
-        glCompileShader(vertex);
+    ShaderProgram::ShaderProgram(
+        const std::string_view vertexName, const std::string_view fragmentName, const system::ShaderDefines& defines
+    ) {
+        build({ Stage { GL_VERTEX_SHADER, vertexName, "Vertex" }, Stage { GL_FRAGMENT_SHADER, fragmentName, "Fragment" } }, defines);
+    }
 
-        glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
-        if (!success) {
-            glGetShaderInfoLog(vertex, sizeof(infoLog), nullptr, infoLog);
-            std::cout << "Vertex Shader Compilation Error:\n" << infoLog << std::endl;
+    ShaderProgram::ShaderProgram(const std::string_view computeName, const system::ShaderDefines& defines) {
+        build({ Stage { GL_COMPUTE_SHADER, computeName, "Compute" } }, defines);
+    }
+
+    void ShaderProgram::build(const std::vector<Stage>& stages, const system::ShaderDefines& defines) {
+        std::vector<PendingShader> pending;
+        std::vector<std::string_view> sources;
+
+        for (const auto& [type, name, label] : stages) {
+            // A failed preprocess compiles as an empty stage, which reports through the usual compile log
+            auto preprocessed = getPreprocessor().process(name, defines);
+            pending.push_back(PendingShader { type, 0, label, preprocessed.value_or(system::PreprocessedShader{}) });
         }
 
-        fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fragmentStr, nullptr);
-        glCompileShader(fragment);
+        for (const auto& stage : pending) {
+            sources.push_back(stage.preprocessed.source);
+            m_dependencies.insert(m_dependencies.end(), stage.preprocessed.dependencies.begin(), stage.preprocessed.dependencies.end());
+        }
 
-        glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
-        if (!success) {
-            glGetShaderInfoLog(fragment, sizeof(infoLog), nullptr, infoLog);
-            std::cout << "Fragment Shader Compilation Error:\n" << infoLog << std::endl;
+        // Included files are part of the preprocessed source, so editing one also misses the cache
+        m_cacheKey = system::ShaderCache::makeKey(sources, system::ShaderPreprocessor::toString(defines), getDriverString());
+
+        if (loadBinary()) {
+            return;
         }
 
         Program = glCreateProgram();
-        glAttachShader(Program, vertex);
-        glAttachShader(Program, fragment);
+        glProgramParameteri(Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        for (auto& stage : pending) {
+            const char* sourceStr = stage.preprocessed.source.c_str();
+
+            stage.shader = glCreateShader(stage.type);
+            glShaderSource(stage.shader, 1, &sourceStr, nullptr);
+            glCompileShader(stage.shader);
+            glAttachShader(Program, stage.shader);
+        }
+
+        m_pendingShaders = std::move(pending);
+
+        // Without the extension every status query blocks, so finish straight away
         glLinkProgram(Program);
 
+        if (!hasParallelCompile()) {
+            finishLink();
+        }
+    }
+
+    bool ShaderProgram::loadBinary() {
+        const auto binary = getShaderCache().load(m_cacheKey);
+        if (!binary) {
+            return false;
+        }
+
+        Program = glCreateProgram();
+        glProgramBinary(Program, binary->format, binary->data.data(), static_cast<int>(binary->data.size()));
+
+        int success;
+        glGetProgramiv(Program, GL_LINK_STATUS, &success);
+
+        // Drivers may reject binaries from an older build of themselves even with a matching version string
+        if (!success) {
+            glDeleteProgram(Program);
+            Program = 0;
+            getShaderCache().invalidate(m_cacheKey);
+            return false;
+        }
+
+        m_ready = true;
+        m_linked = true;
+        return true;
+    }
+
+    void ShaderProgram::finishLink() const {
+        int success;
+        char infoLog[512];
+
+        for (const auto& [type, shader, label, preprocessed] : m_pendingShaders) {
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+            if (!success) {
+                glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+                std::cout << label << " Shader Compilation Error:\n"
+                          << system::ShaderPreprocessor::mapErrorLog(infoLog, preprocessed) << std::endl;
+            }
+        }
+
         glGetProgramiv(Program, GL_LINK_STATUS, &success);
         if (!success) {
             glGetProgramInfoLog(Program, sizeof(infoLog), nullptr, infoLog);
             std::cout << "Shader Linking Error:\n" << infoLog << std::endl;
         }
 
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
+        for (const auto& pending : m_pendingShaders) {
+            glDetachShader(Program, pending.shader);
+            glDeleteShader(pending.shader);
+        }
+
+        m_pendingShaders.clear();
+        m_ready = true;
+        m_linked = success;
+
+        if (success) {
+            for (const auto& [name, value] : m_pendingUniforms) {
+                applyUniform(name, value);
+            }
+        }
+
+        m_pendingUniforms.clear();
+
+        int length = 0;
+        glGetProgramiv(Program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+        if (success && length > 0) {
+            system::ShaderBinary binary { 0, std::vector<unsigned char>(length) };
+            glGetProgramBinary(Program, length, nullptr, &binary.format, binary.data.data());
+            getShaderCache().store(m_cacheKey, binary);
+        }
     }
 
-    void ShaderProgram::setUniformMat4(const std::string_view name, glm::mat4 value) const {
+    bool ShaderProgram::isReady() const {
+        if (m_ready) {
+            return true;
+        }
+
+        int complete = 1;
+        if (hasParallelCompile()) {
+            glGetProgramiv(Program, GL_COMPLETION_STATUS_KHR, &complete);
+        }
+
+        if (!complete) {
+            return false;
+        }
+
+        finishLink();
+        return true;
+    }
+
+    bool ShaderProgram::isLinked() const {
+        return isReady() && m_linked;
+    }
+
+    const std::vector<std::filesystem::path>& ShaderProgram::getDependencies() const {
+        return m_dependencies;
+    }
+
+    bool ShaderProgram::dependsOn(const std::vector<std::filesystem::path>& paths) const {
+        return std::ranges::any_of(paths, [this](const std::filesystem::path& path) {
+            return std::ranges::find(m_dependencies, path) != m_dependencies.end();
+        });
+    }
+
+    void ShaderProgram::setUniformMat4(const std::string_view name, const glm::mat4 value) const {
+        setUniform(name, value);
+    }
+
+    void ShaderProgram::setUniformVec3(const std::string_view name, const glm::vec3 value) const {
+        setUniform(name, value);
+    }
+
+    void ShaderProgram::setUniformVec4Array(const std::string_view name, const glm::vec4* values, const int count) const {
+        // Set every frame by the culler, so the copy is only made when it has to be kept
+        if (isReady()) {
+            glProgramUniform4fv(Program, glGetUniformLocation(Program, name.data()), count, glm::value_ptr(values[0]));
+            return;
+        }
+
+        setUniform(name, std::vector<glm::vec4>(values, values + count));
+    }
+
+    void ShaderProgram::setUniformUInt(const std::string_view name, const unsigned int value) const {
+        setUniform(name, value);
+    }
+
+    void ShaderProgram::setUniformInt(const std::string_view name, const int value) const {
+        setUniform(name, value);
+    }
+
+    void ShaderProgram::setUniform(const std::string_view name, UniformValue value) const {
+        if (isReady()) {
+            applyUniform(name, value);
+            return;
+        }
+
+        const auto pending = std::ranges::find(m_pendingUniforms, name, &PendingUniform::name);
+        if (pending != m_pendingUniforms.end()) {
+            pending->value = std::move(value);
+        } else {
+            m_pendingUniforms.push_back(PendingUniform { std::string(name), std::move(value) });
+        }
+    }
+
+    void ShaderProgram::applyUniform(const std::string_view name, const UniformValue& value) const {
         const int location = glGetUniformLocation(Program, name.data());
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+
+        if (const auto* matrix = std::get_if<glm::mat4>(&value)) {
+            glProgramUniformMatrix4fv(Program, location, 1, GL_FALSE, glm::value_ptr(*matrix));
+        } else if (const auto* vector = std::get_if<glm::vec3>(&value)) {
+            glProgramUniform3fv(Program, location, 1, glm::value_ptr(*vector));
+        } else if (const auto* array = std::get_if<std::vector<glm::vec4>>(&value)) {
+            glProgramUniform4fv(Program, location, static_cast<int>(array->size()), reinterpret_cast<const float*>(array->data()));
+        } else if (const auto* unsignedValue = std::get_if<unsigned int>(&value)) {
+            glProgramUniform1ui(Program, location, *unsignedValue);
+        } else {
+            glProgramUniform1i(Program, location, std::get<int>(value));
+        }
     }
 
     void ShaderProgram::use() const {
+        if (!m_ready) {
+            finishLink();
+        }
+
         glUseProgram(Program);
     }
+
+    void ShaderProgram::dispatch(const unsigned int groupsX, const unsigned int groupsY, const unsigned int groupsZ) const {
+        use();
+        glDispatchCompute(groupsX, groupsY, groupsZ);
+    }
 }
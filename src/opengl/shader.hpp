@@ -1,19 +1,81 @@
 #pragma once
 
+#include "shader_preprocessor.hpp"
+
 #include <filesystem>
 #include <glm.hpp>
+#include <string>
+#include <variant>
+#include <vector>
 
 namespace minecraft::opengl {
     const std::filesystem::path SOURCE_DIR = PROJECT_SOURCE_DIR;
     const std::filesystem::path SHADERS_DIR = SOURCE_DIR / "shaders";
+    const std::filesystem::path SHADER_CACHE_DIR = SOURCE_DIR / "cache" / "shaders";
 
+    // Programs come from the binary cache when possible, otherwise they link in the background
+    // when the driver supports KHR_parallel_shader_compile. Nothing should draw with them until isReady().
+    // Uniforms set while the link is pending are kept and applied once it finishes
     class ShaderProgram {
     public:
-        ShaderProgram(std::string_view vertexName, std::string_view fragmentName);
+        ShaderProgram(std::string_view vertexName, std::string_view fragmentName, const system::ShaderDefines& defines = {});
+        explicit ShaderProgram(std::string_view computeName, const system::ShaderDefines& defines = {});
 
+        // Both wait for a pending link rather than leave whatever program was bound before
         void use() const;
+        void dispatch(unsigned int groupsX, unsigned int groupsY, unsigned int groupsZ) const;
+
+        [[nodiscard]]
+        bool isReady() const;
+        [[nodiscard]]
+        bool isLinked() const;
+        // Every file the stages were built from, includes too
+        [[nodiscard]]
+        const std::vector<std::filesystem::path>& getDependencies() const;
+        [[nodiscard]]
+        bool dependsOn(const std::vector<std::filesystem::path>& paths) const;
+
         void setUniformMat4(std::string_view name, glm::mat4 value) const;
+        void setUniformVec3(std::string_view name, glm::vec3 value) const;
+        void setUniformVec4Array(std::string_view name, const glm::vec4* values, int count) const;
+        void setUniformUInt(std::string_view name, unsigned int value) const;
+        void setUniformInt(std::string_view name, int value) const;
 
         unsigned int Program{};
+
+    private:
+        struct Stage {
+            unsigned int type;
+            std::string_view name;
+            std::string_view label;
+        };
+
+        struct PendingShader {
+            unsigned int type;
+            unsigned int shader;
+            std::string_view label;
+            system::PreprocessedShader preprocessed;
+        };
+
+        using UniformValue = std::variant<glm::mat4, glm::vec3, std::vector<glm::vec4>, unsigned int, int>;
+
+        struct PendingUniform {
+            std::string name;
+            UniformValue value;
+        };
+
+        void build(const std::vector<Stage>& stages, const system::ShaderDefines& defines);
+        bool loadBinary();
+        void finishLink() const;
+        // Applies the value now when linked, otherwise keeps it for finishLink, replacing any earlier one of the same name
+        void setUniform(std::string_view name, UniformValue value) const;
+        void applyUniform(std::string_view name, const UniformValue& value) const;
+
+        mutable std::vector<PendingShader> m_pendingShaders{};
+        mutable std::vector<PendingUniform> m_pendingUniforms{};
+        mutable bool m_ready{};
+        mutable bool m_linked{};
+        uint64_t m_cacheKey{};
+        std::vector<std::filesystem::path> m_dependencies{};
     };
 }
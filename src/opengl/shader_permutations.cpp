@@ -0,0 +1,123 @@
+#include "shader_permutations.hpp"
+#include "hash.hpp"
+
+#include <glad/glad.h>
+#include <iostream>
+
+namespace minecraft::opengl {
+
+    ShaderPermutations::ShaderPermutations(std::string vertexName, std::string fragmentName)
+        : m_stageNames({ std::move(vertexName), std::move(fragmentName) }),
+        m_preprocessor(SHADERS_DIR) {}
+
+    ShaderPermutations::ShaderPermutations(std::string computeName)
+        : m_stageNames({ std::move(computeName) }),
+        m_preprocessor(SHADERS_DIR) {}
+
+    ShaderPermutations::~ShaderPermutations() {
+        for (const auto& variant : m_variants) {
+            glDeleteProgram(variant.program->Program);
+
+            if (variant.replacement) {
+                glDeleteProgram(variant.replacement->Program);
+            }
+        }
+    }
+
+    ShaderProgram& ShaderPermutations::get(const system::ShaderDefines& defines) {
+        const std::string key = system::ShaderPreprocessor::toString(defines);
+
+        if (const auto found = m_definesIndices.find(key); found != m_definesIndices.end()) {
+            return *m_variants[found->second].program;
+        }
+
+        const uint64_t hash = getVariantHash(defines);
+
+        if (const auto found = m_hashIndices.find(hash); found != m_hashIndices.end()) {
+            m_definesIndices.emplace(key, found->second);
+            return *m_variants[found->second].program;
+        }
+
+        const size_t index = m_variants.size();
+        m_variants.push_back(Variant { defines, createProgram(defines), nullptr });
+
+        m_definesIndices.emplace(key, index);
+        m_hashIndices.emplace(hash, index);
+
+        return *m_variants[index].program;
+    }
+
+    bool ShaderPermutations::reload(const std::vector<std::filesystem::path>& changed) {
+        bool reloading = false;
+
+        for (auto& variant : m_variants) {
+            if (!variant.program->dependsOn(changed)) {
+                continue;
+            }
+
+            if (variant.replacement) {
+                glDeleteProgram(variant.replacement->Program);
+            }
+
+            variant.replacement = createProgram(variant.defines);
+            reloading = true;
+        }
+
+        // Sources changed, so hashes of new define sets can't be compared against the old ones
+        if (reloading) {
+            m_hashIndices.clear();
+        }
+
+        return reloading;
+    }
+
+    bool ShaderPermutations::update() {
+        bool swapped = false;
+
+        for (auto& variant : m_variants) {
+            if (!variant.replacement || !variant.replacement->isReady()) {
+                continue;
+            }
+
+            // The program object is swapped in place so references held elsewhere stay valid
+            if (variant.replacement->isLinked()) {
+                glDeleteProgram(variant.program->Program);
+                *variant.program = std::move(*variant.replacement);
+                swapped = true;
+
+                std::cout << "Reloaded shader " << m_stageNames.front() << " with "
+                          << variant.defines.size() << " define(s)" << std::endl;
+            } else {
+                glDeleteProgram(variant.replacement->Program);
+                std::cout << "Shader reload failed, keeping the previous " << m_stageNames.front() << std::endl;
+            }
+
+            variant.replacement.reset();
+        }
+
+        return swapped;
+    }
+
+    size_t ShaderPermutations::getProgramCount() const {
+        return m_variants.size();
+    }
+
+    uint64_t ShaderPermutations::getVariantHash(const system::ShaderDefines& defines) const {
+        uint64_t hash = system::HASH_OFFSET_BASIS;
+
+        for (const auto& name : m_stageNames) {
+            const auto preprocessed = m_preprocessor.process(name, defines);
+            hash = system::hashValue(preprocessed ? preprocessed->hash : 0, hash);
+        }
+
+        return hash;
+    }
+
+    std::unique_ptr<ShaderProgram> ShaderPermutations::createProgram(const system::ShaderDefines& defines) const {
+        if (m_stageNames.size() == 1) {
+            return std::make_unique<ShaderProgram>(m_stageNames[0], defines);
+        }
+
+        return std::make_unique<ShaderProgram>(m_stageNames[0], m_stageNames[1], defines);
+    }
+}
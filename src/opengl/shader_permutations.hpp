@@ -0,0 +1,50 @@
+#pragma once
+
+#include "shader.hpp"
+
+#include <memory>
+#include <unordered_map>
+
+namespace minecraft::opengl {
+
+    // Variants of one shader, compiled the first time a define set is requested.
+    // Define sets that preprocess to the same source share a single program
+    class ShaderPermutations {
+    public:
+        ShaderPermutations(std::string vertexName, std::string fragmentName);
+        explicit ShaderPermutations(std::string computeName);
+        ~ShaderPermutations();
+
+        ShaderPermutations(const ShaderPermutations&) = delete;
+        ShaderPermutations& operator=(const ShaderPermutations&) = delete;
+
+        ShaderProgram& get(const system::ShaderDefines& defines);
+
+        // Starts rebuilding every variant that depends on one of the changed files
+        bool reload(const std::vector<std::filesystem::path>& changed);
+        // Swaps in rebuilt variants that finished linking, failed ones keep the old program.
+        // Returns true when a program changed and its uniforms need setting again
+        bool update();
+
+        [[nodiscard]]
+        size_t getProgramCount() const;
+
+    private:
+        struct Variant {
+            system::ShaderDefines defines;
+            std::unique_ptr<ShaderProgram> program;
+            std::unique_ptr<ShaderProgram> replacement;
+        };
+
+        uint64_t getVariantHash(const system::ShaderDefines& defines) const;
+        [[nodiscard]]
+        std::unique_ptr<ShaderProgram> createProgram(const system::ShaderDefines& defines) const;
+
+        std::vector<std::string> m_stageNames{};
+        system::ShaderPreprocessor m_preprocessor;
+
+        std::vector<Variant> m_variants{};
+        std::unordered_map<std::string, size_t> m_definesIndices{};
+        std::unordered_map<uint64_t, size_t> m_hashIndices{};
+    };
+}
@@ -1,11 +1,14 @@
 #include "window.hpp"
+#include "profiler.hpp"
+#include "memory_tracker.hpp"
 
 #include <iostream>
 #include <format>
+#include <utility>
 
 namespace minecraft::opengl {
 
-    Window::Window(const std::string_view title, const int width, const int height)
+    Window::Window(const std::string_view title, const int width, const int height, const bool visible)
         : m_title(title), m_width(width), m_height(height) {
 
         glfwInit();
@@ -13,6 +16,7 @@ namespace minecraft::opengl {
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
 
         m_window = glfwCreateWindow(width, height, title.data(), nullptr, nullptr);
         if (!m_window) {
@@ -33,6 +37,7 @@ namespace minecraft::opengl {
         glfwSetFramebufferSizeCallback(m_window, framebufferSizeCallback);
         glfwSetCursorPosCallback(m_window, mousePositionCallback);
         glfwSetScrollCallback(m_window, scrollCallback);
+        glfwSetMouseButtonCallback(m_window, mouseButtonCallback);
 
         glEnable(GL_DEPTH_TEST);
         glEnable(GL_BLEND);
@@ -43,18 +48,25 @@ namespace minecraft::opengl {
         glfwDestroyWindow(m_window);
     }
 
-    void Window::update() {
-        if (m_cursorLocked) {
-            m_camera->updateUniforms(*m_shader);
-        }
-
-        processInputs();
-        processToggleInputs();
+    void Window::pollEvents() {
+        glfwPollEvents();
 
         const auto currFrameTime = static_cast<float>(glfwGetTime());
         m_deltaTime = currFrameTime - m_lastFrameTime;
         m_lastFrameTime = currFrameTime;
 
+        if (m_inputEnabled) {
+            processInputs();
+        }
+
+        processToggleInputs();
+
+        if (m_cursorLocked) {
+            m_camera->updateUniforms(*m_shader);
+        }
+    }
+
+    void Window::swapBuffers() {
         m_frameCount++;
         m_fpsTimer += m_deltaTime;
 
@@ -68,7 +80,6 @@ namespace minecraft::opengl {
         }
 
         glfwSwapBuffers(m_window);
-        glfwPollEvents();
     }
 
     GLFWwindow *Window::getWindow() const {
@@ -80,6 +91,22 @@ namespace minecraft::opengl {
         m_shader = &shader;
     }
 
+    void Window::setGpuTimer(const GpuTimer& timer) {
+        m_gpuTimer = &timer;
+    }
+
+    void Window::setFrameStats(const system::FrameStats& stats) {
+        m_frameStats = &stats;
+    }
+
+    void Window::setInputEnabled(const bool enabled) {
+        m_inputEnabled = enabled;
+    }
+
+    void Window::setFreeMovement(const bool enabled) {
+        m_freeMovement = enabled;
+    }
+
     float Window::getAspectRatio() const {
         return static_cast<float>(m_width) / static_cast<float>(m_height);
     }
@@ -88,10 +115,42 @@ namespace minecraft::opengl {
         return m_cursorLocked;
     }
 
+    float Window::getDeltaTime() const {
+        return m_deltaTime;
+    }
+
+    glm::vec3 Window::getMovementInput() const {
+        if (!m_inputEnabled) {
+            return glm::vec3(0.0f);
+        }
+
+        const auto axis = [this](const int positive, const int negative) {
+            return static_cast<float>(glfwGetKey(m_window, positive) == GLFW_PRESS)
+                 - static_cast<float>(glfwGetKey(m_window, negative) == GLFW_PRESS);
+        };
+
+        return glm::vec3(
+            axis(GLFW_KEY_D, GLFW_KEY_A),
+            axis(GLFW_KEY_SPACE, GLFW_KEY_LEFT_SHIFT),
+            axis(GLFW_KEY_W, GLFW_KEY_S)
+        );
+    }
+
+    bool Window::takeBreakClick() {
+        return std::exchange(m_breakClicked, false);
+    }
+
+    bool Window::takePlaceClick() {
+        return std::exchange(m_placeClicked, false);
+    }
+
     void Window::processInputs() const {
         if (glfwGetKey(m_window, GLFW_KEY_X) == GLFW_PRESS)
             glfwSetWindowShouldClose(m_window, true);
 
+        if (!m_freeMovement)
+            return;
+
         if (glfwGetKey(m_window, GLFW_KEY_W) == GLFW_PRESS)
             m_camera->processKeyboard(primitive::Direction::FRONT, m_deltaTime);
 
@@ -114,6 +173,7 @@ namespace minecraft::opengl {
     void Window::processToggleInputs() {
         static bool escapePressed = false;
         static bool keyVPressed = false;
+        static bool keyPPressed = false;
 
         if (glfwGetKey(m_window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
             if (!escapePressed) {
@@ -136,6 +196,28 @@ namespace minecraft::opengl {
         } else {
             keyVPressed = false;
         }
+
+        if (glfwGetKey(m_window, GLFW_KEY_P) == GLFW_PRESS) {
+            if (!keyPPressed) {
+                system::Profiler::get().printStats();
+                system::Profiler::get().exportTrace(system::PROFILER_TRACE_PATH);
+
+                if (m_gpuTimer) {
+                    printTimings(*m_gpuTimer);
+                }
+
+                if (m_frameStats) {
+                    m_frameStats->printSummary();
+                    m_frameStats->dump(system::FRAME_STATS_DUMP_PATH);
+                }
+
+                system::MemoryTracker::printStats();
+            }
+
+            keyPPressed = true;
+        } else {
+            keyPPressed = false;
+        }
     }
 
     void Window::framebufferSizeCallback(GLFWwindow* window, const int width, const int height) {
@@ -168,13 +250,31 @@ namespace minecraft::opengl {
         lastX = fposX;
         lastY = fposY;
 
-        if (windowPtr->m_cursorLocked) {
+        if (windowPtr->m_cursorLocked && windowPtr->m_inputEnabled) {
             windowPtr->m_camera->processMouseMovement(offsetX, offsetY);
         }
     }
 
     void Window::scrollCallback(GLFWwindow *window, const double, const double offsetY) {
         const auto* windowPtr = static_cast<Window*>(glfwGetWindowUserPointer(window));
-        windowPtr->m_camera->processMouseScroll(static_cast<float>(offsetY));
+
+        if (windowPtr->m_inputEnabled) {
+            windowPtr->m_camera->processMouseScroll(static_cast<float>(offsetY));
+        }
+    }
+
+    void Window::mouseButtonCallback(GLFWwindow* window, const int button, const int action, int) {
+        auto* windowPtr = static_cast<Window*>(glfwGetWindowUserPointer(window));
+
+        // With the cursor free the crosshair isn't aimed at anything
+        if (action != GLFW_PRESS || !windowPtr->m_cursorLocked || !windowPtr->m_inputEnabled) {
+            return;
+        }
+
+        if (button == GLFW_MOUSE_BUTTON_LEFT) {
+            windowPtr->m_breakClicked = true;
+        } else if (button == GLFW_MOUSE_BUTTON_RIGHT) {
+            windowPtr->m_placeClicked = true;
+        }
     }
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "player_camera.hpp"
+#include "gpu_timer.hpp"
+#include "frame_stats.hpp"
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
@@ -13,11 +15,19 @@ namespace minecraft::opengl {
 
     class Window {
     public:
-        Window(std::string_view title, int width, int height);
+        Window(std::string_view title, int width, int height, bool visible = true);
         ~Window();
 
-        void update();
+        // Input for the coming frame, then present it, so a frame's phases can be timed apart
+        void pollEvents();
+        void swapBuffers();
         void setCameraRefs(system::PlayerCamera& camera, ShaderProgram& shader);
+        void setGpuTimer(const GpuTimer& timer);
+        void setFrameStats(const system::FrameStats& stats);
+        // Replays drive the camera themselves, so keyboard and mouse are ignored
+        void setInputEnabled(bool enabled);
+        // With it off the movement keys only feed getMovementInput, for a camera moved by physics
+        void setFreeMovement(bool enabled);
 
         [[nodiscard]]
         GLFWwindow* getWindow() const;
@@ -25,6 +35,14 @@ namespace minecraft::opengl {
         float getAspectRatio() const;
         [[nodiscard]]
         bool getCursorLockedState() const;
+        [[nodiscard]]
+        float getDeltaTime() const;
+        // Held movement keys as right, up and forward in -1 to 1
+        [[nodiscard]]
+        glm::vec3 getMovementInput() const;
+        // Whether the button was clicked since the last call, only counting clicks with the cursor locked
+        bool takeBreakClick();
+        bool takePlaceClick();
 
     private:
         void processInputs() const;
@@ -33,12 +51,15 @@ namespace minecraft::opengl {
         static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
         static void mousePositionCallback(GLFWwindow* window, double posX, double posY);
         static void scrollCallback(GLFWwindow* window, double offsetX, double offsetY);
+        static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
 
         GLFWwindow* m_window{};
         std::string_view m_title;
 
         system::PlayerCamera* m_camera{};
         ShaderProgram* m_shader{};
+        const GpuTimer* m_gpuTimer{};
+        const system::FrameStats* m_frameStats{};
 
         int m_width{};
         int m_height{};
@@ -50,6 +71,10 @@ namespace minecraft::opengl {
         float m_deltaTime{};
 
         bool m_cursorLocked{};
+        bool m_inputEnabled{true};
+        bool m_freeMovement{true};
         bool m_enableVsync{};
+        bool m_breakClicked{};
+        bool m_placeClicked{};
     };
 }
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <glm.hpp>
+
+namespace minecraft::primitive {
+
+    struct BoundingBox {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <glm.hpp>
+
 namespace minecraft::primitive {
 
     enum class Direction {
@@ -11,7 +13,26 @@ namespace minecraft::primitive {
         BACK,
     };
 
-    inline unsigned int getDirectionID(Direction direction) {
+    constexpr unsigned int DIRECTION_COUNT = 6;
+
+    constexpr unsigned int getDirectionID(Direction direction) {
         return static_cast<unsigned int>(direction);
     }
+
+    constexpr Direction getOppositeDirection(const Direction direction) {
+        return static_cast<Direction>(getDirectionID(direction) ^ 1u);
+    }
+
+    constexpr glm::ivec3 getDirectionOffset(const Direction direction) {
+        switch (direction) {
+            case Direction::UP:     return { 0, 1, 0 };
+            case Direction::DOWN:   return { 0, -1, 0 };
+            case Direction::RIGHT:  return { 1, 0, 0 };
+            case Direction::LEFT:   return { -1, 0, 0 };
+            case Direction::FRONT:  return { 0, 0, 1 };
+            case Direction::BACK:   return { 0, 0, -1 };
+        }
+
+        return { 0, 0, 0 };
+    }
 }
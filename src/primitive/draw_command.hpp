@@ -0,0 +1,31 @@
+#pragma once
+
+#include <glm.hpp>
+
+namespace minecraft::primitive {
+    constexpr unsigned int FACE_BUFFER_BINDING = 0;
+    constexpr unsigned int RECORD_BUFFER_BINDING = 1;
+    constexpr unsigned int COMMAND_BUFFER_BINDING = 2;
+    constexpr unsigned int COUNT_BUFFER_BINDING = 3;
+
+    // Layout matches the std430 structs in chunk_cull_compute.glsl and face_vertex.glsl
+    struct ChunkDrawRecord {
+        glm::vec4 origin;
+        glm::vec4 aabbMin;
+        glm::vec4 aabbMax;
+        unsigned int firstFace;
+        unsigned int faceCount;
+        unsigned int padding[2];
+    };
+
+    struct DrawElementsIndirectCommand {
+        unsigned int count;
+        unsigned int instanceCount;
+        unsigned int firstIndex;
+        int baseVertex;
+        unsigned int baseInstance;
+    };
+
+    static_assert(sizeof(ChunkDrawRecord) == 64);
+    static_assert(sizeof(DrawElementsIndirectCommand) == 20);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "direction.hpp"
+#include <glm.hpp>
+#include <cstdint>
+
+namespace minecraft::primitive {
+
+    // Bit layout of a face record, must match face_vertex.glsl
+    constexpr unsigned int FACE_X_BITS = 5;
+    constexpr unsigned int FACE_Y_BITS = 8;
+    constexpr unsigned int FACE_Z_BITS = 5;
+    constexpr unsigned int FACE_DIRECTION_BITS = 3;
+    constexpr unsigned int FACE_LAYER_BITS = 7;
+    constexpr unsigned int FACE_LIGHT_BITS = 4;
+
+    constexpr unsigned int FACE_X_OFFSET = 0;
+    constexpr unsigned int FACE_Y_OFFSET = FACE_X_OFFSET + FACE_X_BITS;
+    constexpr unsigned int FACE_Z_OFFSET = FACE_Y_OFFSET + FACE_Y_BITS;
+    constexpr unsigned int FACE_DIRECTION_OFFSET = FACE_Z_OFFSET + FACE_Z_BITS;
+    constexpr unsigned int FACE_LAYER_OFFSET = FACE_DIRECTION_OFFSET + FACE_DIRECTION_BITS;
+    constexpr unsigned int FACE_LIGHT_OFFSET = FACE_LAYER_OFFSET + FACE_LAYER_BITS;
+
+    static_assert(FACE_LIGHT_OFFSET + FACE_LIGHT_BITS == 32);
+
+    constexpr unsigned int MAX_FACE_LIGHT = (1u << FACE_LIGHT_BITS) - 1;
+    constexpr unsigned int MAX_FACE_LAYER = (1u << FACE_LAYER_BITS) - 1;
+
+    constexpr unsigned int CORNERS_PER_FACE = 4;
+    constexpr unsigned int INDICES_PER_FACE = 6;
+
+    struct PackedFace {
+        uint32_t data;
+    };
+
+    struct UnpackedFace {
+        glm::ivec3 position;
+        Direction direction;
+        unsigned int layer;
+        unsigned int light;
+    };
+
+    constexpr uint32_t packField(const unsigned int value, const unsigned int offset, const unsigned int bits) {
+        return (value & ((1u << bits) - 1)) << offset;
+    }
+
+    constexpr unsigned int unpackField(const uint32_t data, const unsigned int offset, const unsigned int bits) {
+        return (data >> offset) & ((1u << bits) - 1);
+    }
+
+    constexpr PackedFace packFace(
+        const glm::ivec3 position, const Direction direction,
+        const unsigned int layer, const unsigned int light
+    ) {
+        return PackedFace {
+            packField(position.x, FACE_X_OFFSET, FACE_X_BITS) |
+            packField(position.y, FACE_Y_OFFSET, FACE_Y_BITS) |
+            packField(position.z, FACE_Z_OFFSET, FACE_Z_BITS) |
+            packField(getDirectionID(direction), FACE_DIRECTION_OFFSET, FACE_DIRECTION_BITS) |
+            packField(layer, FACE_LAYER_OFFSET, FACE_LAYER_BITS) |
+            packField(light, FACE_LIGHT_OFFSET, FACE_LIGHT_BITS)
+        };
+    }
+
+    constexpr UnpackedFace unpackFace(const PackedFace face) {
+        return UnpackedFace {
+            glm::ivec3(
+                static_cast<int>(unpackField(face.data, FACE_X_OFFSET, FACE_X_BITS)),
+                static_cast<int>(unpackField(face.data, FACE_Y_OFFSET, FACE_Y_BITS)),
+                static_cast<int>(unpackField(face.data, FACE_Z_OFFSET, FACE_Z_BITS))
+            ),
+            static_cast<Direction>(unpackField(face.data, FACE_DIRECTION_OFFSET, FACE_DIRECTION_BITS)),
+            unpackField(face.data, FACE_LAYER_OFFSET, FACE_LAYER_BITS),
+            unpackField(face.data, FACE_LIGHT_OFFSET, FACE_LIGHT_BITS),
+        };
+    }
+}
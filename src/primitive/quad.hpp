@@ -1,66 +1,31 @@
 #pragma once
 
 #include "direction.hpp"
+#include <array>
 #include <glm.hpp>
 
 namespace minecraft::primitive {
-    struct Quad {
-        glm::vec3 vertices[4];
-        glm::vec2 texCoord[4];
-        glm::ivec3 position;
-        Direction direction;
 
-        Quad(const Direction direction, const glm::vec3 position)
-            : texCoord{}, position(position), direction(direction) {
-
-            texCoord[0] = glm::vec2(0.0, 0.0);
-            texCoord[1] = glm::vec2(1.0, 0.0);
-            texCoord[2] = glm::vec2(1.0, 1.0);
-            texCoord[3] = glm::vec2(0.0, 1.0);
-
-            switch (direction) {
-                case Direction::FRONT:
-                    vertices[0] = glm::vec3(position.x + 1.0, position.y, position.z);
-                    vertices[1] = glm::vec3(position.x + 1.0, position.y + 1.0, position.z);
-                    vertices[2] = glm::vec3(position.x, position.y + 1.0, position.z);
-                    vertices[3] = glm::vec3(position.x, position.y, position.z);
-                    break;
-
-                case Direction::BACK:
-                    vertices[0] = glm::vec3(position.x, position.y, position.z);
-                    vertices[1] = glm::vec3(position.x, position.y + 1.0, position.z);
-                    vertices[2] = glm::vec3(position.x + 1.0, position.y + 1.0, position.z);
-                    vertices[3] = glm::vec3(position.x + 1.0, position.y, position.z);
-                    break;
-
-                case Direction::LEFT:
-                    vertices[0] = glm::vec3(position.x, position.y, position.z);
-                    vertices[1] = glm::vec3(position.x, position.y, position.z + 1.0);
-                    vertices[2] = glm::vec3(position.x, position.y + 1.0, position.z + 1.0);
-                    vertices[3] = glm::vec3(position.x, position.y + 1.0, position.z);
-                    break;
-
-                case Direction::RIGHT:
-                    vertices[0] = glm::vec3(position.x, position.y + 1.0, position.z);
-                    vertices[1] = glm::vec3(position.x, position.y + 1.0, position.z + 1.0);
-                    vertices[2] = glm::vec3(position.x, position.y, position.z + 1.0);
-                    vertices[3] = glm::vec3(position.x, position.y, position.z);
-                    break;
-
-                case Direction::UP:
-                    vertices[0] = glm::vec3(position.x, position.y, position.z + 1.0);
-                    vertices[1] = glm::vec3(position.x + 1.0, position.y, position.z + 1.0);
-                    vertices[2] = glm::vec3(position.x + 1.0, position.y, position.z);
-                    vertices[3] = glm::vec3(position.x, position.y, position.z);
-                    break;
-
-                case Direction::DOWN:
-                    vertices[0] = glm::vec3(position.x, position.y, position.z);
-                    vertices[1] = glm::vec3(position.x + 1.0, position.y, position.z);
-                    vertices[2] = glm::vec3(position.x + 1.0, position.y, position.z + 1.0);
-                    vertices[3] = glm::vec3(position.x, position.y, position.z + 1.0);
-                    break;
-            }
-        }
+    // Corner offsets from the face's cell in triangle order, indexed by getDirectionID
+    inline const std::array<std::array<glm::vec3, 4>, DIRECTION_COUNT> QUAD_CORNERS {{
+        // UP
+        {{ { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }},
+        // DOWN
+        {{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 1.0f } }},
+        // RIGHT
+        {{ { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f } }},
+        // LEFT
+        {{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f } }},
+        // FRONT
+        {{ { 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }},
+        // BACK
+        {{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } }},
+    }};
+
+    inline const std::array<glm::vec2, 4> QUAD_TEX_COORDS {
+        glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f),
     };
+
+    constexpr unsigned int QUAD_VERTEX_COUNT = 4;
+    constexpr unsigned int QUAD_INDEX_COUNT = 6;
 }
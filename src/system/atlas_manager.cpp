@@ -1,11 +1,68 @@
 #include "atlas_manager.hpp"
+#include "block_compression.hpp"
+#include "hash.hpp"
+#include "mapped_file.hpp"
+#include "mipmap.hpp"
+#include "profiler.hpp"
+#include "worker_pool.hpp"
 
 #include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <ranges>
 
 namespace minecraft::system {
-    AtlasManager::AtlasManager() {
+
+    namespace {
+        constexpr uint32_t ATLAS_CACHE_MAGIC = 0x434c5441;  // "ATLC"
+        constexpr uint32_t ATLAS_CACHE_VERSION = 2;
+        constexpr size_t ATLAS_CACHE_ALIGNMENT = 16;
+
+        // On disk layout: header, region table, name blob, every RGBA mip level back to back,
+        // then the compressed mip levels when the atlas isn't RGBA8
+        struct AtlasCacheHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t key;
+            int32_t width;
+            int32_t height;
+            int32_t levelCount;
+            int32_t regionCount;
+            uint32_t format;
+            float psnr;
+            uint64_t pixelOffset;
+        };
+
+        struct AtlasCacheRegion {
+            int32_t x;
+            int32_t y;
+            int32_t width;
+            int32_t height;
+            uint32_t nameOffset;
+            uint32_t nameLength;
+        };
+
+        constexpr auto largerFirst = [](const auto& a, const auto& b) {
+            return std::max(a->width, a->height) > std::max(b->width, b->height);
+        };
+
+        size_t getLevelSize(const int width, const int height, const int level, const AtlasFormat format = AtlasFormat::RGBA8) {
+            const int levelWidth = std::max(width >> level, 1);
+            const int levelHeight = std::max(height >> level, 1);
+
+            if (format == AtlasFormat::BC7) {
+                return getBC7Size(levelWidth, levelHeight);
+            }
+
+            return static_cast<size_t>(levelWidth) * levelHeight * 4;
+        }
+    }
+
+    AtlasManager::AtlasManager(const int padding, const AtlasFormat format)
+        : m_padding(std::max(padding, 0)), m_format(format) {
         stbi_set_flip_vertically_on_load(true);
     }
 
@@ -14,31 +71,34 @@ namespace minecraft::system {
     }
 
     bool AtlasManager::loadTexture(const std::string_view name, const std::string_view path) {
-        if (m_atlasRegions.contains(name.data())) {
-            return true;
-        }
+        return loadTextures({ TextureSource { std::string(name), std::string(path) } });
+    }
 
-        const std::string texturePath = (ASSETS_DIR / path).string();
-        const auto texture = std::make_shared<Texture>();
-
-        texture->path = texturePath;
-        texture->data = stbi_load(
-            texturePath.c_str(),
-            &texture->width, &texture->height,
-            &texture->channels,
-            STBI_rgb_alpha
-        );
+    bool AtlasManager::loadTextures(const std::vector<TextureSource>& sources) {
+        bool success = true;
 
-        if (!texture->data) {
-            std::cerr << "Failed to load data for texture: " << path << std::endl;
-            return false;
-        }
+        // Decoding is deferred to build(), which can skip it entirely when the cached atlas is still valid
+        for (const auto& [name, path] : sources) {
+            if (m_textureCache.contains(name)) {
+                continue;
+            }
 
-        m_pendingTextures.push_back(texture);
-        m_textureCache[name.data()] = texture;
-        m_requiresRebuild = true;
+            const auto texture = std::make_shared<Texture>();
+            texture->name = name;
+            texture->path = (ASSETS_DIR / path).string();
 
-        return true;
+            if (!std::filesystem::is_regular_file(texture->path)) {
+                std::cerr << "Failed to find texture: " << path << std::endl;
+                success = false;
+                continue;
+            }
+
+            m_pendingTextures.push_back(texture);
+            m_textureCache[name] = texture;
+            m_requiresRebuild = true;
+        }
+
+        return success;
     }
 
     bool AtlasManager::build() {
@@ -46,84 +106,111 @@ namespace minecraft::system {
             return true;
         }
 
-        std::ranges::sort(
-            m_pendingTextures,
-            [](const std::shared_ptr<Texture>& a, const std::shared_ptr<Texture>& b) {
-                return a->height, b->height;
-            }
-        );
+        ProfileZone zone("AtlasManager::build");
 
-        int area = 0;
-        int maxWidth = 0, maxHeight = 0;
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t key = hashSources();
 
-        for (const auto& texture : m_pendingTextures) {
-            area += texture->width * texture->height;
-            maxWidth = std::max(maxWidth, texture->width);
-            maxHeight = std::max(maxHeight, texture->height);
-        }
+        const bool cached = loadCache(key);
+        bool incremental = false;
 
-        m_atlasWidth = MIN_ATLAS_SIZE;
-        m_atlasHeight = MIN_ATLAS_SIZE;
+        if (!cached) {
+            decodeTextures(m_pendingTextures);
+            std::ranges::sort(m_pendingTextures, largerFirst);
 
-        while (m_atlasWidth * m_atlasHeight < area || m_atlasWidth < maxWidth || m_atlasHeight < maxHeight) {
-            if (m_atlasWidth < m_atlasHeight) {
-                m_atlasWidth *= 2;
-            } else {
-                m_atlasHeight *= 2;
-            }
+            // New textures go into the free space of the current atlas, only a full one is repacked
+            std::vector<PackedRect> updated;
+            incremental = m_id != 0 && insertPending(updated);
 
-            if (m_atlasWidth > MAX_ATLAS_SIZE || m_atlasHeight > MAX_ATLAS_SIZE) {
-                std::cerr << "Atlas size too large. Max size: " << MAX_ATLAS_SIZE << std::endl;
+            if (!incremental && !repackAll()) {
+                m_pendingTextures.clear();
+                m_requiresRebuild = false;
                 return false;
             }
-        }
 
-        std::vector<unsigned char> atlasData;
-        if (!packTextures(atlasData)) {
-            return false;
-        }
+            buildMipLevels();
 
-        if (m_id != 0) {
-            glDeleteTextures(1, &m_id);
-        }
+            // Compressed blocks don't line up with the packed rects, so any change re-encodes the whole atlas
+            if (m_format != AtlasFormat::RGBA8) {
+                compressLevels();
+                createTexture(getLevelPointers());
+            } else if (incremental) {
+                for (const auto& rect : updated) {
+                    uploadRect(rect);
+                }
 
-        glGenTextures(1, &m_id);
-        glBindTexture(GL_TEXTURE_2D, m_id);
+                uploadMipLevels();
+            } else {
+                createTexture(getLevelPointers());
+            }
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            writeCache(key);
+        }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_atlasWidth, m_atlasHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, atlasData.data());
-        glGenerateMipmap(GL_TEXTURE_2D);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        m_stats.width = m_atlasWidth;
+        m_stats.height = m_atlasHeight;
+        m_stats.occupancy = m_packer.getOccupancy();
 
         m_pendingTextures.clear();
         m_requiresRebuild = false;
 
-        std::cout << "Built texture atlas (" << m_atlasWidth << "x" << m_atlasHeight << ") with "
-                      << m_atlasRegions.size() << " textures" << std::endl;
+        std::cout << (cached ? "Loaded cached" : incremental ? "Updated" : "Built") << " texture atlas ("
+                      << m_atlasWidth << "x" << m_atlasHeight << ") with " << m_atlasRegions.size() << " textures, "
+                      << m_stats.occupancy * 100.0f << "% occupied in " << elapsed.count() << "ms" << std::endl;
+
+        if (m_format == AtlasFormat::BC7 && !cached) {
+            std::cout << "Texture atlas BC7 encode took " << m_stats.encodeMilliseconds << "ms, PSNR "
+                      << m_stats.psnr << "dB" << std::endl;
+        }
 
         return true;
     }
 
+    bool AtlasManager::pack() {
+        if (m_pendingTextures.empty()) {
+            return true;
+        }
+
+        ProfileZone zone("AtlasManager::pack");
+
+        decodeTextures(m_pendingTextures);
+        const bool packed = repackAll();
+
+        if (packed) {
+            buildMipLevels();
+
+            if (m_format != AtlasFormat::RGBA8) {
+                compressLevels();
+            }
+        }
+
+        m_stats.width = m_atlasWidth;
+        m_stats.height = m_atlasHeight;
+        m_stats.occupancy = m_packer.getOccupancy();
+
+        m_pendingTextures.clear();
+        m_requiresRebuild = false;
+        return packed;
+    }
+
     bool AtlasManager::save(const std::string_view path) const {
-        if (m_id == 0) {
+        if (m_atlasData.empty()) {
             return false;
         }
 
         const std::string texturePath = (ASSETS_DIR / path).string();
-        std::vector<unsigned char> atlasData(m_atlasWidth * m_atlasHeight * 4);
-
-        glBindTexture(GL_TEXTURE_2D, m_id);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, atlasData.data());
 
         stbi_flip_vertically_on_write(true);
-        stbi_write_png(texturePath.c_str(), m_atlasWidth, m_atlasHeight, STBI_rgb_alpha, atlasData.data(), m_atlasWidth * 4);
+        stbi_write_png(texturePath.c_str(), m_atlasWidth, m_atlasHeight, STBI_rgb_alpha, m_atlasData.data(), m_atlasWidth * 4);
 
         return true;
     }
 
+    AtlasStats AtlasManager::getStats() const {
+        return m_stats;
+    }
+
     unsigned int AtlasManager::getID() {
         if (m_requiresRebuild) {
             build();
@@ -149,87 +236,601 @@ namespace minecraft::system {
         m_textureCache.erase(name.data());
     }
 
+    bool AtlasManager::reloadTexture(const std::filesystem::path& path) {
+        ProfileZone zone("AtlasManager::reloadTexture");
+
+        if (m_id == 0 || m_requiresRebuild) {
+            return false;
+        }
+
+        std::error_code error;
+        const auto changed = std::filesystem::weakly_canonical(path, error);
+
+        std::vector<std::shared_ptr<Texture>> reloaded;
+        bool resized = false;
+
+        for (const auto& texture : m_textureCache | std::views::values) {
+            if (std::filesystem::weakly_canonical(texture->path, error) != changed) {
+                continue;
+            }
+
+            int width, height, channels;
+            unsigned char* data = stbi_load(texture->path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+
+            // Editors often save in several steps, a half written file keeps the previous pixels
+            if (!data) {
+                std::cerr << "Failed to reload texture: " << texture->path << std::endl;
+                continue;
+            }
+
+            resized |= width + m_padding * 2 != texture->rect.width || height + m_padding * 2 != texture->rect.height;
+
+            stbi_image_free(texture->data);
+            texture->data = data;
+            texture->width = width;
+            texture->height = height;
+            texture->channels = channels;
+
+            reloaded.push_back(texture);
+        }
+
+        if (reloaded.empty()) {
+            return false;
+        }
+
+        // Same sized textures are patched in place, anything else needs a fresh layout
+        if (resized) {
+            if (!repackAll()) {
+                return false;
+            }
+        } else {
+            for (const auto& texture : reloaded) {
+                placeTexture(*texture, texture->rect);
+            }
+        }
+
+        buildMipLevels();
+
+        if (m_format != AtlasFormat::RGBA8 || resized) {
+            if (m_format != AtlasFormat::RGBA8) {
+                compressLevels();
+            }
+
+            createTexture(getLevelPointers());
+        } else {
+            for (const auto& texture : reloaded) {
+                uploadRect(texture->rect);
+            }
+
+            uploadMipLevels();
+        }
+
+        writeCache(hashSources());
+
+        std::cout << "Reloaded " << reloaded.size() << " atlas texture(s) from " << path.filename().string() << std::endl;
+        return true;
+    }
+
     void AtlasManager::unloadAll() {
         if (m_id != 0) {
             glDeleteTextures(1, &m_id);
             m_id = 0;
         }
 
+        m_textureMemory.set(0);
         m_atlasRegions.clear();
         m_pendingTextures.clear();
         m_textureCache.clear();
+        m_atlasData.clear();
+        m_mipLevels.clear();
+        m_compressedLevels.clear();
+        m_stats = {};
+    }
+
+    uint64_t AtlasManager::hashSources() const {
+        std::vector<std::shared_ptr<Texture>> textures;
+        for (const auto& texture : m_textureCache | std::views::values) {
+            textures.push_back(texture);
+        }
+
+        std::ranges::sort(textures, {}, &Texture::name);
+
+        uint64_t key = hashValue(ATLAS_CACHE_VERSION);
+        key = hashValue(m_padding, key);
+        key = hashValue(m_format, key);
+
+        // File contents rather than timestamps, so touching or re-exporting an unchanged texture stays a hit
+        std::vector<char> contents;
+
+        for (const auto& texture : textures) {
+            std::ifstream file(texture->path, std::ios::binary | std::ios::ate);
+            contents.resize(file ? static_cast<size_t>(file.tellg()) : 0);
+
+            file.seekg(0);
+            file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+
+            key = hashString(texture->name, key);
+            key = hashValue(contents.size(), key);
+            key = hashBytes(contents.data(), contents.size(), key);
+        }
+
+        return key;
     }
 
-    bool AtlasManager::packTextures(std::vector<unsigned char>& atlasData) {
-        atlasData.resize(m_atlasWidth * m_atlasHeight * 4);
-        int posX = 0, posY = 0;
-        int rowHeight = 0;
+    void AtlasManager::decodeTextures(std::vector<std::shared_ptr<Texture>>& textures) {
+        ProfileZone zone("AtlasManager::decodeTextures");
+
+        std::vector<std::shared_ptr<Texture>> undecoded;
+        std::ranges::copy_if(textures, std::back_inserter(undecoded), [](const auto& texture) { return !texture->data; });
+
+        if (undecoded.empty()) {
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        // Decoding dominates startup, so spread the files over the worker pool
+        WorkerPool::get().parallelFor(undecoded.size(), [&](const size_t index) {
+            ProfileZone textureZone("stbi_load");
+            Texture& texture = *undecoded[index];
+            texture.data = stbi_load(
+                texture.path.c_str(),
+                &texture.width, &texture.height,
+                &texture.channels,
+                STBI_rgb_alpha
+            );
+        });
+
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        m_stats.decodeMilliseconds = elapsed.count();
+
+        for (const auto& texture : undecoded) {
+            if (!texture->data) {
+                std::cerr << "Failed to load data for texture: " << texture->path << std::endl;
+                m_textureCache.erase(texture->name);
+            }
+        }
+
+        std::erase_if(textures, [](const auto& texture) { return !texture->data; });
+    }
+
+    bool AtlasManager::loadCache(const uint64_t key) {
+        MappedFile file;
+        if (!file.open(ATLAS_CACHE_PATH) || file.getSize() < sizeof(AtlasCacheHeader)) {
+            return false;
+        }
+
+        const unsigned char* data = file.getData();
+        const size_t size = file.getSize();
+
+        AtlasCacheHeader header{};
+        std::memcpy(&header, data, sizeof(header));
+
+        if (header.magic != ATLAS_CACHE_MAGIC || header.version != ATLAS_CACHE_VERSION || header.key != key
+            || header.format != static_cast<uint32_t>(m_format)) {
+            return false;
+        }
+
+        if (header.width <= 0 || header.height <= 0 || header.levelCount != getMipLevelCount(header.width, header.height)) {
+            return false;
+        }
+
+        size_t pixelBytes = 0;
+        for (int level = 0; level < header.levelCount; level++) {
+            pixelBytes += getLevelSize(header.width, header.height, level);
+
+            if (m_format != AtlasFormat::RGBA8) {
+                pixelBytes += getLevelSize(header.width, header.height, level, m_format);
+            }
+        }
+
+        const size_t regionBytes = static_cast<size_t>(header.regionCount) * sizeof(AtlasCacheRegion);
+        if (header.regionCount < 0 || sizeof(header) + regionBytes > header.pixelOffset || header.pixelOffset + pixelBytes > size) {
+            return false;
+        }
+
+        const unsigned char* table = data + sizeof(header);
+        const unsigned char* names = table + regionBytes;
+
+        for (int i = 0; i < header.regionCount; i++) {
+            AtlasCacheRegion entry{};
+            std::memcpy(&entry, table + i * sizeof(AtlasCacheRegion), sizeof(entry));
+
+            if (sizeof(header) + regionBytes + entry.nameOffset + entry.nameLength > header.pixelOffset) {
+                return false;
+            }
+        }
 
+        m_atlasWidth = header.width;
+        m_atlasHeight = header.height;
+        m_packer.reset(m_atlasWidth, m_atlasHeight);
         m_atlasRegions.clear();
 
-        for (const auto& texture : m_pendingTextures) {
-            std::string textureName;
+        for (int i = 0; i < header.regionCount; i++) {
+            AtlasCacheRegion entry{};
+            std::memcpy(&entry, table + i * sizeof(AtlasCacheRegion), sizeof(entry));
 
-            for (const auto& [name, cachedTexture] : m_textureCache) {
-                if (cachedTexture == texture) {
-                    textureName = name;
-                    break;
-                }
+            const PackedRect rect { entry.x, entry.y, entry.width, entry.height };
+            const std::string name(reinterpret_cast<const char*>(names + entry.nameOffset), entry.nameLength);
+
+            const auto texture = m_textureCache.find(name);
+            if (texture != m_textureCache.end()) {
+                texture->second->rect = rect;
+            }
+
+            m_packer.occupy(rect);
+            setRegion(name, rect);
+        }
+
+        // Level 0 stays on the CPU for incremental inserts, the GPU copy comes straight from the mapping.
+        // Mip levels are rebuilt by the next insert anyway
+        const unsigned char* pixels = data + header.pixelOffset;
+        m_atlasData.assign(pixels, pixels + getLevelSize(m_atlasWidth, m_atlasHeight, 0));
+        m_mipLevels.clear();
+        m_compressedLevels.clear();
+
+        std::vector<const unsigned char*> levels;
+        for (int level = 0; level < header.levelCount; level++) {
+            levels.push_back(pixels);
+            pixels += getLevelSize(m_atlasWidth, m_atlasHeight, level);
+        }
+
+        if (m_format != AtlasFormat::RGBA8) {
+            for (int level = 0; level < header.levelCount; level++) {
+                levels[level] = pixels;
+                pixels += getLevelSize(m_atlasWidth, m_atlasHeight, level, m_format);
             }
+        }
+
+        createTexture(levels);
+
+        m_stats.encodeMilliseconds = 0.0;
+        m_stats.psnr = header.psnr;
+
+        return true;
+    }
+
+    void AtlasManager::writeCache(const uint64_t key) const {
+        std::vector<AtlasCacheRegion> regions;
+        std::string names;
+
+        for (const auto& texture : m_textureCache | std::views::values) {
+            regions.push_back(AtlasCacheRegion {
+                texture->rect.x, texture->rect.y, texture->rect.width, texture->rect.height,
+                static_cast<uint32_t>(names.size()), static_cast<uint32_t>(texture->name.size())
+            });
+
+            names += texture->name;
+        }
+
+        const size_t tableBytes = sizeof(AtlasCacheHeader) + regions.size() * sizeof(AtlasCacheRegion) + names.size();
+        const size_t pixelOffset = (tableBytes + ATLAS_CACHE_ALIGNMENT - 1) / ATLAS_CACHE_ALIGNMENT * ATLAS_CACHE_ALIGNMENT;
+
+        const AtlasCacheHeader header {
+            ATLAS_CACHE_MAGIC, ATLAS_CACHE_VERSION, key,
+            m_atlasWidth, m_atlasHeight, static_cast<int32_t>(m_mipLevels.size() + 1),
+            static_cast<int32_t>(regions.size()), static_cast<uint32_t>(m_format), m_stats.psnr, pixelOffset
+        };
+
+        std::error_code error;
+        std::filesystem::create_directories(ATLAS_CACHE_PATH.parent_path(), error);
+
+        std::ofstream file(ATLAS_CACHE_PATH, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Failed to write texture atlas cache: " << ATLAS_CACHE_PATH << std::endl;
+            return;
+        }
+
+        const std::vector<char> alignment(pixelOffset - tableBytes);
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(regions.data()), static_cast<std::streamsize>(regions.size() * sizeof(AtlasCacheRegion)));
+        file.write(names.data(), static_cast<std::streamsize>(names.size()));
+        file.write(alignment.data(), static_cast<std::streamsize>(alignment.size()));
+        file.write(reinterpret_cast<const char*>(m_atlasData.data()), static_cast<std::streamsize>(m_atlasData.size()));
+
+        for (const auto& level : m_mipLevels) {
+            file.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+        }
 
-            if (textureName.empty()) {
+        for (const auto& level : m_compressedLevels) {
+            file.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+        }
+    }
+
+    bool AtlasManager::insertPending(std::vector<PackedRect>& updated) {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (const auto& texture : m_pendingTextures) {
+            const auto cached = m_textureCache.find(texture->name);
+            if (cached == m_textureCache.end() || cached->second != texture) {
                 continue;
             }
 
-            if (posX + texture->width > m_atlasWidth) {
-                posX = 0;
-                posY += rowHeight;
-                rowHeight = 0;
+            const auto rect = m_packer.insert(texture->width + m_padding * 2, texture->height + m_padding * 2);
+            if (!rect) {
+                return false;
+            }
+
+            placeTexture(*texture, *rect);
+            updated.push_back(*rect);
+        }
+
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        m_stats.packMilliseconds = elapsed.count();
+        return true;
+    }
+
+    bool AtlasManager::repackAll() {
+        std::vector<std::shared_ptr<Texture>> textures;
+        textures.reserve(m_textureCache.size());
+
+        for (const auto& texture : m_textureCache | std::views::values) {
+            textures.push_back(texture);
+        }
+
+        // Textures restored from the cache were never decoded
+        decodeTextures(textures);
+        std::ranges::sort(textures, largerFirst);
+
+        // Packing and blitting only, decode has its own stat
+        const auto start = std::chrono::steady_clock::now();
+
+        long long area = 0;
+        int maxWidth = 0, maxHeight = 0;
+
+        for (const auto& texture : textures) {
+            const int width = texture->width + m_padding * 2;
+            const int height = texture->height + m_padding * 2;
+
+            area += static_cast<long long>(width) * height;
+            maxWidth = std::max(maxWidth, width);
+            maxHeight = std::max(maxHeight, height);
+        }
+
+        m_atlasWidth = MIN_ATLAS_SIZE;
+        m_atlasHeight = MIN_ATLAS_SIZE;
+
+        const auto grow = [this] {
+            if (m_atlasWidth < m_atlasHeight) {
+                m_atlasWidth *= 2;
+            } else {
+                m_atlasHeight *= 2;
             }
 
-            if (posY + texture->height > m_atlasHeight) {
+            return m_atlasWidth <= static_cast<int>(MAX_ATLAS_SIZE) && m_atlasHeight <= static_cast<int>(MAX_ATLAS_SIZE);
+        };
+
+        while (static_cast<long long>(m_atlasWidth) * m_atlasHeight < area || m_atlasWidth < maxWidth || m_atlasHeight < maxHeight) {
+            if (!grow()) {
                 std::cerr << "Atlas size too large. Max size: " << MAX_ATLAS_SIZE << std::endl;
-                m_requiresRebuild = false;
                 return false;
             }
+        }
 
-            rowHeight = std::max(rowHeight, texture->height);
-
-            for (int y = 0; y < texture->height; y++) {
-                for (int x = 0; x < texture->width; x++) {
+        std::vector<PackedRect> rects(textures.size());
 
-                    const int srcIdx = (y * texture->width + x) * texture->channels;
-                    const int dstIdx = ((posY + y) * m_atlasWidth + posX + x) * 4;
+        while (true) {
+            m_packer.reset(m_atlasWidth, m_atlasHeight);
 
-                    for (int ch = 0; ch < std::min(3, texture->channels); ch++) {
-                        atlasData[dstIdx + ch] = texture->data[srcIdx + ch];
-                    }
+            bool packed = true;
+            for (size_t i = 0; i < textures.size() && packed; i++) {
+                const auto rect = m_packer.insert(textures[i]->width + m_padding * 2, textures[i]->height + m_padding * 2);
+                packed = rect.has_value();
 
-                    atlasData[dstIdx + 3] = texture->channels == 4
-                        ? texture->data[srcIdx + 3]
-                        : 255;
+                if (packed) {
+                    rects[i] = *rect;
                 }
             }
 
-            AtlasRegion region{};
+            if (packed) {
+                break;
+            }
+
+            if (!grow()) {
+                std::cerr << "Atlas size too large. Max size: " << MAX_ATLAS_SIZE << std::endl;
+                return false;
+            }
+        }
+
+        m_atlasData.assign(static_cast<size_t>(m_atlasWidth) * m_atlasHeight * 4, 0);
+        m_atlasRegions.clear();
+
+        for (size_t i = 0; i < textures.size(); i++) {
+            placeTexture(*textures[i], rects[i]);
+        }
+
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        m_stats.packMilliseconds = elapsed.count();
+        return true;
+    }
+
+    void AtlasManager::placeTexture(Texture& texture, const PackedRect& rect) {
+        const int posX = rect.x + m_padding;
+        const int posY = rect.y + m_padding;
+
+        // stbi_load expands every image to RGBA, so each row is a single copy
+        const size_t textureRowBytes = static_cast<size_t>(texture.width) * 4;
 
-            region.topLeft = glm::vec2(
-                static_cast<float>(posX) / static_cast<float>(m_atlasWidth),
-                static_cast<float>(posY) / static_cast<float>(m_atlasHeight)
+        for (int y = 0; y < texture.height; y++) {
+            std::memcpy(
+                m_atlasData.data() + (static_cast<size_t>(posY + y) * m_atlasWidth + posX) * 4,
+                texture.data + y * textureRowBytes,
+                textureRowBytes
             );
+        }
+
+        // Extrude the edge texels into the padding, columns first so the corners get filled by the rows
+        for (int y = posY; y < posY + texture.height; y++) {
+            unsigned char* row = m_atlasData.data() + static_cast<size_t>(y) * m_atlasWidth * 4;
+
+            for (int i = 1; i <= m_padding; i++) {
+                std::memcpy(row + (posX - i) * 4, row + posX * 4, 4);
+                std::memcpy(row + (posX + texture.width - 1 + i) * 4, row + (posX + texture.width - 1) * 4, 4);
+            }
+        }
+
+        const size_t rowBytes = static_cast<size_t>(rect.width) * 4;
+        const auto rowAt = [&](const int y) {
+            return m_atlasData.data() + (static_cast<size_t>(y) * m_atlasWidth + rect.x) * 4;
+        };
+
+        for (int i = 1; i <= m_padding; i++) {
+            std::memcpy(rowAt(posY - i), rowAt(posY), rowBytes);
+            std::memcpy(rowAt(posY + texture.height - 1 + i), rowAt(posY + texture.height - 1), rowBytes);
+        }
+
+        texture.rect = rect;
+        setRegion(texture.name, rect);
+    }
+
+    void AtlasManager::setRegion(const std::string& name, const PackedRect& rect) {
+        const int posX = rect.x + m_padding;
+        const int posY = rect.y + m_padding;
+
+        AtlasRegion region{};
+
+        region.width = rect.width - m_padding * 2;
+        region.height = rect.height - m_padding * 2;
+
+        region.topLeft = glm::vec2(
+            static_cast<float>(posX) / static_cast<float>(m_atlasWidth),
+            static_cast<float>(posY) / static_cast<float>(m_atlasHeight)
+        );
+
+        region.bottomRight = glm::vec2(
+            static_cast<float>(posX + region.width) / static_cast<float>(m_atlasWidth),
+            static_cast<float>(posY + region.height) / static_cast<float>(m_atlasHeight)
+        );
 
-            region.bottomRight = glm::vec2(
-                static_cast<float>(posX + texture->width) / static_cast<float>(m_atlasWidth),
-                static_cast<float>(posY + texture->height) / static_cast<float>(m_atlasHeight)
+        m_atlasRegions[name] = region;
+    }
+
+    void AtlasManager::buildMipLevels() {
+        const int levelCount = getMipLevelCount(m_atlasWidth, m_atlasHeight);
+        m_mipLevels.resize(levelCount - 1);
+
+        const unsigned char* source = m_atlasData.data();
+
+        for (int level = 1; level < levelCount; level++) {
+            m_mipLevels[level - 1].resize(getLevelSize(m_atlasWidth, m_atlasHeight, level));
+
+            downsampleRGBA(
+                source, std::max(m_atlasWidth >> (level - 1), 1), std::max(m_atlasHeight >> (level - 1), 1),
+                m_mipLevels[level - 1].data()
             );
 
-            region.width = texture->width;
-            region.height = texture->height;
+            source = m_mipLevels[level - 1].data();
+        }
+    }
+
+    void AtlasManager::compressLevels() {
+        ProfileZone zone("AtlasManager::compressLevels");
+
+        const auto start = std::chrono::steady_clock::now();
+
+        m_compressedLevels.clear();
+        const std::vector<const unsigned char*> sources = getLevelPointers();
 
-            m_atlasRegions[textureName] = region;
-            posX += texture->width;
+        m_compressedLevels.resize(sources.size());
+
+        for (size_t level = 0; level < sources.size(); level++) {
+            const int width = std::max(m_atlasWidth >> level, 1);
+            const int height = std::max(m_atlasHeight >> level, 1);
+
+            m_compressedLevels[level].resize(getBC7Size(width, height));
+            compressBC7(sources[level], width, height, m_compressedLevels[level].data());
         }
 
-        return true;
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        m_stats.encodeMilliseconds = elapsed.count();
+
+        std::vector<unsigned char> decoded(m_atlasData.size());
+        decompressBC7(m_compressedLevels[0].data(), m_atlasWidth, m_atlasHeight, decoded.data());
+        m_stats.psnr = getPSNR(m_atlasData.data(), decoded.data(), decoded.size());
+    }
+
+    std::vector<const unsigned char*> AtlasManager::getLevelPointers() const {
+        std::vector<const unsigned char*> levels;
+
+        if (!m_compressedLevels.empty()) {
+            for (const auto& level : m_compressedLevels) {
+                levels.push_back(level.data());
+            }
+
+            return levels;
+        }
+
+        levels.push_back(m_atlasData.data());
+        for (const auto& level : m_mipLevels) {
+            levels.push_back(level.data());
+        }
+
+        return levels;
+    }
+
+    void AtlasManager::createTexture(const std::vector<const unsigned char*>& levels) {
+        ProfileZone zone("AtlasManager::createTexture");
+
+        if (m_id != 0) {
+            glDeleteTextures(1, &m_id);
+        }
+
+        glGenTextures(1, &m_id);
+        glBindTexture(GL_TEXTURE_2D, m_id);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        const bool compressed = m_format == AtlasFormat::BC7;
+        const auto levelCount = static_cast<int>(levels.size());
+
+        glTexStorage2D(GL_TEXTURE_2D, levelCount, compressed ? GL_COMPRESSED_RGBA_BPTC_UNORM : GL_RGBA8, m_atlasWidth, m_atlasHeight);
+
+        size_t textureBytes = 0;
+        for (int level = 0; level < levelCount; level++) {
+            textureBytes += getLevelSize(m_atlasWidth, m_atlasHeight, level, m_format);
+        }
+        m_textureMemory.set(textureBytes);
+
+        for (int level = 0; level < levelCount; level++) {
+            const int width = std::max(m_atlasWidth >> level, 1);
+            const int height = std::max(m_atlasHeight >> level, 1);
+
+            if (compressed) {
+                glCompressedTexSubImage2D(
+                    GL_TEXTURE_2D, level, 0, 0, width, height, GL_COMPRESSED_RGBA_BPTC_UNORM,
+                    static_cast<int>(getBC7Size(width, height)), levels[level]
+                );
+            } else {
+                glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, levels[level]);
+            }
+        }
+    }
+
+    void AtlasManager::uploadRect(const PackedRect& rect) const {
+        ProfileZone zone("AtlasManager::uploadRect");
+
+        const unsigned char* pixels = m_atlasData.data() + (static_cast<size_t>(rect.y) * m_atlasWidth + rect.x) * 4;
+
+        glBindTexture(GL_TEXTURE_2D, m_id);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, m_atlasWidth);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
+    void AtlasManager::uploadMipLevels() const {
+        ProfileZone zone("AtlasManager::uploadMipLevels");
+
+        glBindTexture(GL_TEXTURE_2D, m_id);
+
+        for (size_t level = 1; level <= m_mipLevels.size(); level++) {
+            const int width = std::max(m_atlasWidth >> level, 1);
+            const int height = std::max(m_atlasHeight >> level, 1);
+
+            glTexSubImage2D(GL_TEXTURE_2D, static_cast<int>(level), 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, m_mipLevels[level - 1].data());
+        }
     }
 }
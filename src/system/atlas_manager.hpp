@@ -3,7 +3,11 @@
 #include <stb_image.h>
 #include <stb_image_write.h>
 
+#include "rect_packer.hpp"
+#include "memory_tracker.hpp"
+
 #include <glm.hpp>
+#include <cstdint>
 #include <optional>
 #include <vector>
 #include <unordered_map>
@@ -14,6 +18,10 @@ namespace minecraft::system {
     const std::filesystem::path SOURCE_DIR = PROJECT_SOURCE_DIR;
     const std::filesystem::path ASSETS_DIR = SOURCE_DIR / "assets";
     const std::filesystem::path SHADERS_DIR = SOURCE_DIR / "shaders";
+    const std::filesystem::path CACHE_DIR = SOURCE_DIR / "cache";
+
+    using AtlasPixels = TrackedVector<unsigned char, MemoryTag::TEXTURES>;
+    const std::filesystem::path ATLAS_CACHE_PATH = CACHE_DIR / "atlas.bin";
 
     struct AtlasRegion {
         int width;
@@ -24,15 +32,42 @@ namespace minecraft::system {
 
     constexpr unsigned int MAX_BLOCK_COUNT = 1;
     constexpr unsigned int MIN_ATLAS_SIZE = 32;
-    constexpr unsigned int MAX_ATLAS_SIZE = MIN_ATLAS_SIZE * 4;
+    constexpr unsigned int MAX_ATLAS_SIZE = 4096;
+
+    // Border around each texture, filled with its edge texels so filtering never bleeds into neighbours
+    constexpr int ATLAS_PADDING = 1;
+
+    struct TextureSource {
+        std::string name;
+        std::string path;
+    };
+
+    enum class AtlasFormat {
+        RGBA8,
+        BC7,
+    };
+
+    struct AtlasStats {
+        int width;
+        int height;
+        float occupancy;
+        double decodeMilliseconds;
+        // Placing and blitting the rects alone, without decode, cache I/O or upload
+        double packMilliseconds;
+        double encodeMilliseconds;
+        float psnr;
+    };
 
     class AtlasManager {
     public:
-        AtlasManager();
+        explicit AtlasManager(int padding = ATLAS_PADDING, AtlasFormat format = AtlasFormat::RGBA8);
         ~AtlasManager();
 
         bool loadTexture(std::string_view name, std::string_view path);
+        bool loadTextures(const std::vector<TextureSource>& sources);
         void unloadTexture(std::string_view name);
+        // Re-decodes every texture loaded from path and patches it into the built atlas
+        bool reloadTexture(const std::filesystem::path& path);
         void createUniformBuffer();
         void updateUniformBuffer();
 
@@ -42,7 +77,14 @@ namespace minecraft::system {
         bool save(std::string_view path) const;
 
         unsigned int getID();
+        [[nodiscard]]
+        AtlasStats getStats() const;
+
         bool build();
+        // Decodes and packs the loaded textures, builds their mip chain and encodes it when the format is compressed,
+        // all on the CPU, leaving out the cache and every GL call. For benchmarks and tools without a context, the
+        // game calls build()
+        bool pack();
         void unloadAll();
 
     private:
@@ -51,10 +93,12 @@ namespace minecraft::system {
             int width;
             int height;
             unsigned char* data;
+            std::string name;
             std::string path;
+            PackedRect rect;
 
             Texture()
-                : channels(0), width(0), height(0), data(nullptr) {}
+                : channels(0), width(0), height(0), data(nullptr), rect() {}
 
             ~Texture() {
                 stbi_image_free(data);
@@ -70,17 +114,45 @@ namespace minecraft::system {
             FaceTexCoords texCoords[MAX_BLOCK_COUNT * 6];
         };
 
-        bool packTextures(std::vector<unsigned char>& atlasData);
+        [[nodiscard]]
+        uint64_t hashSources() const;
+        void decodeTextures(std::vector<std::shared_ptr<Texture>>& textures);
+
+        bool loadCache(uint64_t key);
+        void writeCache(uint64_t key) const;
+
+        bool insertPending(std::vector<PackedRect>& updated);
+        bool repackAll();
+        void placeTexture(Texture& texture, const PackedRect& rect);
+        void setRegion(const std::string& name, const PackedRect& rect);
+        void buildMipLevels();
+        void compressLevels();
+
+        [[nodiscard]]
+        std::vector<const unsigned char*> getLevelPointers() const;
+        void createTexture(const std::vector<const unsigned char*>& levels);
+        void uploadRect(const PackedRect& rect) const;
+        void uploadMipLevels() const;
 
         std::unordered_map<std::string, AtlasRegion> m_atlasRegions{};
         std::unordered_map<std::string, std::shared_ptr<Texture>> m_textureCache{};
         std::vector<std::shared_ptr<Texture>> m_pendingTextures{};
 
+        RectPacker m_packer{};
+        AtlasPixels m_atlasData{};
+        std::vector<AtlasPixels> m_mipLevels{};
+        std::vector<AtlasPixels> m_compressedLevels{};
+        AtlasStats m_stats{};
+
         unsigned int m_id{};
         unsigned int m_uniformBuffer{};
         int m_atlasWidth{};
         int m_atlasHeight{};
+        int m_padding{};
+        AtlasFormat m_format{};
 
         bool m_requiresRebuild{};
+
+        MemoryReservation m_textureMemory{MemoryTag::GPU_TEXTURES};
     };
 }
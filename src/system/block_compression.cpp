@@ -0,0 +1,307 @@
+#include "block_compression.hpp"
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace minecraft::system {
+
+    namespace {
+        constexpr int BLOCK_PIXELS = BC_BLOCK_DIMENSION * BC_BLOCK_DIMENSION;
+        constexpr int INDEX_COUNT = 16;
+
+        constexpr int BC7_WEIGHTS[INDEX_COUNT] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        struct BitWriter {
+            unsigned char* data;
+            int position;
+
+            void write(const uint32_t value, const int bits) {
+                for (int i = 0; i < bits; i++, position++) {
+                    data[position >> 3] |= static_cast<unsigned char>(((value >> i) & 1u) << (position & 7));
+                }
+            }
+        };
+
+        struct BitReader {
+            const unsigned char* data;
+            int position;
+
+            uint32_t read(const int bits) {
+                uint32_t value = 0;
+                for (int i = 0; i < bits; i++, position++) {
+                    value |= static_cast<uint32_t>((data[position >> 3] >> (position & 7)) & 1u) << i;
+                }
+
+                return value;
+            }
+        };
+
+        int interpolate(const int e0, const int e1, const int index) {
+            return ((64 - BC7_WEIGHTS[index]) * e0 + BC7_WEIGHTS[index] * e1 + 32) >> 6;
+        }
+
+        void readBlock(const unsigned char* source, const int width, const int height, const int blockX, const int blockY, float pixels[BLOCK_PIXELS][4]) {
+            for (int y = 0; y < BC_BLOCK_DIMENSION; y++) {
+                for (int x = 0; x < BC_BLOCK_DIMENSION; x++) {
+                    // Partial edge blocks repeat the last row/column
+                    const int sx = std::min(blockX * BC_BLOCK_DIMENSION + x, width - 1);
+                    const int sy = std::min(blockY * BC_BLOCK_DIMENSION + y, height - 1);
+                    const unsigned char* pixel = source + (static_cast<size_t>(sy) * width + sx) * 4;
+
+                    for (int c = 0; c < 4; c++) {
+                        pixels[y * BC_BLOCK_DIMENSION + x][c] = pixel[c];
+                    }
+                }
+            }
+        }
+
+        // Endpoints along the principal axis of the block's colours
+        void findEndpoints(const float pixels[BLOCK_PIXELS][4], float e0[4], float e1[4]) {
+            float mean[4]{};
+            for (int i = 0; i < BLOCK_PIXELS; i++) {
+                for (int c = 0; c < 4; c++) {
+                    mean[c] += pixels[i][c] / BLOCK_PIXELS;
+                }
+            }
+
+            float covariance[4][4]{};
+            for (int i = 0; i < BLOCK_PIXELS; i++) {
+                for (int a = 0; a < 4; a++) {
+                    for (int b = 0; b < 4; b++) {
+                        covariance[a][b] += (pixels[i][a] - mean[a]) * (pixels[i][b] - mean[b]);
+                    }
+                }
+            }
+
+            float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            for (int iteration = 0; iteration < 8; iteration++) {
+                float next[4]{};
+                float length = 0.0f;
+
+                for (int a = 0; a < 4; a++) {
+                    for (int b = 0; b < 4; b++) {
+                        next[a] += covariance[a][b] * axis[b];
+                    }
+
+                    length = std::max(length, std::abs(next[a]));
+                }
+
+                if (length < 1e-6f) {
+                    break;
+                }
+
+                for (int a = 0; a < 4; a++) {
+                    axis[a] = next[a] / length;
+                }
+            }
+
+            float minT = std::numeric_limits<float>::max();
+            float maxT = std::numeric_limits<float>::lowest();
+            float axisLength = 0.0f;
+
+            for (const float a : axis) {
+                axisLength += a * a;
+            }
+
+            for (int i = 0; i < BLOCK_PIXELS; i++) {
+                float t = 0.0f;
+                for (int c = 0; c < 4; c++) {
+                    t += (pixels[i][c] - mean[c]) * axis[c];
+                }
+
+                t /= std::max(axisLength, 1e-6f);
+                minT = std::min(minT, t);
+                maxT = std::max(maxT, t);
+            }
+
+            for (int c = 0; c < 4; c++) {
+                e0[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+                e1[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+            }
+        }
+
+        struct BlockEncoding {
+            int quantized[2][4];
+            int pBits[2];
+            int indices[BLOCK_PIXELS];
+            float error;
+        };
+
+        // Mode 6 endpoints are 7 bits per channel plus one shared low bit, try each combination
+        BlockEncoding quantizeEndpoints(const float pixels[BLOCK_PIXELS][4], const float e0[4], const float e1[4]) {
+            BlockEncoding best{};
+            best.error = std::numeric_limits<float>::max();
+
+            for (int pBits = 0; pBits < 4; pBits++) {
+                BlockEncoding encoding { {}, { pBits & 1, pBits >> 1 }, {}, 0.0f };
+                int palette[INDEX_COUNT][4];
+
+                for (int c = 0; c < 4; c++) {
+                    encoding.quantized[0][c] = std::clamp(static_cast<int>(std::lround((e0[c] - encoding.pBits[0]) / 2.0f)), 0, 127);
+                    encoding.quantized[1][c] = std::clamp(static_cast<int>(std::lround((e1[c] - encoding.pBits[1]) / 2.0f)), 0, 127);
+                }
+
+                for (int index = 0; index < INDEX_COUNT; index++) {
+                    for (int c = 0; c < 4; c++) {
+                        palette[index][c] = interpolate(
+                            encoding.quantized[0][c] * 2 + encoding.pBits[0],
+                            encoding.quantized[1][c] * 2 + encoding.pBits[1],
+                            index
+                        );
+                    }
+                }
+
+                for (int i = 0; i < BLOCK_PIXELS; i++) {
+                    float nearest = std::numeric_limits<float>::max();
+
+                    for (int index = 0; index < INDEX_COUNT; index++) {
+                        float distance = 0.0f;
+                        for (int c = 0; c < 4; c++) {
+                            const float delta = pixels[i][c] - static_cast<float>(palette[index][c]);
+                            distance += delta * delta;
+                        }
+
+                        if (distance < nearest) {
+                            nearest = distance;
+                            encoding.indices[i] = index;
+                        }
+                    }
+
+                    encoding.error += nearest;
+                }
+
+                if (encoding.error < best.error) {
+                    best = encoding;
+                }
+            }
+
+            return best;
+        }
+
+        void encodeBlock(const float pixels[BLOCK_PIXELS][4], unsigned char* destination) {
+            float e0[4], e1[4];
+            findEndpoints(pixels, e0, e1);
+
+            BlockEncoding best = quantizeEndpoints(pixels, e0, e1);
+
+            // The first index is stored without its top bit, so it has to be in the lower half
+            if (best.indices[0] >= INDEX_COUNT / 2) {
+                std::swap(best.quantized[0], best.quantized[1]);
+                std::swap(best.pBits[0], best.pBits[1]);
+
+                for (int& index : best.indices) {
+                    index = INDEX_COUNT - 1 - index;
+                }
+            }
+
+            std::memset(destination, 0, BC7_BLOCK_BYTES);
+            BitWriter writer { destination, 0 };
+
+            writer.write(1u << 6, 7);
+            for (int c = 0; c < 4; c++) {
+                writer.write(best.quantized[0][c], 7);
+                writer.write(best.quantized[1][c], 7);
+            }
+
+            writer.write(best.pBits[0], 1);
+            writer.write(best.pBits[1], 1);
+
+            writer.write(best.indices[0], 3);
+            for (int i = 1; i < BLOCK_PIXELS; i++) {
+                writer.write(best.indices[i], 4);
+            }
+        }
+
+        void decodeBlock(const unsigned char* source, unsigned char pixels[BLOCK_PIXELS][4]) {
+            BitReader reader { source, 0 };
+
+            if (reader.read(7) != 1u << 6) {
+                std::memset(pixels, 0, BLOCK_PIXELS * 4);
+                return;
+            }
+
+            int quantized[2][4];
+            for (int c = 0; c < 4; c++) {
+                quantized[0][c] = static_cast<int>(reader.read(7));
+                quantized[1][c] = static_cast<int>(reader.read(7));
+            }
+
+            const int p0 = static_cast<int>(reader.read(1));
+            const int p1 = static_cast<int>(reader.read(1));
+
+            for (int i = 0; i < BLOCK_PIXELS; i++) {
+                const int index = static_cast<int>(reader.read(i == 0 ? 3 : 4));
+
+                for (int c = 0; c < 4; c++) {
+                    pixels[i][c] = static_cast<unsigned char>(interpolate(quantized[0][c] * 2 + p0, quantized[1][c] * 2 + p1, index));
+                }
+            }
+        }
+
+        int getBlockCount(const int size) {
+            return (size + BC_BLOCK_DIMENSION - 1) / BC_BLOCK_DIMENSION;
+        }
+    }
+
+    size_t getBC7Size(const int width, const int height) {
+        return static_cast<size_t>(getBlockCount(width)) * getBlockCount(height) * BC7_BLOCK_BYTES;
+    }
+
+    void compressBC7(const unsigned char* source, const int width, const int height, unsigned char* destination) {
+        const int blocksX = getBlockCount(width);
+        const int blocksY = getBlockCount(height);
+
+        WorkerPool::get().parallelFor(static_cast<size_t>(blocksY), [&](const size_t row) {
+            const int blockY = static_cast<int>(row);
+            float pixels[BLOCK_PIXELS][4];
+
+            for (int blockX = 0; blockX < blocksX; blockX++) {
+                readBlock(source, width, height, blockX, blockY, pixels);
+                encodeBlock(pixels, destination + (static_cast<size_t>(blockY) * blocksX + blockX) * BC7_BLOCK_BYTES);
+            }
+        });
+    }
+
+    void decompressBC7(const unsigned char* source, const int width, const int height, unsigned char* destination) {
+        const int blocksX = getBlockCount(width);
+        const int blocksY = getBlockCount(height);
+        unsigned char pixels[BLOCK_PIXELS][4];
+
+        for (int blockY = 0; blockY < blocksY; blockY++) {
+            for (int blockX = 0; blockX < blocksX; blockX++) {
+                decodeBlock(source + (static_cast<size_t>(blockY) * blocksX + blockX) * BC7_BLOCK_BYTES, pixels);
+
+                for (int y = 0; y < BC_BLOCK_DIMENSION; y++) {
+                    for (int x = 0; x < BC_BLOCK_DIMENSION; x++) {
+                        const int dx = blockX * BC_BLOCK_DIMENSION + x;
+                        const int dy = blockY * BC_BLOCK_DIMENSION + y;
+
+                        if (dx < width && dy < height) {
+                            std::memcpy(destination + (static_cast<size_t>(dy) * width + dx) * 4, pixels[y * BC_BLOCK_DIMENSION + x], 4);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    float getPSNR(const unsigned char* a, const unsigned char* b, const size_t size) {
+        double squaredError = 0.0;
+        for (size_t i = 0; i < size; i++) {
+            const double delta = static_cast<double>(a[i]) - static_cast<double>(b[i]);
+            squaredError += delta * delta;
+        }
+
+        if (squaredError == 0.0 || size == 0) {
+            return std::numeric_limits<float>::infinity();
+        }
+
+        const double mse = squaredError / static_cast<double>(size);
+        return static_cast<float>(10.0 * std::log10(255.0 * 255.0 / mse));
+    }
+}
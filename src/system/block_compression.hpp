@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+namespace minecraft::system {
+    constexpr int BC_BLOCK_DIMENSION = 4;
+    constexpr size_t BC7_BLOCK_BYTES = 16;
+
+    // Size of a BC7 image, partial blocks at the edges are rounded up
+    size_t getBC7Size(int width, int height);
+
+    // Encodes an RGBA8 image as BC7 mode 6 blocks, rows of blocks are spread over worker threads
+    void compressBC7(const unsigned char* source, int width, int height, unsigned char* destination);
+
+    // Decodes BC7 mode 6 blocks (the only mode compressBC7 emits) back to RGBA8
+    void decompressBC7(const unsigned char* source, int width, int height, unsigned char* destination);
+
+    float getPSNR(const unsigned char* a, const unsigned char* b, size_t size);
+}
@@ -0,0 +1,93 @@
+#include "camera_path.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace minecraft::system {
+
+    namespace {
+        constexpr std::string_view CAMERA_PATH_HEADER = "camera-path";
+        constexpr int CAMERA_PATH_VERSION = 1;
+    }
+
+    CameraPath::CameraPath(const float tickRate)
+        : m_tickRate(tickRate) {}
+
+    bool CameraPath::load(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        if (!file) {
+            std::cerr << "Failed to open camera path: " << path << std::endl;
+            return false;
+        }
+
+        std::string header;
+        int version = 0;
+        float tickRate = 0.0f;
+
+        if (!(file >> header >> version >> tickRate) || header != CAMERA_PATH_HEADER || version != CAMERA_PATH_VERSION || tickRate <= 0.0f) {
+            std::cerr << "Not a camera path: " << path << std::endl;
+            return false;
+        }
+
+        std::vector<CameraPose> poses;
+        CameraPose pose{};
+
+        while (file >> pose.position.x >> pose.position.y >> pose.position.z >> pose.yaw >> pose.pitch) {
+            poses.push_back(pose);
+        }
+
+        if (!file.eof()) {
+            std::cerr << "Malformed camera path at tick " << poses.size() << ": " << path << std::endl;
+            return false;
+        }
+
+        m_tickRate = tickRate;
+        m_poses = std::move(poses);
+
+        return true;
+    }
+
+    bool CameraPath::save(const std::filesystem::path& path) const {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file) {
+            std::cerr << "Failed to write camera path: " << path << std::endl;
+            return false;
+        }
+
+        // Enough digits that a replay reproduces the recorded floats exactly
+        file << CAMERA_PATH_HEADER << ' ' << CAMERA_PATH_VERSION << ' ' << m_tickRate << '\n'
+             << std::setprecision(std::numeric_limits<float>::max_digits10);
+
+        for (const auto& [position, yaw, pitch] : m_poses) {
+            file << position.x << ' ' << position.y << ' ' << position.z << ' ' << yaw << ' ' << pitch << '\n';
+        }
+
+        return static_cast<bool>(file);
+    }
+
+    void CameraPath::append(const CameraPose& pose) {
+        m_poses.push_back(pose);
+    }
+
+    void CameraPath::clear() {
+        m_poses.clear();
+    }
+
+    const CameraPose& CameraPath::getPose(const size_t tick) const {
+        return m_poses[tick];
+    }
+
+    size_t CameraPath::getTickCount() const {
+        return m_poses.size();
+    }
+
+    float CameraPath::getTickRate() const {
+        return m_tickRate;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <glm.hpp>
+#include <filesystem>
+#include <vector>
+
+namespace minecraft::system {
+    constexpr float DEFAULT_CAMERA_PATH_TICK_RATE = 60.0f;
+
+    struct CameraPose {
+        glm::vec3 position;
+        float yaw;
+        float pitch;
+    };
+
+    // One camera pose per fixed tick. Stored as text, a header line followed by
+    // "x y z yaw pitch" per tick, so recordings can be diffed and trimmed by hand
+    class CameraPath {
+    public:
+        explicit CameraPath(float tickRate = DEFAULT_CAMERA_PATH_TICK_RATE);
+
+        bool load(const std::filesystem::path& path);
+        bool save(const std::filesystem::path& path) const;
+
+        void append(const CameraPose& pose);
+        void clear();
+
+        [[nodiscard]]
+        const CameraPose& getPose(size_t tick) const;
+        [[nodiscard]]
+        size_t getTickCount() const;
+        [[nodiscard]]
+        float getTickRate() const;
+
+    private:
+        float m_tickRate;
+        std::vector<CameraPose> m_poses{};
+    };
+}
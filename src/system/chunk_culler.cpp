@@ -0,0 +1,191 @@
+#include "chunk_culler.hpp"
+#include "packed_face.hpp"
+
+#include <gtc/matrix_access.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace minecraft::system {
+
+    Frustum Frustum::fromMatrix(const glm::mat4& viewProj) {
+        const glm::vec4 rowX = glm::row(viewProj, 0);
+        const glm::vec4 rowY = glm::row(viewProj, 1);
+        const glm::vec4 rowZ = glm::row(viewProj, 2);
+        const glm::vec4 rowW = glm::row(viewProj, 3);
+
+        Frustum frustum{};
+        frustum.planes[0] = rowW + rowX;  // left
+        frustum.planes[1] = rowW - rowX;  // right
+        frustum.planes[2] = rowW + rowY;  // bottom
+        frustum.planes[3] = rowW - rowY;  // top
+        frustum.planes[4] = rowW + rowZ;  // near
+        frustum.planes[5] = rowW - rowZ;  // far
+
+        return frustum;
+    }
+
+    bool Frustum::intersects(const glm::vec3 aabbMin, const glm::vec3 aabbMax) const {
+        for (const auto& plane : planes) {
+            const glm::vec3 positive(
+                plane.x >= 0.0f ? aabbMax.x : aabbMin.x,
+                plane.y >= 0.0f ? aabbMax.y : aabbMin.y,
+                plane.z >= 0.0f ? aabbMax.z : aabbMin.z
+            );
+
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void HiZPyramid::build(const std::vector<float>& depth, const int width, const int height) {
+        m_levels.clear();
+        m_sizes.clear();
+
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+
+        m_levels.push_back(depth);
+        m_sizes.emplace_back(width, height);
+
+        while (m_sizes.back().x > 1 || m_sizes.back().y > 1) {
+            const glm::ivec2 sourceSize = m_sizes.back();
+            const glm::ivec2 size = glm::max(sourceSize / 2, glm::ivec2(1));
+            const int lastLevel = static_cast<int>(m_levels.size()) - 1;
+
+            std::vector<float> level(size.x * size.y);
+
+            for (int y = 0; y < size.y; y++) {
+                for (int x = 0; x < size.x; x++) {
+                    // Odd source sizes fold the trailing row/column into the last texel
+                    const int endX = x == size.x - 1 ? sourceSize.x : x * 2 + 2;
+                    const int endY = y == size.y - 1 ? sourceSize.y : y * 2 + 2;
+
+                    float maxDepth = 0.0f;
+                    for (int sy = y * 2; sy < endY; sy++) {
+                        for (int sx = x * 2; sx < endX; sx++) {
+                            maxDepth = std::max(maxDepth, fetch(lastLevel, glm::ivec2(sx, sy)));
+                        }
+                    }
+
+                    level[y * size.x + x] = maxDepth;
+                }
+            }
+
+            m_levels.push_back(std::move(level));
+            m_sizes.push_back(size);
+        }
+    }
+
+    bool HiZPyramid::empty() const {
+        return m_levels.empty();
+    }
+
+    int HiZPyramid::getLevelCount() const {
+        return static_cast<int>(m_levels.size());
+    }
+
+    glm::ivec2 HiZPyramid::getLevelSize(const int level) const {
+        return m_sizes[level];
+    }
+
+    float HiZPyramid::fetch(const int level, const glm::ivec2 texel) const {
+        const glm::ivec2 size = m_sizes[level];
+        const glm::ivec2 clamped = glm::clamp(texel, glm::ivec2(0), size - 1);
+        return m_levels[level][clamped.y * size.x + clamped.x];
+    }
+
+    unsigned int ChunkCuller::cull(
+        const std::vector<primitive::ChunkDrawRecord>& records,
+        const glm::mat4& viewProj,
+        const HiZPyramid* hiz,
+        std::vector<primitive::DrawElementsIndirectCommand>& commands
+    ) const {
+
+        const Frustum frustum = Frustum::fromMatrix(viewProj);
+        commands.clear();
+
+        for (unsigned int i = 0; i < records.size(); i++) {
+            const auto& record = records[i];
+            const auto aabbMin = glm::vec3(record.aabbMin);
+            const auto aabbMax = glm::vec3(record.aabbMax);
+
+            if (record.faceCount == 0 || !frustum.intersects(aabbMin, aabbMax)) {
+                continue;
+            }
+
+            if (hiz && !hiz->empty() && occluded(*hiz, viewProj, aabbMin, aabbMax)) {
+                continue;
+            }
+
+            commands.push_back(makeCommand(record, i));
+        }
+
+        return static_cast<unsigned int>(commands.size());
+    }
+
+    bool ChunkCuller::occluded(
+        const HiZPyramid& hiz, const glm::mat4& viewProj,
+        const glm::vec3 aabbMin, const glm::vec3 aabbMax
+    ) {
+        glm::vec2 uvMin(1.0f);
+        glm::vec2 uvMax(0.0f);
+        float nearestDepth = 1.0f;
+
+        for (int i = 0; i < 8; i++) {
+            const glm::vec3 corner(
+                i & 1 ? aabbMax.x : aabbMin.x,
+                i & 2 ? aabbMax.y : aabbMin.y,
+                i & 4 ? aabbMax.z : aabbMin.z
+            );
+
+            const glm::vec4 clip = viewProj * glm::vec4(corner, 1.0f);
+            if (clip.w <= 0.0f) {
+                return false;
+            }
+
+            const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            const glm::vec2 uv = glm::vec2(ndc) * 0.5f + 0.5f;
+
+            uvMin = glm::min(uvMin, uv);
+            uvMax = glm::max(uvMax, uv);
+            nearestDepth = std::min(nearestDepth, ndc.z * 0.5f + 0.5f);
+        }
+
+        uvMin = glm::clamp(uvMin, glm::vec2(0.0f), glm::vec2(1.0f));
+        uvMax = glm::clamp(uvMax, glm::vec2(0.0f), glm::vec2(1.0f));
+
+        const glm::vec2 baseSize = hiz.getLevelSize(0);
+        const glm::vec2 extent = (uvMax - uvMin) * baseSize;
+        const float footprint = std::max(std::max(extent.x, extent.y), 1.0f);
+        const int level = std::clamp(
+            static_cast<int>(std::ceil(std::log2(footprint))), 0, hiz.getLevelCount() - 1
+        );
+
+        const glm::vec2 levelSize = hiz.getLevelSize(level);
+        const glm::ivec2 texelMin = glm::ivec2(uvMin * levelSize);
+        const glm::ivec2 texelMax = glm::ivec2(uvMax * levelSize);
+
+        const float maxDepth = std::max(
+            std::max(hiz.fetch(level, texelMin), hiz.fetch(level, glm::ivec2(texelMax.x, texelMin.y))),
+            std::max(hiz.fetch(level, glm::ivec2(texelMin.x, texelMax.y)), hiz.fetch(level, texelMax))
+        );
+
+        return nearestDepth > maxDepth;
+    }
+
+    primitive::DrawElementsIndirectCommand ChunkCuller::makeCommand(
+        const primitive::ChunkDrawRecord& record, const unsigned int recordIndex
+    ) {
+        return primitive::DrawElementsIndirectCommand {
+            record.faceCount * primitive::INDICES_PER_FACE,
+            1,
+            0,
+            static_cast<int>(record.firstFace * primitive::CORNERS_PER_FACE),
+            recordIndex,
+        };
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "draw_command.hpp"
+#include <glm.hpp>
+#include <vector>
+
+namespace minecraft::system {
+
+    struct Frustum {
+        glm::vec4 planes[6];
+
+        static Frustum fromMatrix(const glm::mat4& viewProj);
+
+        [[nodiscard]]
+        bool intersects(glm::vec3 aabbMin, glm::vec3 aabbMax) const;
+    };
+
+    // Max-depth pyramid of the previous frame, level 0 is the full resolution depth buffer
+    class HiZPyramid {
+    public:
+        void build(const std::vector<float>& depth, int width, int height);
+
+        [[nodiscard]]
+        bool empty() const;
+        [[nodiscard]]
+        int getLevelCount() const;
+        [[nodiscard]]
+        glm::ivec2 getLevelSize(int level) const;
+        [[nodiscard]]
+        float fetch(int level, glm::ivec2 texel) const;
+
+    private:
+        std::vector<std::vector<float>> m_levels{};
+        std::vector<glm::ivec2> m_sizes{};
+    };
+
+    // CPU reference of chunk_cull_compute.glsl, emits commands in record order
+    class ChunkCuller {
+    public:
+        unsigned int cull(
+            const std::vector<primitive::ChunkDrawRecord>& records,
+            const glm::mat4& viewProj,
+            const HiZPyramid* hiz,
+            std::vector<primitive::DrawElementsIndirectCommand>& commands
+        ) const;
+
+        [[nodiscard]]
+        static bool occluded(const HiZPyramid& hiz, const glm::mat4& viewProj, glm::vec3 aabbMin, glm::vec3 aabbMax);
+        [[nodiscard]]
+        static primitive::DrawElementsIndirectCommand makeCommand(const primitive::ChunkDrawRecord& record, unsigned int recordIndex);
+    };
+}
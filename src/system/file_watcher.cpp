@@ -0,0 +1,169 @@
+#include "file_watcher.hpp"
+
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace minecraft::system {
+
+    FileWatcher::FileWatcher(const std::chrono::milliseconds debounce)
+        : m_debounce(debounce) {
+#ifdef __linux__
+        m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotify < 0) {
+            std::cerr << "inotify unavailable, falling back to scanning for file changes" << std::endl;
+        }
+#endif
+    }
+
+    FileWatcher::~FileWatcher() {
+#ifdef __linux__
+        if (m_inotify >= 0) {
+            close(m_inotify);
+        }
+#endif
+    }
+
+    bool FileWatcher::watch(const std::filesystem::path& directory) {
+        std::error_code error;
+        const auto canonical = std::filesystem::canonical(directory, error);
+
+        if (error || !std::filesystem::is_directory(canonical)) {
+            std::cerr << "Cannot watch " << directory << ": not a directory" << std::endl;
+            return false;
+        }
+
+        m_directories.push_back(canonical);
+
+#ifdef __linux__
+        if (m_inotify >= 0) {
+            return addWatch(canonical);
+        }
+#endif
+
+        // Baseline for the scanning fallback, so existing files don't all report as changed
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(canonical, error)) {
+            if (entry.is_regular_file(error)) {
+                m_writeTimes[entry.path().string()] = entry.last_write_time(error);
+            }
+        }
+
+        return true;
+    }
+
+    std::vector<std::filesystem::path> FileWatcher::poll(const Clock::time_point now) {
+        readEvents(now);
+
+        std::vector<std::filesystem::path> changed;
+
+        for (auto it = m_pending.begin(); it != m_pending.end();) {
+            if (now - it->second >= m_debounce) {
+                changed.emplace_back(it->first);
+                it = m_pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        return changed;
+    }
+
+    void FileWatcher::notify(const std::filesystem::path& path, const Clock::time_point now) {
+        // Every event restarts the quiet period
+        m_pending[std::filesystem::weakly_canonical(path).string()] = now;
+    }
+
+#ifdef __linux__
+    bool FileWatcher::addWatch(const std::filesystem::path& directory) {
+        constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MODIFY;
+
+        const int watch = inotify_add_watch(m_inotify, directory.c_str(), mask);
+        if (watch < 0) {
+            std::cerr << "Failed to watch " << directory << std::endl;
+            return false;
+        }
+
+        m_watches[watch] = directory;
+
+        // inotify isn't recursive, so every subdirectory gets its own watch
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            if (entry.is_directory(error)) {
+                addWatch(entry.path());
+            }
+        }
+
+        return true;
+    }
+
+    void FileWatcher::readEvents(const Clock::time_point now) {
+        if (m_inotify < 0) {
+            scanDirectories(now);
+            return;
+        }
+
+        alignas(inotify_event) char buffer[4096];
+
+        while (true) {
+            const ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break;
+            }
+
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                const auto directory = m_watches.find(event->wd);
+                if (directory == m_watches.end() || event->len == 0) {
+                    continue;
+                }
+
+                const auto path = directory->second / event->name;
+
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        addWatch(path);
+                    }
+
+                    continue;
+                }
+
+                notify(path, now);
+            }
+        }
+    }
+#else
+    void FileWatcher::readEvents(const Clock::time_point now) {
+        scanDirectories(now);
+    }
+#endif
+
+    void FileWatcher::scanDirectories(const Clock::time_point now) {
+        if (now - m_lastScan < WATCH_SCAN_INTERVAL) {
+            return;
+        }
+
+        m_lastScan = now;
+        std::error_code error;
+
+        for (const auto& directory : m_directories) {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+                if (!entry.is_regular_file(error)) {
+                    continue;
+                }
+
+                const auto writeTime = entry.last_write_time(error);
+                auto& known = m_writeTimes[entry.path().string()];
+
+                if (known != writeTime) {
+                    known = writeTime;
+                    notify(entry.path(), now);
+                }
+            }
+        }
+    }
+}
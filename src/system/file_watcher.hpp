@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace minecraft::system {
+    constexpr std::chrono::milliseconds DEFAULT_WATCH_DEBOUNCE{100};
+    constexpr std::chrono::milliseconds WATCH_SCAN_INTERVAL{250};
+
+    // Reports files under the watched directories once they've stopped changing for the debounce interval,
+    // so an editor's truncate + write + rename shows up as one change. Uses inotify on Linux and
+    // falls back to scanning modification times elsewhere
+    class FileWatcher {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit FileWatcher(std::chrono::milliseconds debounce = DEFAULT_WATCH_DEBOUNCE);
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        bool watch(const std::filesystem::path& directory);
+        std::vector<std::filesystem::path> poll(Clock::time_point now = Clock::now());
+
+        // Records a change as if the backend had seen it
+        void notify(const std::filesystem::path& path, Clock::time_point now);
+
+    private:
+        void readEvents(Clock::time_point now);
+        void scanDirectories(Clock::time_point now);
+
+        std::chrono::milliseconds m_debounce;
+        std::unordered_map<std::string, Clock::time_point> m_pending{};
+        std::vector<std::filesystem::path> m_directories{};
+
+#ifdef __linux__
+        bool addWatch(const std::filesystem::path& directory);
+
+        int m_inotify{-1};
+        std::unordered_map<int, std::filesystem::path> m_watches{};
+#endif
+
+        std::unordered_map<std::string, std::filesystem::file_time_type> m_writeTimes{};
+        Clock::time_point m_lastScan{};
+    };
+}
@@ -0,0 +1,151 @@
+#include "frame_stats.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace minecraft::system {
+
+    std::string_view getPhaseName(const FramePhase phase) {
+        switch (phase) {
+            case FramePhase::INPUT:     return "input";
+            case FramePhase::UPDATE:    return "update";
+            case FramePhase::UPLOAD:    return "upload";
+            case FramePhase::DRAW:      return "draw";
+            case FramePhase::SWAP:      return "swap";
+            default:                    return "unknown";
+        }
+    }
+
+    FrameStats::FrameStats(const double hitchMilliseconds)
+        : m_hitchMilliseconds(hitchMilliseconds) {}
+
+    void FrameStats::beginFrame(const Clock::time_point now) {
+        m_current = FrameRecord { m_frameCount, 0.0, {}, false };
+        m_frameStart = now;
+        m_phase = -1;
+    }
+
+    void FrameStats::beginPhase(const FramePhase phase, const Clock::time_point now) {
+        closePhase(now);
+
+        m_phase = static_cast<int>(phase);
+        m_phaseStart = now;
+    }
+
+    void FrameStats::closePhase(const Clock::time_point now) {
+        if (m_phase < 0) {
+            return;
+        }
+
+        // Phases can be entered more than once a frame, their times add up
+        m_current.phaseMilliseconds[m_phase] += std::chrono::duration<double, std::milli>(now - m_phaseStart).count();
+        m_phase = -1;
+    }
+
+    bool FrameStats::endFrame(const Clock::time_point now) {
+        closePhase(now);
+
+        m_current.totalMilliseconds = std::chrono::duration<double, std::milli>(now - m_frameStart).count();
+        m_current.hitch = m_current.totalMilliseconds > m_hitchMilliseconds;
+
+        if (m_current.hitch) {
+            m_hitchCount++;
+
+            const auto worst = std::ranges::max_element(m_current.phaseMilliseconds);
+            const auto phase = static_cast<FramePhase>(worst - m_current.phaseMilliseconds.begin());
+
+            std::ostringstream line;
+            line << "Frame " << m_current.index << " hitched: " << std::fixed << std::setprecision(2)
+                 << m_current.totalMilliseconds << "ms, " << getPhaseName(phase) << " took " << *worst << "ms";
+            std::cout << line.str() << std::endl;
+        }
+
+        m_frames[m_frameCount % FRAME_STATS_CAPACITY] = m_current;
+        m_frameCount++;
+
+        return m_current.hitch;
+    }
+
+    std::vector<FrameRecord> FrameStats::getFrames() const {
+        const uint64_t count = std::min<uint64_t>(m_frameCount, FRAME_STATS_CAPACITY);
+        std::vector<FrameRecord> frames;
+        frames.reserve(count);
+
+        for (uint64_t i = m_frameCount - count; i < m_frameCount; i++) {
+            frames.push_back(m_frames[i % FRAME_STATS_CAPACITY]);
+        }
+
+        return frames;
+    }
+
+    uint64_t FrameStats::getHitchCount() const {
+        return m_hitchCount;
+    }
+
+    void FrameStats::printSummary() const {
+        const auto frames = getFrames();
+        if (frames.empty()) {
+            return;
+        }
+
+        double total = 0.0, slowest = 0.0;
+        std::array<double, FRAME_PHASE_COUNT> phases{};
+        size_t hitches = 0;
+
+        for (const auto& frame : frames) {
+            total += frame.totalMilliseconds;
+            slowest = std::max(slowest, frame.totalMilliseconds);
+            hitches += frame.hitch;
+
+            for (size_t i = 0; i < FRAME_PHASE_COUNT; i++) {
+                phases[i] += frame.phaseMilliseconds[i];
+            }
+        }
+
+        const auto count = static_cast<double>(frames.size());
+
+        std::ostringstream summary;
+        summary << std::fixed << std::setprecision(3) << "Last " << frames.size() << " frames: avg " << total / count
+                << "ms, max " << slowest << "ms, " << hitches << " hitches (" << m_hitchCount << " total)\n";
+
+        for (size_t i = 0; i < FRAME_PHASE_COUNT; i++) {
+            summary << "  " << std::left << std::setw(8) << getPhaseName(static_cast<FramePhase>(i)) << std::right
+                    << " avg " << phases[i] / count << "ms\n";
+        }
+
+        std::cout << summary.str() << std::flush;
+    }
+
+    bool FrameStats::dump(const std::filesystem::path& path) const {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file) {
+            std::cerr << "Failed to write frame stats: " << path << std::endl;
+            return false;
+        }
+
+        file << "frame,total";
+        for (size_t i = 0; i < FRAME_PHASE_COUNT; i++) {
+            file << ',' << getPhaseName(static_cast<FramePhase>(i));
+        }
+        file << ",hitch\n" << std::fixed << std::setprecision(4);
+
+        for (const auto& [index, totalMilliseconds, phaseMilliseconds, hitch] : getFrames()) {
+            file << index << ',' << totalMilliseconds;
+
+            for (const double milliseconds : phaseMilliseconds) {
+                file << ',' << milliseconds;
+            }
+
+            file << ',' << hitch << '\n';
+        }
+
+        std::cout << "Wrote frame stats to " << path << std::endl;
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace minecraft::system {
+    constexpr size_t FRAME_STATS_CAPACITY = 600;
+    constexpr double DEFAULT_HITCH_MILLISECONDS = 33.3;
+
+    const std::filesystem::path FRAME_STATS_DUMP_PATH = std::filesystem::path(PROJECT_SOURCE_DIR) / "cache" / "frames.csv";
+
+    enum class FramePhase {
+        INPUT,
+        UPDATE,
+        UPLOAD,
+        DRAW,
+        SWAP,
+        COUNT,
+    };
+
+    constexpr size_t FRAME_PHASE_COUNT = static_cast<size_t>(FramePhase::COUNT);
+
+    std::string_view getPhaseName(FramePhase phase);
+
+    struct FrameRecord {
+        uint64_t index;
+        double totalMilliseconds;
+        std::array<double, FRAME_PHASE_COUNT> phaseMilliseconds;
+        bool hitch;
+    };
+
+    // Per-frame CPU times for the last FRAME_STATS_CAPACITY frames. Phases run back to back,
+    // beginning one ends the previous, and a frame over the hitch threshold is logged with
+    // the phase that took longest
+    class FrameStats {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit FrameStats(double hitchMilliseconds = DEFAULT_HITCH_MILLISECONDS);
+
+        void beginFrame(Clock::time_point now = Clock::now());
+        void beginPhase(FramePhase phase, Clock::time_point now = Clock::now());
+        // Returns true when the frame was a hitch
+        bool endFrame(Clock::time_point now = Clock::now());
+
+        // Oldest first
+        [[nodiscard]]
+        std::vector<FrameRecord> getFrames() const;
+        [[nodiscard]]
+        uint64_t getHitchCount() const;
+
+        void printSummary() const;
+        bool dump(const std::filesystem::path& path) const;
+
+    private:
+        void closePhase(Clock::time_point now);
+
+        double m_hitchMilliseconds;
+
+        std::array<FrameRecord, FRAME_STATS_CAPACITY> m_frames{};
+        uint64_t m_frameCount{};
+        uint64_t m_hitchCount{};
+
+        FrameRecord m_current{};
+        Clock::time_point m_frameStart{};
+        Clock::time_point m_phaseStart{};
+        int m_phase{-1};
+    };
+}
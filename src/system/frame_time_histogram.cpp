@@ -0,0 +1,83 @@
+#include "frame_time_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace minecraft::system {
+
+    void FrameTimeHistogram::addFrame(const double milliseconds) {
+        m_frameTimes.push_back(milliseconds);
+    }
+
+    void FrameTimeHistogram::clear() {
+        m_frameTimes.clear();
+    }
+
+    double FrameTimeHistogram::getPercentile(const double percentile) const {
+        if (m_frameTimes.empty()) {
+            return 0.0;
+        }
+
+        // Nearest rank, so p100 is the slowest frame and small runs never interpolate past a real sample
+        std::vector<double> sorted = m_frameTimes;
+        const auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+        const size_t index = std::clamp<size_t>(rank, 1, sorted.size()) - 1;
+
+        std::ranges::nth_element(sorted, sorted.begin() + static_cast<std::ptrdiff_t>(index));
+        return sorted[index];
+    }
+
+    FrameTimeSummary FrameTimeHistogram::getSummary() const {
+        double total = 0.0;
+        for (const double frameTime : m_frameTimes) {
+            total += frameTime;
+        }
+
+        return FrameTimeSummary {
+            m_frameTimes.size(),
+            m_frameTimes.empty() ? 0.0 : total / static_cast<double>(m_frameTimes.size()),
+            getPercentile(50.0),
+            getPercentile(95.0),
+            getPercentile(99.0),
+            getPercentile(100.0),
+        };
+    }
+
+    bool FrameTimeHistogram::writeJson(const std::filesystem::path& path) const {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file) {
+            std::cerr << "Failed to write frame time histogram: " << path << std::endl;
+            return false;
+        }
+
+        std::vector<size_t> buckets(FRAME_HISTOGRAM_BUCKETS);
+        for (const double frameTime : m_frameTimes) {
+            const auto bucket = static_cast<size_t>(std::max(frameTime, 0.0) / FRAME_HISTOGRAM_BUCKET_MILLISECONDS);
+            buckets[std::min(bucket, FRAME_HISTOGRAM_BUCKETS - 1)]++;
+        }
+
+        const auto [frames, mean, p50, p95, p99, max] = getSummary();
+
+        file << "{\n"
+             << "  \"frames\": " << frames << ",\n"
+             << "  \"meanMs\": " << mean << ",\n"
+             << "  \"p50Ms\": " << p50 << ",\n"
+             << "  \"p95Ms\": " << p95 << ",\n"
+             << "  \"p99Ms\": " << p99 << ",\n"
+             << "  \"maxMs\": " << max << ",\n"
+             << "  \"bucketMs\": " << FRAME_HISTOGRAM_BUCKET_MILLISECONDS << ",\n"
+             << "  \"buckets\": [";
+
+        for (size_t i = 0; i < buckets.size(); i++) {
+            file << (i == 0 ? "" : ", ") << buckets[i];
+        }
+
+        file << "]\n}\n";
+        return static_cast<bool>(file);
+    }
+}
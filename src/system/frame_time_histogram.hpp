@@ -0,0 +1,36 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+namespace minecraft::system {
+    constexpr double FRAME_HISTOGRAM_BUCKET_MILLISECONDS = 1.0;
+    constexpr size_t FRAME_HISTOGRAM_BUCKETS = 100;
+
+    struct FrameTimeSummary {
+        size_t frames;
+        double meanMilliseconds;
+        double p50Milliseconds;
+        double p95Milliseconds;
+        double p99Milliseconds;
+        double maxMilliseconds;
+    };
+
+    // Every frame time of a benchmark run, reduced to percentiles and a fixed bucket histogram on export
+    class FrameTimeHistogram {
+    public:
+        void addFrame(double milliseconds);
+        void clear();
+
+        [[nodiscard]]
+        FrameTimeSummary getSummary() const;
+        [[nodiscard]]
+        double getPercentile(double percentile) const;
+
+        // Buckets are FRAME_HISTOGRAM_BUCKET_MILLISECONDS wide, the last one collects everything slower
+        bool writeJson(const std::filesystem::path& path) const;
+
+    private:
+        std::vector<double> m_frameTimes{};
+    };
+}
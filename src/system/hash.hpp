@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace minecraft::system {
+
+    // 64-bit FNV-1a, used for cache keys, not for anything security related
+    constexpr uint64_t HASH_OFFSET_BASIS = 0xcbf29ce484222325ull;
+    constexpr uint64_t HASH_PRIME = 0x100000001b3ull;
+
+    inline uint64_t hashBytes(const void* data, const size_t size, uint64_t hash = HASH_OFFSET_BASIS) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * HASH_PRIME;
+        }
+
+        return hash;
+    }
+
+    constexpr uint64_t hashString(const std::string_view string, uint64_t hash = HASH_OFFSET_BASIS) {
+        for (const char c : string) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * HASH_PRIME;
+        }
+
+        // Terminate so that "ab" + "c" and "a" + "bc" hash differently
+        return (hash ^ 0xffu) * HASH_PRIME;
+    }
+
+    template <typename T>
+    uint64_t hashValue(const T& value, const uint64_t hash = HASH_OFFSET_BASIS) {
+        return hashBytes(&value, sizeof(T), hash);
+    }
+}
@@ -0,0 +1,68 @@
+#include "linear_arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace minecraft::system {
+
+    LinearArena::LinearArena(const MemoryTag tag, const size_t capacity)
+        : m_memory(tag) {
+
+        if (capacity > 0) {
+            addBlock(capacity);
+        }
+    }
+
+    void* LinearArena::allocateBytes(const size_t bytes, const size_t alignment) {
+        if (!m_blocks.empty()) {
+            Block& block = m_blocks.back();
+
+            const auto address = reinterpret_cast<uintptr_t>(block.data.get());
+            const size_t offset = ((address + m_offset + alignment - 1) & ~(alignment - 1)) - address;
+
+            if (offset + bytes <= block.size) {
+                m_used += offset + bytes - m_offset;
+                m_offset = offset + bytes;
+                return block.data.get() + offset;
+            }
+        }
+
+        // Doubling keeps the number of overflow blocks logarithmic on the first pass
+        addBlock(std::max(bytes + alignment, m_capacity));
+        return allocateBytes(bytes, alignment);
+    }
+
+    void LinearArena::addBlock(const size_t size) {
+        m_blocks.push_back(Block { std::make_unique_for_overwrite<std::byte[]>(size), size });
+        m_offset = 0;
+        m_capacity += size;
+        m_blockAllocations++;
+
+        m_memory.set(m_capacity);
+    }
+
+    void LinearArena::reset() {
+        if (m_blocks.size() > 1) {
+            const size_t capacity = m_capacity;
+
+            m_blocks.clear();
+            m_capacity = 0;
+            addBlock(capacity);
+        }
+
+        m_offset = 0;
+        m_used = 0;
+    }
+
+    size_t LinearArena::getUsed() const {
+        return m_used;
+    }
+
+    size_t LinearArena::getCapacity() const {
+        return m_capacity;
+    }
+
+    uint64_t LinearArena::getBlockAllocations() const {
+        return m_blockAllocations;
+    }
+}
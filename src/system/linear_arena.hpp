@@ -0,0 +1,56 @@
+#pragma once
+
+#include "memory_tracker.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace minecraft::system {
+
+    // Bump allocator for scratch data that dies together. reset() folds any overflow blocks into one
+    // block big enough for everything, so a workload that repeats stops touching the heap after the first pass
+    class LinearArena {
+    public:
+        explicit LinearArena(MemoryTag tag, size_t capacity = 0);
+
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+
+        // Uninitialised storage, only valid until the next reset()
+        template <typename T>
+        std::span<T> allocate(const size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "Arena memory is released without running destructors");
+            return { static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T))), count };
+        }
+
+        void reset();
+
+        [[nodiscard]]
+        size_t getUsed() const;
+        [[nodiscard]]
+        size_t getCapacity() const;
+        // Heap blocks requested over the arena's lifetime
+        [[nodiscard]]
+        uint64_t getBlockAllocations() const;
+
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t size;
+        };
+
+        void* allocateBytes(size_t bytes, size_t alignment);
+        void addBlock(size_t size);
+
+        std::vector<Block> m_blocks{};
+        size_t m_offset{};
+        size_t m_used{};
+        size_t m_capacity{};
+        uint64_t m_blockAllocations{};
+
+        MemoryReservation m_memory;
+    };
+}
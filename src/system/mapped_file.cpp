@@ -0,0 +1,113 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace minecraft::system {
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+#ifdef _WIN32
+    bool MappedFile::open(const std::filesystem::path& path) {
+        close();
+
+        m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            m_file = nullptr;
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            close();
+            return false;
+        }
+
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping) {
+            close();
+            return false;
+        }
+
+        m_data = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_data) {
+            close();
+            return false;
+        }
+
+        m_size = static_cast<size_t>(size.QuadPart);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+
+        if (m_file) {
+            CloseHandle(m_file);
+        }
+
+        m_data = nullptr;
+        m_mapping = nullptr;
+        m_file = nullptr;
+        m_size = 0;
+    }
+#else
+    bool MappedFile::open(const std::filesystem::path& path) {
+        close();
+
+        const int file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            return false;
+        }
+
+        struct stat info{};
+        if (fstat(file, &info) != 0 || info.st_size == 0) {
+            ::close(file);
+            return false;
+        }
+
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        ::close(file);
+
+        if (data == MAP_FAILED) {
+            return false;
+        }
+
+        m_data = static_cast<const unsigned char*>(data);
+        m_size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (m_data) {
+            munmap(const_cast<unsigned char*>(m_data), m_size);
+        }
+
+        m_data = nullptr;
+        m_size = 0;
+    }
+#endif
+
+    const unsigned char* MappedFile::getData() const {
+        return m_data;
+    }
+
+    size_t MappedFile::getSize() const {
+        return m_size;
+    }
+}
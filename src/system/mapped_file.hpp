@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace minecraft::system {
+
+    // Read-only memory mapping of a whole file
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::filesystem::path& path);
+        void close();
+
+        [[nodiscard]]
+        const unsigned char* getData() const;
+        [[nodiscard]]
+        size_t getSize() const;
+
+    private:
+        const unsigned char* m_data{};
+        size_t m_size{};
+
+#ifdef _WIN32
+        void* m_file{};
+        void* m_mapping{};
+#endif
+    };
+}
@@ -0,0 +1,52 @@
+#include "memory_tracker.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace minecraft::system {
+
+    MemoryStats MemoryTracker::getStats(const MemoryTag tag) {
+        const MemoryCounters& counters = s_counters[static_cast<size_t>(tag)];
+
+        return MemoryStats {
+            counters.current.load(std::memory_order_relaxed),
+            counters.peak.load(std::memory_order_relaxed),
+            counters.allocations.load(std::memory_order_relaxed),
+            counters.frees.load(std::memory_order_relaxed),
+        };
+    }
+
+    std::string_view MemoryTracker::getTagName(const MemoryTag tag) {
+        switch (tag) {
+            case MemoryTag::BLOCKS:         return "blocks";
+            case MemoryTag::MESHES:         return "meshes";
+            case MemoryTag::TEXTURES:       return "textures";
+            case MemoryTag::GENERATION:     return "generation";
+            case MemoryTag::GPU_BUFFERS:    return "gpu buffers";
+            case MemoryTag::GPU_TEXTURES:   return "gpu textures";
+            case MemoryTag::ENTITIES:       return "entities";
+            default:                        return "unknown";
+        }
+    }
+
+    void MemoryTracker::printStats() {
+        constexpr double MEBIBYTE = 1024.0 * 1024.0;
+
+        std::ostringstream table;
+        table << std::left << std::setw(16) << "Memory" << std::right
+              << std::setw(14) << "Current MiB" << std::setw(12) << "Peak MiB" << std::setw(14) << "Allocations" << std::setw(10) << "Frees"
+              << "\n" << std::fixed << std::setprecision(2);
+
+        for (size_t i = 0; i < MEMORY_TAG_COUNT; i++) {
+            const auto tag = static_cast<MemoryTag>(i);
+            const auto [current, peak, allocations, frees] = getStats(tag);
+
+            table << std::left << std::setw(16) << getTagName(tag) << std::right
+                  << std::setw(14) << static_cast<double>(current) / MEBIBYTE << std::setw(12) << static_cast<double>(peak) / MEBIBYTE
+                  << std::setw(14) << allocations << std::setw(10) << frees << "\n";
+        }
+
+        std::cout << table.str() << std::flush;
+    }
+}
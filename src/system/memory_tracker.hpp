@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <vector>
+
+namespace minecraft::system {
+
+    enum class MemoryTag {
+        BLOCKS,
+        MESHES,
+        TEXTURES,
+        GENERATION,
+        GPU_BUFFERS,
+        GPU_TEXTURES,
+        ENTITIES,
+        COUNT,
+    };
+
+    constexpr size_t MEMORY_TAG_COUNT = static_cast<size_t>(MemoryTag::COUNT);
+
+    struct MemoryStats {
+        int64_t currentBytes;
+        int64_t peakBytes;
+        uint64_t allocations;
+        uint64_t frees;
+    };
+
+    struct MemoryCounters {
+        std::atomic<int64_t> current{};
+        std::atomic<int64_t> peak{};
+        std::atomic<uint64_t> allocations{};
+        std::atomic<uint64_t> frees{};
+    };
+
+    // Relaxed atomics only, cheap enough to leave on in release builds. GPU tags count what was
+    // handed to the driver, not what it actually reserved
+    class MemoryTracker {
+    public:
+        static void allocate(const MemoryTag tag, const size_t bytes) {
+            MemoryCounters& counters = s_counters[static_cast<size_t>(tag)];
+
+            const int64_t current = counters.current.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed)
+                                    + static_cast<int64_t>(bytes);
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+
+            int64_t peak = counters.peak.load(std::memory_order_relaxed);
+            while (current > peak && !counters.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+        }
+
+        static void free(const MemoryTag tag, const size_t bytes) {
+            MemoryCounters& counters = s_counters[static_cast<size_t>(tag)];
+
+            counters.current.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+            counters.frees.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static MemoryStats getStats(MemoryTag tag);
+        static std::string_view getTagName(MemoryTag tag);
+        static void printStats();
+
+    private:
+        static inline std::array<MemoryCounters, MEMORY_TAG_COUNT> s_counters{};
+    };
+
+    // Standard allocator that reports every allocation under Tag
+    template <typename T, MemoryTag Tag>
+    class TrackingAllocator {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind {
+            using other = TrackingAllocator<U, Tag>;
+        };
+
+        TrackingAllocator() = default;
+
+        template <typename U>
+        TrackingAllocator(const TrackingAllocator<U, Tag>&) {}
+
+        T* allocate(const size_t count) {
+            MemoryTracker::allocate(Tag, count * sizeof(T));
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+
+        void deallocate(T* pointer, const size_t count) {
+            MemoryTracker::free(Tag, count * sizeof(T));
+            ::operator delete(pointer);
+        }
+
+        template <typename U>
+        bool operator==(const TrackingAllocator<U, Tag>&) const {
+            return true;
+        }
+    };
+
+    template <typename T, MemoryTag Tag>
+    using TrackedVector = std::vector<T, TrackingAllocator<T, Tag>>;
+
+    // Bytes held outside of an allocator, like GL buffers or fixed arrays, kept in sync by set()
+    class MemoryReservation {
+    public:
+        explicit MemoryReservation(const MemoryTag tag, const size_t bytes = 0)
+            : m_tag(tag) {
+            set(bytes);
+        }
+
+        ~MemoryReservation() {
+            set(0);
+        }
+
+        // A copy accounts for a duplicate of the resource, so it reserves the same bytes again
+        MemoryReservation(const MemoryReservation& other)
+            : MemoryReservation(other.m_tag, other.m_bytes) {}
+
+        MemoryReservation& operator=(const MemoryReservation& other) {
+            if (this != &other) {
+                set(0);
+                m_tag = other.m_tag;
+                set(other.m_bytes);
+            }
+
+            return *this;
+        }
+
+        void set(const size_t bytes) {
+            if (m_bytes > 0) {
+                MemoryTracker::free(m_tag, m_bytes);
+            }
+
+            if (bytes > 0) {
+                MemoryTracker::allocate(m_tag, bytes);
+            }
+
+            m_bytes = bytes;
+        }
+
+        [[nodiscard]]
+        size_t get() const {
+            return m_bytes;
+        }
+
+    private:
+        MemoryTag m_tag;
+        size_t m_bytes{};
+    };
+}
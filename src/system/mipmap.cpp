@@ -0,0 +1,100 @@
+#include "mipmap.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MIPMAP_USE_SSE2
+#endif
+
+namespace minecraft::system {
+
+    namespace {
+        void downsampleRowScalar(
+            const unsigned char* top, const unsigned char* bottom,
+            const int sourceWidth, const int firstX, const int width, unsigned char* destination
+        ) {
+            for (int x = firstX; x < width; x++) {
+                const int left = std::min(x * 2, sourceWidth - 1) * 4;
+                const int right = std::min(x * 2 + 1, sourceWidth - 1) * 4;
+
+                for (int ch = 0; ch < 4; ch++) {
+                    const int sum = top[left + ch] + top[right + ch] + bottom[left + ch] + bottom[right + ch];
+                    destination[x * 4 + ch] = static_cast<unsigned char>((sum + 2) >> 2);
+                }
+            }
+        }
+    }
+
+    void downsampleRGBA(const unsigned char* source, const int sourceWidth, const int sourceHeight, unsigned char* destination) {
+        const int width = std::max(sourceWidth / 2, 1);
+        const int height = std::max(sourceHeight / 2, 1);
+
+        for (int y = 0; y < height; y++) {
+            const unsigned char* top = source + std::min(y * 2, sourceHeight - 1) * sourceWidth * 4;
+            const unsigned char* bottom = source + std::min(y * 2 + 1, sourceHeight - 1) * sourceWidth * 4;
+            unsigned char* row = destination + y * width * 4;
+
+            int x = 0;
+
+#ifdef MIPMAP_USE_SSE2
+            // Four source pixel pairs per iteration, summed in 16-bit lanes for exact rounding
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i rounding = _mm_set1_epi16(2);
+
+            for (; x + 4 <= width && x * 2 + 8 <= sourceWidth; x += 4) {
+                const __m128i topPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + x * 8));
+                const __m128i topPixelsNext = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + x * 8 + 16));
+                const __m128i bottomPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + x * 8));
+                const __m128i bottomPixelsNext = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + x * 8 + 16));
+
+                // Vertical sums, pixels p0..p3 and p4..p7 widened to 16-bit
+                const __m128i sumLow = _mm_add_epi16(_mm_unpacklo_epi8(topPixels, zero), _mm_unpacklo_epi8(bottomPixels, zero));
+                const __m128i sumHigh = _mm_add_epi16(_mm_unpackhi_epi8(topPixels, zero), _mm_unpackhi_epi8(bottomPixels, zero));
+                const __m128i sumNextLow = _mm_add_epi16(_mm_unpacklo_epi8(topPixelsNext, zero), _mm_unpacklo_epi8(bottomPixelsNext, zero));
+                const __m128i sumNextHigh = _mm_add_epi16(_mm_unpackhi_epi8(topPixelsNext, zero), _mm_unpackhi_epi8(bottomPixelsNext, zero));
+
+                // Each 128-bit sum holds two adjacent pixels, add its halves for the horizontal pair
+                const __m128i pair0 = _mm_add_epi16(sumLow, _mm_srli_si128(sumLow, 8));
+                const __m128i pair1 = _mm_add_epi16(sumHigh, _mm_srli_si128(sumHigh, 8));
+                const __m128i pair2 = _mm_add_epi16(sumNextLow, _mm_srli_si128(sumNextLow, 8));
+                const __m128i pair3 = _mm_add_epi16(sumNextHigh, _mm_srli_si128(sumNextHigh, 8));
+
+                const __m128i result01 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(pair0, pair1), rounding), 2);
+                const __m128i result23 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(pair2, pair3), rounding), 2);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x * 4), _mm_packus_epi16(result01, result23));
+            }
+#endif
+
+            downsampleRowScalar(top, bottom, sourceWidth, x, width, row);
+        }
+    }
+
+    std::vector<std::vector<unsigned char>> buildMipChain(const unsigned char* source, const int width, const int height) {
+        std::vector<std::vector<unsigned char>> levels{};
+        levels.emplace_back(source, source + width * height * 4);
+
+        int levelWidth = width;
+        int levelHeight = height;
+
+        while (levelWidth > 1 || levelHeight > 1) {
+            const int nextWidth = std::max(levelWidth / 2, 1);
+            const int nextHeight = std::max(levelHeight / 2, 1);
+
+            std::vector<unsigned char> level(nextWidth * nextHeight * 4);
+            downsampleRGBA(levels.back().data(), levelWidth, levelHeight, level.data());
+
+            levels.push_back(std::move(level));
+            levelWidth = nextWidth;
+            levelHeight = nextHeight;
+        }
+
+        return levels;
+    }
+
+    int getMipLevelCount(const int width, const int height) {
+        return std::bit_width(static_cast<unsigned int>(std::max(width, height)));
+    }
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <vector>
+
+namespace minecraft::system {
+
+    // 2x2 box filter of an RGBA8 image, odd trailing rows/columns are clamped
+    void downsampleRGBA(const unsigned char* source, int sourceWidth, int sourceHeight, unsigned char* destination);
+
+    // Full mip chain of an RGBA8 image down to 1x1, level 0 is a copy of the source
+    std::vector<std::vector<unsigned char>> buildMipChain(const unsigned char* source, int width, int height);
+
+    int getMipLevelCount(int width, int height);
+}
@@ -0,0 +1,134 @@
+#include "occlusion_culler.hpp"
+
+#include <chrono>
+
+namespace minecraft::system {
+
+    OcclusionCuller::~OcclusionCuller() {
+        if (!m_worker.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_running = false;
+        }
+
+        m_condition.notify_one();
+        m_worker.join();
+    }
+
+    void OcclusionCuller::setScene(
+        std::vector<primitive::BoundingBox> occluders,
+        std::vector<primitive::BoundingBox> occludees
+    ) {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [this] { return !m_hasJob; });
+
+        m_occluders = std::move(occluders);
+        m_occludees = std::move(occludees);
+        m_results.assign(m_occludees.size(), 0);
+        m_hasResult = false;
+
+        if (!m_worker.joinable()) {
+            m_worker = std::thread(&OcclusionCuller::workerLoop, this);
+        }
+    }
+
+    void OcclusionCuller::submit(const glm::mat4& viewProj) {
+        {
+            std::lock_guard lock(m_mutex);
+            takeResult();
+
+            // Skip this frame rather than stall when the worker is still busy
+            if (m_hasJob) {
+                return;
+            }
+
+            m_pendingViewProj = viewProj;
+            m_hasJob = true;
+        }
+
+        m_condition.notify_all();
+    }
+
+    void OcclusionCuller::finish() {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [this] { return !m_hasJob; });
+        takeResult();
+    }
+
+    void OcclusionCuller::takeResult() {
+        if (!m_hasResult) {
+            return;
+        }
+
+        std::swap(m_results, m_workerResults);
+        m_stats = m_workerStats;
+        m_hasResult = false;
+    }
+
+    bool OcclusionCuller::isOccluded(const unsigned int index) const {
+        return index < m_results.size() && m_results[index] != 0;
+    }
+
+    OcclusionStats OcclusionCuller::getStats() const {
+        return m_stats;
+    }
+
+    const std::vector<float>& OcclusionCuller::getDepth() const {
+        return m_rasterizer.getDepth();
+    }
+
+    void OcclusionCuller::workerLoop() {
+        while (true) {
+            glm::mat4 viewProj;
+
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_hasJob || !m_running; });
+
+                if (!m_running) {
+                    return;
+                }
+
+                viewProj = m_pendingViewProj;
+            }
+
+            process(viewProj);
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_hasJob = false;
+                m_hasResult = true;
+            }
+
+            m_condition.notify_all();
+        }
+    }
+
+    void OcclusionCuller::process(const glm::mat4& viewProj) {
+        const auto start = std::chrono::steady_clock::now();
+
+        m_rasterizer.setViewProjection(viewProj);
+        m_rasterizer.clear();
+
+        for (const auto& occluder : m_occluders) {
+            m_rasterizer.rasterizeBox(occluder);
+        }
+
+        m_workerResults.resize(m_occludees.size());
+        unsigned int occluded = 0;
+
+        for (size_t i = 0; i < m_occludees.size(); i++) {
+            m_workerResults[i] = !m_rasterizer.isBoxVisible(m_occludees[i]);
+            occluded += m_workerResults[i];
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+
+        m_workerStats.tested = static_cast<unsigned int>(m_occludees.size());
+        m_workerStats.occluded = occluded;
+        m_workerStats.microseconds = std::chrono::duration<float, std::micro>(end - start).count();
+    }
+}
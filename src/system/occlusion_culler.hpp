@@ -0,0 +1,66 @@
+#pragma once
+
+#include "occlusion_rasterizer.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace minecraft::system {
+
+    struct OcclusionStats {
+        unsigned int tested;
+        unsigned int occluded;
+        float microseconds;
+    };
+
+    // Rasterizes occluders and tests occludees on a worker thread.
+    // Results of a submitted frame become visible on the next submit, one frame behind the camera.
+    // The worker starts with the first scene, so a culler that's never given one costs no thread
+    class OcclusionCuller {
+    public:
+        OcclusionCuller() = default;
+        ~OcclusionCuller();
+
+        OcclusionCuller(const OcclusionCuller&) = delete;
+        OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+        void setScene(std::vector<primitive::BoundingBox> occluders, std::vector<primitive::BoundingBox> occludees);
+        void submit(const glm::mat4& viewProj);
+        // Waits for the submitted frame and makes its results visible now instead of on the next submit
+        void finish();
+
+        [[nodiscard]]
+        bool isOccluded(unsigned int index) const;
+        [[nodiscard]]
+        OcclusionStats getStats() const;
+        // Depth of the last processed frame, only stable between finish() and the next submit
+        [[nodiscard]]
+        const std::vector<float>& getDepth() const;
+
+    private:
+        void workerLoop();
+        void process(const glm::mat4& viewProj);
+        // Caller holds m_mutex
+        void takeResult();
+
+        OcclusionRasterizer m_rasterizer{};
+
+        std::vector<primitive::BoundingBox> m_occluders{};
+        std::vector<primitive::BoundingBox> m_occludees{};
+
+        std::vector<unsigned char> m_workerResults{};
+        std::vector<unsigned char> m_results{};
+        OcclusionStats m_workerStats{};
+        OcclusionStats m_stats{};
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+        glm::mat4 m_pendingViewProj{};
+        bool m_hasJob{};
+        bool m_hasResult{};
+        bool m_running{ true };
+
+        std::thread m_worker;
+    };
+}
@@ -0,0 +1,235 @@
+#include "occlusion_rasterizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define OCCLUSION_USE_SSE2
+#endif
+
+namespace minecraft::system {
+
+    static_assert(OCCLUSION_BUFFER_WIDTH % 4 == 0);
+
+    namespace {
+        struct EdgeFunction {
+            float a;
+            float b;
+            float c;
+
+            EdgeFunction(const glm::vec3 from, const glm::vec3 to)
+                : a(from.y - to.y), b(to.x - from.x), c(-(a * from.x + b * from.y)) {}
+        };
+
+        std::array<glm::vec3, 8> getBoxCorners(const primitive::BoundingBox& box) {
+            std::array<glm::vec3, 8> corners{};
+
+            for (int i = 0; i < 8; i++) {
+                corners[i] = glm::vec3(
+                    i & 1 ? box.max.x : box.min.x,
+                    i & 2 ? box.max.y : box.min.y,
+                    i & 4 ? box.max.z : box.min.z
+                );
+            }
+
+            return corners;
+        }
+
+        // Corner indices of the 12 box triangles, using the bit layout of getBoxCorners
+        constexpr int BOX_TRIANGLES[12][3] = {
+            { 0, 2, 3 }, { 0, 3, 1 },  // -z
+            { 4, 5, 7 }, { 4, 7, 6 },  // +z
+            { 0, 4, 6 }, { 0, 6, 2 },  // -x
+            { 1, 3, 7 }, { 1, 7, 5 },  // +x
+            { 0, 1, 5 }, { 0, 5, 4 },  // -y
+            { 2, 6, 7 }, { 2, 7, 3 },  // +y
+        };
+    }
+
+    OcclusionRasterizer::OcclusionRasterizer()
+        : m_depth(OCCLUSION_BUFFER_WIDTH * OCCLUSION_BUFFER_HEIGHT, 1.0f) {}
+
+    void OcclusionRasterizer::clear() {
+        std::ranges::fill(m_depth, 1.0f);
+    }
+
+    void OcclusionRasterizer::setViewProjection(const glm::mat4& viewProj) {
+        m_viewProj = viewProj;
+    }
+
+    void OcclusionRasterizer::rasterizeBox(const primitive::BoundingBox& box) {
+        const auto corners = getBoxCorners(box);
+        std::array<glm::vec3, 8> screen{};
+
+        for (int i = 0; i < 8; i++) {
+            // Partially clipped occluders are skipped, dropping an occluder is always conservative
+            if (!project(corners[i], screen[i])) {
+                return;
+            }
+        }
+
+        for (const auto& triangle : BOX_TRIANGLES) {
+            rasterizeTriangle(screen[triangle[0]], screen[triangle[1]], screen[triangle[2]]);
+        }
+    }
+
+    void OcclusionRasterizer::rasterizeTriangle(const glm::vec3 v0, glm::vec3 v1, glm::vec3 v2) {
+        const float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+        if (area == 0.0f) {
+            return;
+        }
+
+        if (area < 0.0f) {
+            std::swap(v1, v2);
+        }
+
+        const int minX = std::max(static_cast<int>(std::floor(std::min({ v0.x, v1.x, v2.x }))), 0) & ~3;
+        const int maxX = std::min(static_cast<int>(std::ceil(std::max({ v0.x, v1.x, v2.x }))), OCCLUSION_BUFFER_WIDTH - 1);
+        const int minY = std::max(static_cast<int>(std::floor(std::min({ v0.y, v1.y, v2.y }))), 0);
+        const int maxY = std::min(static_cast<int>(std::ceil(std::max({ v0.y, v1.y, v2.y }))), OCCLUSION_BUFFER_HEIGHT - 1);
+
+        if (minX > maxX || minY > maxY) {
+            return;
+        }
+
+        const float depth = std::max({ v0.z, v1.z, v2.z });
+        const EdgeFunction edges[3] = { { v0, v1 }, { v1, v2 }, { v2, v0 } };
+
+#ifdef OCCLUSION_USE_SSE2
+        const __m128 laneOffsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 triangleDepth = _mm_set1_ps(depth);
+
+        __m128 stepA[3];
+        for (int i = 0; i < 3; i++) {
+            stepA[i] = _mm_set1_ps(edges[i].a);
+        }
+
+        for (int y = minY; y <= maxY; y++) {
+            const float centerY = static_cast<float>(y) + 0.5f;
+            float* row = &m_depth[y * OCCLUSION_BUFFER_WIDTH];
+
+            __m128 rowValues[3];
+            for (int i = 0; i < 3; i++) {
+                rowValues[i] = _mm_set1_ps(edges[i].b * centerY + edges[i].c);
+            }
+
+            for (int x = minX; x <= maxX; x += 4) {
+                const __m128 centerX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+
+                __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepA[0], centerX), rowValues[0]), zero);
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepA[1], centerX), rowValues[1]), zero));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepA[2], centerX), rowValues[2]), zero));
+
+                if (_mm_movemask_ps(inside) == 0) {
+                    continue;
+                }
+
+                const __m128 current = _mm_loadu_ps(row + x);
+                const __m128 nearest = _mm_min_ps(current, triangleDepth);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+            }
+        }
+#else
+        for (int y = minY; y <= maxY; y++) {
+            const float centerY = static_cast<float>(y) + 0.5f;
+            float* row = &m_depth[y * OCCLUSION_BUFFER_WIDTH];
+
+            for (int x = minX; x <= maxX; x++) {
+                const float centerX = static_cast<float>(x) + 0.5f;
+
+                bool inside = true;
+                for (const auto& edge : edges) {
+                    inside &= edge.a * centerX + edge.b * centerY + edge.c >= 0.0f;
+                }
+
+                if (inside) {
+                    row[x] = std::min(row[x], depth);
+                }
+            }
+        }
+#endif
+    }
+
+    bool OcclusionRasterizer::isBoxVisible(const primitive::BoundingBox& box) const {
+        glm::vec3 screenMin(static_cast<float>(OCCLUSION_BUFFER_WIDTH), static_cast<float>(OCCLUSION_BUFFER_HEIGHT), 1.0f);
+        glm::vec3 screenMax(0.0f);
+
+        for (const auto& corner : getBoxCorners(box)) {
+            glm::vec3 screen;
+            if (!project(corner, screen)) {
+                return true;
+            }
+
+            screenMin = glm::min(screenMin, screen);
+            screenMax = glm::max(screenMax, screen);
+        }
+
+        const int minX = std::max(static_cast<int>(std::floor(screenMin.x)), 0);
+        const int maxX = std::min(static_cast<int>(std::ceil(screenMax.x)), OCCLUSION_BUFFER_WIDTH - 1);
+        const int minY = std::max(static_cast<int>(std::floor(screenMin.y)), 0);
+        const int maxY = std::min(static_cast<int>(std::ceil(screenMax.y)), OCCLUSION_BUFFER_HEIGHT - 1);
+
+        if (minX > maxX || minY > maxY || screenMin.z < 0.0f) {
+            return true;
+        }
+
+        const float nearestDepth = screenMin.z;
+
+#ifdef OCCLUSION_USE_SSE2
+        const __m128 boxDepth = _mm_set1_ps(nearestDepth);
+        const __m128i laneIndices = _mm_set_epi32(3, 2, 1, 0);
+        const __m128i firstLane = _mm_set1_epi32(minX - 1);
+        const __m128i lastLane = _mm_set1_epi32(maxX + 1);
+
+        for (int y = minY; y <= maxY; y++) {
+            const float* row = &m_depth[y * OCCLUSION_BUFFER_WIDTH];
+
+            for (int x = minX & ~3; x <= maxX; x += 4) {
+                const __m128i lanes = _mm_add_epi32(_mm_set1_epi32(x), laneIndices);
+                const __m128i inRect = _mm_and_si128(_mm_cmpgt_epi32(lanes, firstLane), _mm_cmplt_epi32(lanes, lastLane));
+
+                const __m128 behind = _mm_cmpge_ps(_mm_loadu_ps(row + x), boxDepth);
+                if (_mm_movemask_ps(_mm_and_ps(behind, _mm_castsi128_ps(inRect))) != 0) {
+                    return true;
+                }
+            }
+        }
+#else
+        for (int y = minY; y <= maxY; y++) {
+            const float* row = &m_depth[y * OCCLUSION_BUFFER_WIDTH];
+
+            for (int x = minX; x <= maxX; x++) {
+                if (row[x] >= nearestDepth) {
+                    return true;
+                }
+            }
+        }
+#endif
+
+        return false;
+    }
+
+    const std::vector<float>& OcclusionRasterizer::getDepth() const {
+        return m_depth;
+    }
+
+    bool OcclusionRasterizer::project(const glm::vec3 position, glm::vec3& screen) const {
+        const glm::vec4 clip = m_viewProj * glm::vec4(position, 1.0f);
+        if (clip.w < OCCLUSION_MIN_W) {
+            return false;
+        }
+
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+
+        screen = glm::vec3(
+            (ndc.x * 0.5f + 0.5f) * static_cast<float>(OCCLUSION_BUFFER_WIDTH),
+            (ndc.y * 0.5f + 0.5f) * static_cast<float>(OCCLUSION_BUFFER_HEIGHT),
+            ndc.z * 0.5f + 0.5f
+        );
+
+        return true;
+    }
+}
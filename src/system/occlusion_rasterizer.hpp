@@ -0,0 +1,36 @@
+#pragma once
+
+#include "bounding_box.hpp"
+#include <glm.hpp>
+#include <vector>
+
+namespace minecraft::system {
+    constexpr int OCCLUSION_BUFFER_WIDTH = 256;
+    constexpr int OCCLUSION_BUFFER_HEIGHT = 128;
+    constexpr float OCCLUSION_MIN_W = 0.1f;
+
+    // Low resolution depth-only rasterizer for conservative occluders.
+    // Each triangle writes its farthest vertex depth, so the buffer never claims more than the occluders cover.
+    class OcclusionRasterizer {
+    public:
+        OcclusionRasterizer();
+
+        void clear();
+        void setViewProjection(const glm::mat4& viewProj);
+
+        void rasterizeBox(const primitive::BoundingBox& box);
+        void rasterizeTriangle(glm::vec3 v0, glm::vec3 v1, glm::vec3 v2);
+
+        [[nodiscard]]
+        bool isBoxVisible(const primitive::BoundingBox& box) const;
+        [[nodiscard]]
+        const std::vector<float>& getDepth() const;
+
+    private:
+        [[nodiscard]]
+        bool project(glm::vec3 position, glm::vec3& screen) const;
+
+        glm::mat4 m_viewProj{};
+        std::vector<float> m_depth{};
+    };
+}
@@ -22,12 +22,12 @@ namespace minecraft::system {
         updateVectors();
     }
 
-    void PlayerCamera::updateUniforms(const opengl::ShaderProgram& shader) const {
-        const auto view = glm::lookAt(Position, Position + m_front, m_up);
-        const auto projection = glm::perspective(glm::radians(Fov), AspectRatio, DEFAULT_Z_NEAR, DEFAULT_Z_FAR);
+    glm::mat4 PlayerCamera::getViewMatrix() const {
+        return glm::lookAt(Position, Position + m_front, m_up);
+    }
 
-        shader.setUniformMat4("cameraView", view);
-        shader.setUniformMat4("cameraProj", projection);
+    glm::mat4 PlayerCamera::getProjectionMatrix() const {
+        return glm::perspective(glm::radians(Fov), AspectRatio, DEFAULT_Z_NEAR, DEFAULT_Z_FAR);
     }
 
     void PlayerCamera::processKeyboard(const primitive::Direction direction, const float deltaTime) {
@@ -64,6 +64,25 @@ namespace minecraft::system {
             Fov = DEFAULT_MAX_FOV;
     }
 
+    void PlayerCamera::setOrientation(const float yaw, const float pitch) {
+        m_yaw = yaw;
+        m_pitch = glm::clamp(pitch, -DEFAULT_MAX_PITCH, DEFAULT_MAX_PITCH);
+
+        updateVectors();
+    }
+
+    float PlayerCamera::getYaw() const {
+        return m_yaw;
+    }
+
+    float PlayerCamera::getPitch() const {
+        return m_pitch;
+    }
+
+    glm::vec3 PlayerCamera::getFront() const {
+        return m_front;
+    }
+
     void PlayerCamera::updateVectors() {
         glm::vec3 front{};
 
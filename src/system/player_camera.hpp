@@ -22,12 +22,29 @@ namespace minecraft::system {
     public:
         PlayerCamera(glm::vec3 position, float aspectRatio);
 
-        void updateUniforms(const opengl::ShaderProgram& shader) const;
+        // Inline so headless builds that never bind a shader don't need ShaderProgram linked in
+        void updateUniforms(const opengl::ShaderProgram& shader) const {
+            shader.setUniformMat4("cameraView", getViewMatrix());
+            shader.setUniformMat4("cameraProj", getProjectionMatrix());
+        }
+
+        [[nodiscard]]
+        glm::mat4 getViewMatrix() const;
+        [[nodiscard]]
+        glm::mat4 getProjectionMatrix() const;
 
         void processKeyboard(primitive::Direction direction, float deltaTime);
         void processMouseMovement(float offsetX, float offsetY);
         void processMouseScroll(float yOffset);
 
+        void setOrientation(float yaw, float pitch);
+        [[nodiscard]]
+        float getYaw() const;
+        [[nodiscard]]
+        float getPitch() const;
+        [[nodiscard]]
+        glm::vec3 getFront() const;
+
         glm::vec3 Position{};
 
         float AspectRatio;
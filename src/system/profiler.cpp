@@ -0,0 +1,225 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace minecraft::system {
+
+    namespace {
+        // Hands a ring back for reuse when its thread exits
+        struct RingOwner {
+            std::atomic<bool>* owned{};
+            uint32_t thread{};
+
+            ~RingOwner() {
+                if (owned) {
+                    owned->store(false, std::memory_order_release);
+                }
+            }
+        };
+
+        thread_local RingOwner ringOwner;
+
+        void writeEscaped(std::ostream& stream, const std::string_view text) {
+            for (const char c : text) {
+                if (c == '"' || c == '\\') {
+                    stream << '\\';
+                }
+
+                stream << c;
+            }
+        }
+    }
+
+    Profiler::Profiler()
+        : m_epoch(now()) {}
+
+    Profiler& Profiler::get() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    void Profiler::setEnabled(const bool enabled) {
+        m_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    Profiler::ThreadRing& Profiler::getThreadRing() {
+        thread_local ThreadRing* ring = nullptr;
+
+        if (ring) {
+            return *ring;
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        for (const auto& candidate : m_rings) {
+            bool expected = false;
+            if (candidate->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                ring = candidate.get();
+                break;
+            }
+        }
+
+        if (!ring) {
+            m_rings.push_back(std::make_unique<ThreadRing>());
+            ring = m_rings.back().get();
+            ring->owned.store(true, std::memory_order_relaxed);
+        }
+
+        ringOwner.owned = &ring->owned;
+        ringOwner.thread = m_nextThread++;
+
+        return *ring;
+    }
+
+    void Profiler::record(const char* name, const uint64_t start, const uint64_t end, const uint32_t depth) {
+        ThreadRing& ring = getThreadRing();
+
+        // Single producer, so the slot only needs publishing after it's written
+        const uint64_t head = ring.head.load(std::memory_order_relaxed);
+        ring.events[head % PROFILER_RING_CAPACITY] = ZoneEvent { name, start, end, depth, ringOwner.thread };
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    void Profiler::collect() {
+        std::lock_guard lock(m_mutex);
+
+        for (const auto& ring : m_rings) {
+            const uint64_t head = ring->head.load(std::memory_order_acquire);
+            const uint64_t begin = std::max(ring->tail, head > PROFILER_RING_CAPACITY ? head - PROFILER_RING_CAPACITY : 0);
+
+            std::vector<ZoneEvent> events;
+            events.reserve(head - begin);
+
+            for (uint64_t i = begin; i < head; i++) {
+                events.push_back(ring->events[i % PROFILER_RING_CAPACITY]);
+            }
+
+            // Anything the writer lapped while it was being copied is torn, drop it
+            const uint64_t after = ring->head.load(std::memory_order_acquire);
+            const uint64_t overwritten = after > PROFILER_RING_CAPACITY ? after - PROFILER_RING_CAPACITY : 0;
+            const uint64_t valid = std::min(std::max(begin, overwritten), head);
+
+            m_droppedEvents += valid - ring->tail;
+            ring->tail = head;
+
+            for (uint64_t i = valid; i < head; i++) {
+                const ZoneEvent& event = events[i - begin];
+
+                ZoneHistory*& cached = m_zoneLookup[event.name];
+                if (!cached) {
+                    cached = &m_zones[event.name];
+                }
+
+                ZoneHistory& history = *cached;
+                history.durations[history.count % PROFILER_STATS_WINDOW] = event.end - event.start;
+                history.count++;
+
+                if (m_trace.size() < PROFILER_TRACE_CAPACITY) {
+                    m_trace.push_back(event);
+                } else {
+                    m_trace[m_traceNext] = event;
+                }
+
+                m_traceNext = (m_traceNext + 1) % PROFILER_TRACE_CAPACITY;
+            }
+        }
+    }
+
+    void Profiler::reset() {
+        collect();
+
+        std::lock_guard lock(m_mutex);
+        m_trace.clear();
+        m_traceNext = 0;
+        m_zones.clear();
+        m_zoneLookup.clear();
+        m_droppedEvents = 0;
+    }
+
+    std::vector<ZoneStats> Profiler::getStats() const {
+        std::lock_guard lock(m_mutex);
+        std::vector<ZoneStats> stats;
+
+        for (const auto& [name, history] : m_zones) {
+            const size_t count = std::min<uint64_t>(history.count, PROFILER_STATS_WINDOW);
+            std::vector<uint64_t> durations(history.durations.begin(), history.durations.begin() + count);
+
+            const size_t p99 = std::min(count - 1, count * 99 / 100);
+            std::ranges::nth_element(durations, durations.begin() + p99);
+            const uint64_t p99Duration = durations[p99];
+
+            uint64_t total = 0;
+            for (const uint64_t duration : durations) {
+                total += duration;
+            }
+
+            stats.push_back(ZoneStats {
+                name, history.count,
+                static_cast<double>(*std::ranges::min_element(durations)) / 1e6,
+                static_cast<double>(total) / static_cast<double>(count) / 1e6,
+                static_cast<double>(p99Duration) / 1e6,
+            });
+        }
+
+        std::ranges::sort(stats, std::ranges::greater{}, &ZoneStats::avgMilliseconds);
+        return stats;
+    }
+
+    void Profiler::printStats() const {
+        // Formatted apart so the fixed precision doesn't stick to std::cout
+        std::ostringstream table;
+        table << std::left << std::setw(32) << "Zone" << std::right
+              << std::setw(10) << "Count" << std::setw(12) << "Min ms" << std::setw(12) << "Avg ms" << std::setw(12) << "P99 ms"
+              << "\n" << std::fixed << std::setprecision(3);
+
+        for (const auto& [name, count, min, avg, p99] : getStats()) {
+            table << std::left << std::setw(32) << name << std::right
+                  << std::setw(10) << count << std::setw(12) << min << std::setw(12) << avg << std::setw(12) << p99 << "\n";
+        }
+
+        std::cout << table.str() << std::flush;
+    }
+
+    bool Profiler::exportTrace(const std::filesystem::path& path) const {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file) {
+            std::cerr << "Failed to write profiler trace: " << path << std::endl;
+            return false;
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        // The trace is a ring once full, so start from the oldest event
+        const size_t start = m_trace.size() < PROFILER_TRACE_CAPACITY ? 0 : m_traceNext;
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::fixed << std::setprecision(3);
+
+        for (size_t i = 0; i < m_trace.size(); i++) {
+            const ZoneEvent& event = m_trace[(start + i) % m_trace.size()];
+
+            file << (i == 0 ? "\n" : ",\n") << "{\"name\":\"";
+            writeEscaped(file, event.name);
+            file << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+                 << ",\"ts\":" << static_cast<double>(event.start - std::min(event.start, m_epoch)) / 1e3
+                 << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1e3
+                 << ",\"args\":{\"depth\":" << event.depth << "}}";
+        }
+
+        file << "\n]}\n";
+
+        std::cout << "Wrote " << m_trace.size() << " profiler zones to " << path;
+        if (m_droppedEvents > 0) {
+            std::cout << " (" << m_droppedEvents << " dropped)";
+        }
+        std::cout << std::endl;
+
+        return true;
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace minecraft::system {
+    // Compile time switch, with it off a ProfileZone is an empty object the optimiser removes
+    constexpr bool ENABLE_PROFILER = true;
+
+    constexpr size_t PROFILER_RING_CAPACITY = 1 << 14;
+    constexpr size_t PROFILER_STATS_WINDOW = 256;
+    constexpr size_t PROFILER_TRACE_CAPACITY = 1 << 18;
+
+    const std::filesystem::path PROFILER_TRACE_PATH = std::filesystem::path(PROJECT_SOURCE_DIR) / "cache" / "trace.json";
+
+    struct ZoneEvent {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+        uint32_t depth;
+        uint32_t thread;
+    };
+
+    struct ZoneStats {
+        std::string name;
+        uint64_t count;
+        double minMilliseconds;
+        double avgMilliseconds;
+        double p99Milliseconds;
+    };
+
+    // Zones are written to a ring owned by the recording thread, so recording never takes a lock.
+    // collect() drains every ring from one thread into the aggregated stats and the trace history
+    class Profiler {
+    public:
+        static Profiler& get();
+
+        static uint64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count();
+        }
+
+        void setEnabled(bool enabled);
+        [[nodiscard]]
+        bool isEnabled() const {
+            return m_enabled.load(std::memory_order_relaxed);
+        }
+
+        // Zone names must outlive the profiler, string literals in practice
+        void record(const char* name, uint64_t start, uint64_t end, uint32_t depth);
+        void collect();
+        void reset();
+
+        // Min, average and p99 over the last PROFILER_STATS_WINDOW samples of each zone
+        [[nodiscard]]
+        std::vector<ZoneStats> getStats() const;
+        void printStats() const;
+
+        // Chrome trace_event JSON, opens in chrome://tracing or Perfetto
+        bool exportTrace(const std::filesystem::path& path) const;
+
+    private:
+        struct ThreadRing {
+            std::array<ZoneEvent, PROFILER_RING_CAPACITY> events{};
+            std::atomic<uint64_t> head{};
+            std::atomic<bool> owned{};
+            uint64_t tail{};
+        };
+
+        struct ZoneHistory {
+            std::array<uint64_t, PROFILER_STATS_WINDOW> durations{};
+            uint64_t count{};
+        };
+
+        Profiler();
+        ThreadRing& getThreadRing();
+
+        std::atomic<bool> m_enabled{true};
+        std::atomic<uint32_t> m_nextThread{};
+        uint64_t m_epoch{};
+
+        // Guards ring registration and the collected data, never the recording path
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<ThreadRing>> m_rings{};
+        std::vector<ZoneEvent> m_trace{};
+        size_t m_traceNext{};
+        std::unordered_map<std::string, ZoneHistory> m_zones{};
+        // Literals usually share one address, so most events skip hashing the name
+        std::unordered_map<const char*, ZoneHistory*> m_zoneLookup{};
+        uint64_t m_droppedEvents{};
+    };
+
+    class ProfileZone {
+    public:
+        explicit ProfileZone(const char* name) {
+            if constexpr (ENABLE_PROFILER) {
+                if (Profiler::get().isEnabled()) {
+                    m_name = name;
+                    m_start = Profiler::now();
+                    m_depth = s_depth++;
+                }
+            }
+        }
+
+        ~ProfileZone() {
+            if constexpr (ENABLE_PROFILER) {
+                if (m_name) {
+                    s_depth--;
+                    Profiler::get().record(m_name, m_start, Profiler::now(), m_depth);
+                }
+            }
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        static thread_local inline uint32_t s_depth{};
+
+        const char* m_name{};
+        uint64_t m_start{};
+        uint32_t m_depth{};
+    };
+}
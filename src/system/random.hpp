@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+namespace minecraft::system {
+
+    // xoshiro256** seeded through splitmix64. Fast and reproducible from the seed, not for anything security related
+    class Random {
+    public:
+        explicit Random(uint64_t seed = 0) {
+            for (uint64_t& word : m_state) {
+                seed += 0x9e3779b97f4a7c15ull;
+
+                uint64_t mixed = seed;
+                mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ull;
+                mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebull;
+                word = mixed ^ (mixed >> 31);
+            }
+        }
+
+        uint64_t next() {
+            const uint64_t result = rotate(m_state[1] * 5, 7) * 9;
+            const uint64_t shifted = m_state[1] << 17;
+
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+            m_state[2] ^= shifted;
+            m_state[3] = rotate(m_state[3], 45);
+
+            return result;
+        }
+
+        // Uniform in [0, bound), by multiply and shift rather than a modulo
+        uint32_t nextBelow(const uint32_t bound) {
+            return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+        }
+
+    private:
+        static uint64_t rotate(const uint64_t value, const int shift) {
+            return (value << shift) | (value >> (64 - shift));
+        }
+
+        uint64_t m_state[4]{};
+    };
+}
@@ -0,0 +1,141 @@
+#include "rect_packer.hpp"
+
+#include <algorithm>
+#include <climits>
+
+namespace minecraft::system {
+
+    namespace {
+        bool contains(const PackedRect& outer, const PackedRect& inner) {
+            return inner.x >= outer.x && inner.y >= outer.y
+                && inner.x + inner.width <= outer.x + outer.width
+                && inner.y + inner.height <= outer.y + outer.height;
+        }
+
+        bool intersects(const PackedRect& a, const PackedRect& b) {
+            return a.x < b.x + b.width && b.x < a.x + a.width
+                && a.y < b.y + b.height && b.y < a.y + a.height;
+        }
+    }
+
+    RectPacker::RectPacker(const int width, const int height) {
+        reset(width, height);
+    }
+
+    void RectPacker::reset(const int width, const int height) {
+        m_width = width;
+        m_height = height;
+        m_usedArea = 0;
+
+        m_freeRects.clear();
+        m_freeRects.push_back(PackedRect { 0, 0, width, height });
+    }
+
+    std::optional<PackedRect> RectPacker::insert(const int width, const int height) {
+        if (width <= 0 || height <= 0) {
+            return std::nullopt;
+        }
+
+        int bestShortSide = INT_MAX;
+        int bestLongSide = INT_MAX;
+        std::optional<PackedRect> best{};
+
+        for (const auto& free : m_freeRects) {
+            if (free.width < width || free.height < height) {
+                continue;
+            }
+
+            const int leftoverX = free.width - width;
+            const int leftoverY = free.height - height;
+            const int shortSide = std::min(leftoverX, leftoverY);
+            const int longSide = std::max(leftoverX, leftoverY);
+
+            if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+                bestShortSide = shortSide;
+                bestLongSide = longSide;
+                best = PackedRect { free.x, free.y, width, height };
+            }
+        }
+
+        if (!best) {
+            return std::nullopt;
+        }
+
+        occupy(*best);
+        return best;
+    }
+
+    void RectPacker::occupy(const PackedRect& rect) {
+        splitFreeRects(rect);
+        pruneFreeRects();
+
+        m_usedArea += static_cast<long long>(rect.width) * rect.height;
+    }
+
+    float RectPacker::getOccupancy() const {
+        if (m_width == 0 || m_height == 0) {
+            return 0.0f;
+        }
+
+        return static_cast<float>(m_usedArea) / (static_cast<float>(m_width) * static_cast<float>(m_height));
+    }
+
+    int RectPacker::getWidth() const {
+        return m_width;
+    }
+
+    int RectPacker::getHeight() const {
+        return m_height;
+    }
+
+    void RectPacker::splitFreeRects(const PackedRect& used) {
+        m_newFreeRects.clear();
+
+        const auto addNew = [this](const PackedRect& rect) {
+            for (auto& existing : m_newFreeRects) {
+                if (contains(existing, rect)) {
+                    return;
+                }
+            }
+
+            std::erase_if(m_newFreeRects, [&](const PackedRect& existing) { return contains(rect, existing); });
+            m_newFreeRects.push_back(rect);
+        };
+
+        for (size_t i = 0; i < m_freeRects.size();) {
+            const PackedRect free = m_freeRects[i];
+            if (!intersects(free, used)) {
+                i++;
+                continue;
+            }
+
+            // Up to four maximal rectangles remain around the used area
+            if (used.x > free.x) {
+                addNew(PackedRect { free.x, free.y, used.x - free.x, free.height });
+            }
+            if (used.x + used.width < free.x + free.width) {
+                const int x = used.x + used.width;
+                addNew(PackedRect { x, free.y, free.x + free.width - x, free.height });
+            }
+            if (used.y > free.y) {
+                addNew(PackedRect { free.x, free.y, free.width, used.y - free.y });
+            }
+            if (used.y + used.height < free.y + free.height) {
+                const int y = used.y + used.height;
+                addNew(PackedRect { free.x, y, free.width, free.y + free.height - y });
+            }
+
+            m_freeRects[i] = m_freeRects.back();
+            m_freeRects.pop_back();
+        }
+    }
+
+    void RectPacker::pruneFreeRects() {
+        // Split pieces are subsets of their source, so only they can be redundant
+        std::erase_if(m_newFreeRects, [this](const PackedRect& rect) {
+            return std::ranges::any_of(m_freeRects, [&](const PackedRect& free) { return contains(free, rect); });
+        });
+
+        m_freeRects.insert(m_freeRects.end(), m_newFreeRects.begin(), m_newFreeRects.end());
+    }
+}
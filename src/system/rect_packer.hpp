@@ -0,0 +1,45 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+namespace minecraft::system {
+
+    struct PackedRect {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    // MaxRects bin packer using the best short side fit heuristic.
+    // Rectangles can be inserted one at a time, so new textures don't force a full repack.
+    class RectPacker {
+    public:
+        RectPacker() = default;
+        RectPacker(int width, int height);
+
+        void reset(int width, int height);
+        std::optional<PackedRect> insert(int width, int height);
+        // Marks an already placed rectangle as used, e.g. when restoring a cached layout
+        void occupy(const PackedRect& rect);
+
+        [[nodiscard]]
+        float getOccupancy() const;
+        [[nodiscard]]
+        int getWidth() const;
+        [[nodiscard]]
+        int getHeight() const;
+
+    private:
+        void splitFreeRects(const PackedRect& used);
+        void pruneFreeRects();
+
+        std::vector<PackedRect> m_freeRects{};
+        std::vector<PackedRect> m_newFreeRects{};
+        long long m_usedArea{};
+
+        int m_width{};
+        int m_height{};
+    };
+}
@@ -0,0 +1,109 @@
+#include "shader_cache.hpp"
+#include "hash.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace minecraft::system {
+
+    namespace {
+        constexpr uint32_t SHADER_CACHE_MAGIC = 0x43444853;  // "SHDC"
+        constexpr uint32_t SHADER_CACHE_VERSION = 1;
+
+        struct ShaderCacheHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t key;
+            uint32_t format;
+            uint32_t size;
+            uint64_t checksum;
+        };
+    }
+
+    ShaderCache::ShaderCache(std::filesystem::path directory)
+        : m_directory(std::move(directory)) {}
+
+    uint64_t ShaderCache::makeKey(
+        const std::vector<std::string_view>& sources,
+        const std::string_view defines, const std::string_view driver
+    ) {
+        uint64_t key = hashValue(SHADER_CACHE_VERSION);
+
+        // Lengths first, so no split of the same text between neighbouring strings hashes alike
+        for (const std::string_view source : sources) {
+            key = hashValue(source.size(), key);
+            key = hashString(source, key);
+        }
+
+        key = hashValue(defines.size(), key);
+        key = hashString(defines, key);
+        key = hashValue(driver.size(), key);
+        return hashString(driver, key);
+    }
+
+    std::optional<ShaderBinary> ShaderCache::load(const uint64_t key) const {
+        std::ifstream file(getPath(key), std::ios::binary | std::ios::ate);
+        if (!file) {
+            return std::nullopt;
+        }
+
+        const auto fileSize = static_cast<size_t>(file.tellg());
+        file.seekg(0);
+
+        ShaderCacheHeader header{};
+        if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            file.close();
+            invalidate(key);
+            return std::nullopt;
+        }
+
+        const bool valid = header.magic == SHADER_CACHE_MAGIC && header.version == SHADER_CACHE_VERSION
+            && header.key == key && header.size == fileSize - sizeof(header);
+
+        ShaderBinary binary { header.format, std::vector<unsigned char>(valid ? header.size : 0) };
+
+        // Truncated or stale entries are removed so the next run rewrites them
+        if (!valid || !file.read(reinterpret_cast<char*>(binary.data.data()), header.size)
+            || hashBytes(binary.data.data(), binary.data.size()) != header.checksum) {
+            file.close();
+            invalidate(key);
+            return std::nullopt;
+        }
+
+        return binary;
+    }
+
+    bool ShaderCache::store(const uint64_t key, const ShaderBinary& binary) const {
+        std::error_code error;
+        std::filesystem::create_directories(m_directory, error);
+
+        std::ofstream file(getPath(key), std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Failed to write shader cache entry: " << getPath(key) << std::endl;
+            return false;
+        }
+
+        const ShaderCacheHeader header {
+            SHADER_CACHE_MAGIC, SHADER_CACHE_VERSION, key, binary.format,
+            static_cast<uint32_t>(binary.data.size()), hashBytes(binary.data.data(), binary.data.size())
+        };
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(binary.data.data()), static_cast<std::streamsize>(binary.data.size()));
+
+        return static_cast<bool>(file);
+    }
+
+    void ShaderCache::invalidate(const uint64_t key) const {
+        std::error_code error;
+        std::filesystem::remove(getPath(key), error);
+    }
+
+    std::filesystem::path ShaderCache::getPath(const uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+
+        return m_directory / name;
+    }
+}
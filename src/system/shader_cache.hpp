@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace minecraft::system {
+
+    struct ShaderBinary {
+        unsigned int format;
+        std::vector<unsigned char> data;
+    };
+
+    // Linked program binaries on disk, one file per key. Doesn't touch GL so it can be used and checked headless
+    class ShaderCache {
+    public:
+        explicit ShaderCache(std::filesystem::path directory);
+
+        // Any change to a source, the define set or the driver produces a different key
+        static uint64_t makeKey(const std::vector<std::string_view>& sources, std::string_view defines, std::string_view driver);
+
+        [[nodiscard]]
+        std::optional<ShaderBinary> load(uint64_t key) const;
+        bool store(uint64_t key, const ShaderBinary& binary) const;
+        void invalidate(uint64_t key) const;
+
+        [[nodiscard]]
+        std::filesystem::path getPath(uint64_t key) const;
+
+    private:
+        std::filesystem::path m_directory;
+    };
+}
@@ -0,0 +1,249 @@
+#include "shader_preprocessor.hpp"
+#include "hash.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <unordered_set>
+
+namespace minecraft::system {
+
+    namespace {
+        std::string_view trimLeft(std::string_view line) {
+            const size_t start = line.find_first_not_of(" \t");
+            return start == std::string_view::npos ? std::string_view{} : line.substr(start);
+        }
+
+        // "#  include" is valid GLSL, so the directive name is matched after the hash
+        bool isDirective(const std::string_view line, const std::string_view name, std::string_view& rest) {
+            std::string_view trimmed = trimLeft(line);
+            if (trimmed.empty() || trimmed[0] != '#') {
+                return false;
+            }
+
+            trimmed = trimLeft(trimmed.substr(1));
+            if (!trimmed.starts_with(name)) {
+                return false;
+            }
+
+            rest = trimLeft(trimmed.substr(name.size()));
+            return true;
+        }
+
+        bool isIdentifierChar(const char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        }
+
+        std::unordered_set<std::string_view> collectIdentifiers(const std::vector<std::string>& lines) {
+            std::unordered_set<std::string_view> identifiers;
+
+            for (const auto& line : lines) {
+                for (size_t i = 0; i < line.size();) {
+                    if (!isIdentifierChar(line[i])) {
+                        i++;
+                        continue;
+                    }
+
+                    const size_t start = i;
+                    while (i < line.size() && isIdentifierChar(line[i])) {
+                        i++;
+                    }
+
+                    identifiers.insert(std::string_view(line).substr(start, i - start));
+                }
+            }
+
+            return identifiers;
+        }
+    }
+
+    ShaderPreprocessor::ShaderPreprocessor(std::filesystem::path includeDir)
+        : m_includeDir(std::move(includeDir)) {}
+
+    std::optional<PreprocessedShader> ShaderPreprocessor::process(const std::string_view fileName, const ShaderDefines& defines) const {
+        Context context{};
+        if (!processFile(m_includeDir / fileName, context)) {
+            return std::nullopt;
+        }
+
+        if (context.version.empty()) {
+            std::cout << "Shader Preprocessing Error: " << fileName << " has no #version directive" << std::endl;
+            return std::nullopt;
+        }
+
+        PreprocessedShader shader{};
+        shader.dependencies = std::move(context.included);
+
+        const auto appendLine = [&shader](const std::string_view line, SourceLocation location) {
+            shader.source += line;
+            shader.source += '\n';
+            shader.lineMap.push_back(std::move(location));
+        };
+
+        appendLine(context.version, context.versionLocation);
+
+        const auto identifiers = collectIdentifiers(context.lines);
+        int defineLine = 1;
+
+        for (const auto& [name, value] : defines) {
+            if (!identifiers.contains(name)) {
+                continue;
+            }
+
+            appendLine("#define " + name + (value.empty() ? "" : " " + value), SourceLocation { "<defines>", defineLine++ });
+        }
+
+        for (size_t i = 0; i < context.lines.size(); i++) {
+            appendLine(context.lines[i], context.lineMap[i]);
+        }
+
+        shader.hash = hashString(shader.source);
+        return shader;
+    }
+
+    bool ShaderPreprocessor::processFile(const std::filesystem::path& path, Context& context) const {
+        const auto normalized = std::filesystem::weakly_canonical(path);
+
+        if (std::ranges::find(context.includeStack, normalized) != context.includeStack.end()) {
+            std::cout << "Shader Preprocessing Error: recursive #include of " << path.filename().string() << std::endl;
+            return false;
+        }
+
+        if (std::ranges::find(context.onceFiles, normalized) != context.onceFiles.end()) {
+            return true;
+        }
+
+        std::ifstream file(normalized);
+        if (!file) {
+            std::cout << "Shader Loading Error: could not open " << path.string() << std::endl;
+            return false;
+        }
+
+        if (std::ranges::find(context.included, normalized) == context.included.end()) {
+            context.included.push_back(normalized);
+        }
+
+        context.includeStack.push_back(normalized);
+
+        const auto relative = normalized.lexically_relative(std::filesystem::weakly_canonical(m_includeDir));
+        const std::string fileLabel = relative.empty() || *relative.begin() == ".."
+            ? normalized.filename().string()
+            : relative.generic_string();
+        std::string line;
+        int lineNumber = 0;
+
+        while (std::getline(file, line)) {
+            lineNumber++;
+
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+
+            std::string_view rest;
+
+            if (isDirective(line, "version", rest)) {
+                // Only the outermost file's #version counts, includes may carry one for editor support
+                if (context.version.empty()) {
+                    context.version = line;
+                    context.versionLocation = SourceLocation { fileLabel, lineNumber };
+                }
+
+                continue;
+            }
+
+            if (isDirective(line, "pragma", rest) && rest.starts_with("once")) {
+                context.onceFiles.push_back(normalized);
+                continue;
+            }
+
+            if (isDirective(line, "include", rest)) {
+                const char open = rest.empty() ? '\0' : rest[0];
+                const char close = open == '<' ? '>' : '"';
+                const size_t end = rest.find(close, 1);
+
+                if ((open != '"' && open != '<') || end == std::string_view::npos) {
+                    std::cout << "Shader Preprocessing Error: " << fileLabel << ":" << lineNumber << ": malformed #include" << std::endl;
+                    context.includeStack.pop_back();
+                    return false;
+                }
+
+                const auto include = resolveInclude(rest.substr(1, end - 1), normalized);
+                if (!include) {
+                    std::cout << "Shader Preprocessing Error: " << fileLabel << ":" << lineNumber
+                              << ": cannot find " << rest.substr(1, end - 1) << std::endl;
+                    context.includeStack.pop_back();
+                    return false;
+                }
+
+                if (!processFile(*include, context)) {
+                    context.includeStack.pop_back();
+                    return false;
+                }
+
+                continue;
+            }
+
+            context.lines.push_back(line);
+            context.lineMap.push_back(SourceLocation { fileLabel, lineNumber });
+        }
+
+        context.includeStack.pop_back();
+        return true;
+    }
+
+    std::optional<std::filesystem::path> ShaderPreprocessor::resolveInclude(
+        const std::string_view name, const std::filesystem::path& includer
+    ) const {
+        for (const auto& directory : { includer.parent_path(), m_includeDir }) {
+            const auto candidate = directory / name;
+            if (std::filesystem::is_regular_file(candidate)) {
+                return candidate;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::string ShaderPreprocessor::mapErrorLog(const std::string_view log, const PreprocessedShader& shader) {
+        // NVIDIA writes "0(12)", Mesa, AMD and Intel write "0:12"
+        static const std::regex location(R"((^|[^0-9])0(?:\((\d+)\)|:(\d+)))");
+
+        std::string result;
+        std::istringstream stream{std::string(log)};
+        std::string line;
+
+        while (std::getline(stream, line)) {
+            std::smatch match;
+
+            if (std::regex_search(line, match, location)) {
+                const int outputLine = std::stoi(match[2].matched ? match[2].str() : match[3].str());
+
+                if (outputLine >= 1 && outputLine <= static_cast<int>(shader.lineMap.size())) {
+                    const auto& [file, sourceLine] = shader.lineMap[outputLine - 1];
+                    line = match.prefix().str() + match[1].str() + file + ":" + std::to_string(sourceLine) + match.suffix().str();
+                }
+            }
+
+            result += line;
+            result += '\n';
+        }
+
+        return result;
+    }
+
+    std::string ShaderPreprocessor::toString(const ShaderDefines& defines) {
+        std::string result;
+
+        for (const auto& [name, value] : defines) {
+            result += name;
+            result += '=';
+            result += value;
+            result += ';';
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace minecraft::system {
+
+    // Ordered so that the same set always produces the same text and hash
+    using ShaderDefines = std::map<std::string, std::string>;
+
+    struct SourceLocation {
+        std::string file;
+        int line;
+    };
+
+    struct PreprocessedShader {
+        std::string source;
+        // Original file and line of every output line, index 0 is line 1
+        std::vector<SourceLocation> lineMap;
+        std::vector<std::filesystem::path> dependencies;
+        uint64_t hash;
+    };
+
+    // Resolves #include and #pragma once and injects a define set after #version.
+    // Defines the source never mentions are dropped, so permutations that only differ
+    // in unused defines come out identical and share a hash
+    class ShaderPreprocessor {
+    public:
+        explicit ShaderPreprocessor(std::filesystem::path includeDir);
+
+        [[nodiscard]]
+        std::optional<PreprocessedShader> process(std::string_view fileName, const ShaderDefines& defines) const;
+
+        // Rewrites "0(12)" / "0:12" locations in a driver info log to the original file and line
+        static std::string mapErrorLog(std::string_view log, const PreprocessedShader& shader);
+        static std::string toString(const ShaderDefines& defines);
+
+    private:
+        struct Context {
+            std::vector<std::string> lines;
+            std::vector<SourceLocation> lineMap;
+            std::vector<std::filesystem::path> includeStack;
+            std::vector<std::filesystem::path> included;
+            std::vector<std::filesystem::path> onceFiles;
+            std::string version;
+            SourceLocation versionLocation;
+        };
+
+        bool processFile(const std::filesystem::path& path, Context& context) const;
+        [[nodiscard]]
+        std::optional<std::filesystem::path> resolveInclude(std::string_view name, const std::filesystem::path& includer) const;
+
+        std::filesystem::path m_includeDir;
+    };
+}
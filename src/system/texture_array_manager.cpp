@@ -0,0 +1,192 @@
+#include "texture_array_manager.hpp"
+#include "mipmap.hpp"
+#include "profiler.hpp"
+
+#include <glad/glad.h>
+#include <iostream>
+
+namespace minecraft::system {
+    namespace {
+        size_t getChainSize(const std::vector<std::vector<unsigned char>>& mipLevels) {
+            size_t bytes = 0;
+            for (const auto& level : mipLevels) {
+                bytes += level.size();
+            }
+
+            return bytes;
+        }
+    }
+
+    TextureArrayManager::TextureArrayManager() {
+        stbi_set_flip_vertically_on_load(true);
+    }
+
+    TextureArrayManager::~TextureArrayManager() {
+        unloadAll();
+    }
+
+    bool TextureArrayManager::loadTexture(const std::string_view name, const std::string_view path) {
+        if (m_layerIndices.contains(name.data())) {
+            return true;
+        }
+
+        if (m_layers.size() >= MAX_TEXTURE_LAYERS) {
+            std::cerr << "Texture array full. Max layers: " << MAX_TEXTURE_LAYERS << std::endl;
+            return false;
+        }
+
+        const std::string texturePath = (ASSETS_DIR / path).string();
+        int width, height, channels;
+
+        unsigned char* data = stbi_load(texturePath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+        if (!data) {
+            std::cerr << "Failed to load data for texture: " << path << std::endl;
+            return false;
+        }
+
+        if (!m_layers.empty() && (width != m_layerWidth || height != m_layerHeight)) {
+            std::cerr << "Texture " << path << " is " << width << "x" << height
+                      << ", texture array layers are " << m_layerWidth << "x" << m_layerHeight << std::endl;
+            stbi_image_free(data);
+            return false;
+        }
+
+        m_layerWidth = width;
+        m_layerHeight = height;
+
+        m_layerIndices[name.data()] = static_cast<unsigned int>(m_layers.size());
+        m_layers.push_back(Layer { name.data(), texturePath, width, height, buildMipChain(data, width, height) });
+        m_layerMemory.set(m_layerMemory.get() + getChainSize(m_layers.back().mipLevels));
+        m_requiresRebuild = true;
+
+        stbi_image_free(data);
+        return true;
+    }
+
+    std::optional<unsigned int> TextureArrayManager::getLayer(const std::string_view name) const {
+        if (m_layerIndices.contains(name.data())) {
+            return m_layerIndices.at(name.data());
+        }
+
+        return std::nullopt;
+    }
+
+    bool TextureArrayManager::reloadTexture(const std::filesystem::path& path) {
+        if (m_id == 0 || m_requiresRebuild) {
+            return false;
+        }
+
+        std::error_code error;
+        const auto changed = std::filesystem::weakly_canonical(path, error);
+        bool reloaded = false;
+
+        for (size_t i = 0; i < m_layers.size(); i++) {
+            Layer& layer = m_layers[i];
+            if (std::filesystem::weakly_canonical(layer.path, error) != changed) {
+                continue;
+            }
+
+            int width, height, channels;
+            unsigned char* data = stbi_load(layer.path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+
+            if (!data) {
+                std::cerr << "Failed to reload texture: " << layer.path << std::endl;
+                continue;
+            }
+
+            // Storage is immutable, so a layer can only be replaced by one of the same size
+            if (width != m_layerWidth || height != m_layerHeight) {
+                std::cerr << "Reloaded texture " << layer.path << " is " << width << "x" << height
+                          << ", texture array layers are " << m_layerWidth << "x" << m_layerHeight << std::endl;
+                stbi_image_free(data);
+                continue;
+            }
+
+            layer.mipLevels = buildMipChain(data, width, height);
+            stbi_image_free(data);
+
+            uploadLayer(static_cast<int>(i));
+            reloaded = true;
+
+            std::cout << "Reloaded texture array layer " << i << " (" << layer.name << ")" << std::endl;
+        }
+
+        return reloaded;
+    }
+
+    unsigned int TextureArrayManager::getID() {
+        if (m_requiresRebuild) {
+            build();
+        }
+
+        return m_id;
+    }
+
+    bool TextureArrayManager::build() {
+        if (!m_requiresRebuild || m_layers.empty()) {
+            return true;
+        }
+
+        ProfileZone zone("TextureArrayManager::build");
+
+        if (m_id != 0) {
+            glDeleteTextures(1, &m_id);
+        }
+
+        const int levelCount = getMipLevelCount(m_layerWidth, m_layerHeight);
+        const auto layerCount = static_cast<int>(m_layers.size());
+
+        glGenTextures(1, &m_id);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, levelCount, GL_RGBA8, m_layerWidth, m_layerHeight, layerCount);
+        m_textureMemory.set(getChainSize(m_layers.front().mipLevels) * layerCount);
+
+        for (int layer = 0; layer < layerCount; layer++) {
+            uploadLayer(layer);
+        }
+
+        m_requiresRebuild = false;
+
+        std::cout << "Built texture array (" << m_layerWidth << "x" << m_layerHeight << ") with "
+                  << layerCount << " layers and " << levelCount << " mip levels" << std::endl;
+
+        return true;
+    }
+
+    void TextureArrayManager::uploadLayer(const int layer) const {
+        ProfileZone zone("TextureArrayManager::uploadLayer");
+
+        int width = m_layerWidth;
+        int height = m_layerHeight;
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+
+        for (size_t level = 0; level < m_layers[layer].mipLevels.size(); level++) {
+            glTexSubImage3D(
+                GL_TEXTURE_2D_ARRAY, static_cast<int>(level), 0, 0, layer, width, height, 1,
+                GL_RGBA, GL_UNSIGNED_BYTE, m_layers[layer].mipLevels[level].data()
+            );
+
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
+    }
+
+    void TextureArrayManager::unloadAll() {
+        if (m_id != 0) {
+            glDeleteTextures(1, &m_id);
+            m_id = 0;
+        }
+
+        m_layerIndices.clear();
+        m_layers.clear();
+        m_layerMemory.set(0);
+        m_textureMemory.set(0);
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "atlas_manager.hpp"
+
+namespace minecraft::system {
+    constexpr unsigned int MAX_TEXTURE_LAYERS = 128;
+
+    // One GL_TEXTURE_2D_ARRAY layer per block texture, each with its own CPU generated mip chain
+    class TextureArrayManager {
+    public:
+        TextureArrayManager();
+        ~TextureArrayManager();
+
+        TextureArrayManager(const TextureArrayManager&) = delete;
+        TextureArrayManager& operator=(const TextureArrayManager&) = delete;
+
+        bool loadTexture(std::string_view name, std::string_view path);
+        std::optional<unsigned int> getLayer(std::string_view name) const;
+        // Re-decodes the layers loaded from path and uploads only those layers
+        bool reloadTexture(const std::filesystem::path& path);
+
+        unsigned int getID();
+        bool build();
+        void unloadAll();
+
+    private:
+        void uploadLayer(int layer) const;
+
+        struct Layer {
+            std::string name;
+            std::string path;
+            int width;
+            int height;
+            std::vector<std::vector<unsigned char>> mipLevels;
+        };
+
+        std::unordered_map<std::string, unsigned int> m_layerIndices{};
+        std::vector<Layer> m_layers{};
+
+        unsigned int m_id{};
+        int m_layerWidth{};
+        int m_layerHeight{};
+
+        bool m_requiresRebuild{};
+
+        MemoryReservation m_layerMemory{MemoryTag::TEXTURES};
+        MemoryReservation m_textureMemory{MemoryTag::GPU_TEXTURES};
+    };
+}
@@ -0,0 +1,101 @@
+#include "worker_pool.hpp"
+
+#include <algorithm>
+
+namespace minecraft::system {
+
+    namespace {
+        // Set on pool workers and on a caller for the length of its job, so nested jobs run inline
+        thread_local bool insideJob = false;
+    }
+
+    WorkerPool& WorkerPool::get() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    WorkerPool::WorkerPool() {
+        const unsigned int workerCount = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+        m_workers.reserve(workerCount);
+
+        for (unsigned int i = 0; i < workerCount; i++) {
+            m_workers.emplace_back([this] { runWorker(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+
+        m_wake.notify_all();
+    }
+
+    size_t WorkerPool::getThreadCount() const {
+        return m_workers.size() + 1;
+    }
+
+    void WorkerPool::run(const Invoke invoke, void* context, const size_t count) {
+        std::unique_lock jobLock(m_jobMutex, std::defer_lock);
+
+        if (count <= 1 || m_workers.empty() || insideJob || !jobLock.try_lock()) {
+            for (size_t index = 0; index < count; index++) {
+                invoke(context, index);
+            }
+
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_invoke = invoke;
+            m_context = context;
+            m_count = count;
+            m_next.store(0, std::memory_order_relaxed);
+            m_busyWorkers = m_workers.size();
+            m_generation++;
+        }
+
+        m_wake.notify_all();
+
+        insideJob = true;
+        claimIndices();
+        insideJob = false;
+
+        // The job's state lives on the caller's stack, so every worker has to be done with it
+        std::unique_lock lock(m_mutex);
+        m_done.wait(lock, [this] { return m_busyWorkers == 0; });
+    }
+
+    void WorkerPool::runWorker() {
+        insideJob = true;
+        uint64_t generation = 0;
+
+        while (true) {
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_stopping || m_generation != generation; });
+
+                if (m_stopping) {
+                    return;
+                }
+
+                generation = m_generation;
+            }
+
+            claimIndices();
+
+            std::lock_guard lock(m_mutex);
+            if (--m_busyWorkers == 0) {
+                m_done.notify_one();
+            }
+        }
+    }
+
+    void WorkerPool::claimIndices() {
+        for (size_t index = m_next++; index < m_count; index = m_next++) {
+            m_invoke(m_context, index);
+        }
+    }
+}
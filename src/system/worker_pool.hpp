@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace minecraft::system {
+
+    // Threads started once and shared by every batch job, so a job costs a wake up instead of spawning threads.
+    // The calling thread works alongside them, and one job runs at a time
+    class WorkerPool {
+    public:
+        static WorkerPool& get();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        ~WorkerPool();
+
+        // Calls work(index) once for every index below count and returns when all calls are done. Calls made
+        // from inside a job, or while another thread's job is running, run serially on the calling thread
+        template <typename Work>
+        void parallelFor(size_t count, Work&& work);
+
+        // Workers plus the calling thread
+        [[nodiscard]]
+        size_t getThreadCount() const;
+
+    private:
+        using Invoke = void (*)(void* context, size_t index);
+
+        WorkerPool();
+
+        void run(Invoke invoke, void* context, size_t count);
+        void runWorker();
+        void claimIndices();
+
+        std::mutex m_jobMutex{};
+        std::mutex m_mutex{};
+        std::condition_variable m_wake{};
+        std::condition_variable m_done{};
+
+        // The current job, written under m_mutex before m_generation moves on
+        Invoke m_invoke{};
+        void* m_context{};
+        size_t m_count{};
+        std::atomic<size_t> m_next{};
+        size_t m_busyWorkers{};
+        uint64_t m_generation{};
+        bool m_stopping{};
+
+        std::vector<std::jthread> m_workers{};
+    };
+
+    template <typename Work>
+    void WorkerPool::parallelFor(const size_t count, Work&& work) {
+        using Callable = std::remove_reference_t<Work>;
+
+        run(
+            [](void* context, const size_t index) { (*static_cast<Callable*>(context))(index); },
+            const_cast<std::remove_const_t<Callable>*>(std::addressof(work)),
+            count
+        );
+    }
+}
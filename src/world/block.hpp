@@ -1,22 +1,41 @@
 #pragma once
 
+#include <cstdint>
+
 namespace minecraft::world {
 
-    enum class BlockType {
+    enum class BlockType : uint8_t {
         AIR,
         TEST,
+        WATER,
+        LAVA,
     };
 
+    // Fluid blocks hold between 1 and this much fluid, a full cell at the top
+    constexpr unsigned int FLUID_MAX_LEVEL = 32;
+
     class Block {
     public:
         Block()
             : m_type(BlockType::AIR) {}
 
-        explicit Block(const BlockType type)
-            : m_type(type) {}
+        explicit Block(const BlockType type, const unsigned int level = 0)
+            : m_type(type), m_level(static_cast<uint8_t>(level)) {}
 
+        // Blocks movement and light, fluids don't
         [[nodiscard]]
         bool solid() const {
+            return m_type != BlockType::AIR && !fluid();
+        }
+
+        [[nodiscard]]
+        bool fluid() const {
+            return m_type == BlockType::WATER || m_type == BlockType::LAVA;
+        }
+
+        // Anything that gets meshed
+        [[nodiscard]]
+        bool visible() const {
             return m_type != BlockType::AIR;
         }
 
@@ -25,7 +44,19 @@ namespace minecraft::world {
             return static_cast<unsigned int>(m_type);
         }
 
+        [[nodiscard]]
+        BlockType getBlockType() const {
+            return m_type;
+        }
+
+        // Amount of fluid in the cell, 0 for anything else
+        [[nodiscard]]
+        unsigned int getLevel() const {
+            return m_level;
+        }
+
     private:
         BlockType m_type;
+        uint8_t m_level{};
     };
 }
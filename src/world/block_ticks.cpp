@@ -0,0 +1,167 @@
+#include "block_ticks.hpp"
+
+#include <algorithm>
+
+namespace minecraft::world {
+
+    BlockTickScheduler::BlockTickScheduler(const World& world, const uint64_t seed)
+        : m_world(world), m_random(seed) {}
+
+    int BlockTickScheduler::findChunkIndex(const glm::ivec3 position) const {
+        if (position.y < 0 || position.y >= static_cast<int>(CHUNK_HEIGHT)) {
+            return -1;
+        }
+
+        const int index = m_world.getChunkIndex(glm::ivec2(position.x >> CHUNK_SIZE_BIT_OFFSET, position.z >> CHUNK_SIZE_BIT_OFFSET));
+        return index < static_cast<int>(m_world.getChunkCount()) ? index : -1;
+    }
+
+    unsigned int BlockTickScheduler::getPendingBit(const glm::ivec3 position) {
+        return (position.y * CHUNK_SIZE + (position.x & (CHUNK_SIZE - 1))) * CHUNK_SIZE + (position.z & (CHUNK_SIZE - 1));
+    }
+
+    BlockTickScheduler::ChunkTicks& BlockTickScheduler::getChunkTicks(const int chunkIndex) {
+        // Chunks are generated after the scheduler is made, so the table catches up lazily
+        if (chunkIndex >= static_cast<int>(m_chunks.size())) {
+            m_chunks.resize(m_world.getChunkCount());
+        }
+
+        return m_chunks[chunkIndex];
+    }
+
+    bool BlockTickScheduler::isLive(const Entry& entry) const {
+        return m_chunks[entry.chunkIndex].generation == entry.generation;
+    }
+
+    bool BlockTickScheduler::schedule(const glm::ivec3 position, const uint64_t delay) {
+        const int chunkIndex = findChunkIndex(position);
+        if (chunkIndex < 0) {
+            return false;
+        }
+
+        ChunkTicks& chunk = getChunkTicks(chunkIndex);
+        const unsigned int bit = getPendingBit(position);
+
+        if (chunk.unloaded || chunk.pending.test(bit)) {
+            return false;
+        }
+
+        chunk.pending.set(bit);
+        m_pendingCount++;
+
+        insert(Entry { position, chunkIndex, chunk.generation, m_currentTick + std::clamp<uint64_t>(delay, 1, MAX_TICK_DELAY) });
+        return true;
+    }
+
+    bool BlockTickScheduler::isScheduled(const glm::ivec3 position) const {
+        const int chunkIndex = findChunkIndex(position);
+        return chunkIndex >= 0 && chunkIndex < static_cast<int>(m_chunks.size()) && m_chunks[chunkIndex].pending.test(getPendingBit(position));
+    }
+
+    void BlockTickScheduler::unloadChunk(const int chunkIndex) {
+        if (chunkIndex < 0 || chunkIndex >= static_cast<int>(m_world.getChunkCount())) {
+            return;
+        }
+
+        ChunkTicks& chunk = getChunkTicks(chunkIndex);
+
+        // Constant time whatever is pending, the entries themselves are left for advance() to skip
+        m_pendingCount -= chunk.pending.count();
+        chunk.pending.reset();
+        chunk.generation++;
+        chunk.unloaded = true;
+    }
+
+    void BlockTickScheduler::loadChunk(const int chunkIndex) {
+        if (chunkIndex >= 0 && chunkIndex < static_cast<int>(m_chunks.size())) {
+            m_chunks[chunkIndex].unloaded = false;
+        }
+    }
+
+    void BlockTickScheduler::insert(const Entry& entry) {
+        // The highest bit group where due and now differ picks the level
+        const uint64_t difference = entry.due ^ m_currentTick;
+
+        unsigned int level = 0;
+        while (level + 1 < TICK_WHEEL_LEVELS && difference >> (TICK_WHEEL_BITS * (level + 1)) != 0) {
+            level++;
+        }
+
+        const auto slot = static_cast<size_t>(entry.due >> (TICK_WHEEL_BITS * level) & (TICK_WHEEL_SLOTS - 1));
+        m_wheels[level][slot].push_back(entry);
+    }
+
+    void BlockTickScheduler::cascade(const unsigned int level) {
+        const auto slot = static_cast<size_t>(m_currentTick >> (TICK_WHEEL_BITS * level) & (TICK_WHEEL_SLOTS - 1));
+
+        m_scratch.clear();
+        std::swap(m_scratch, m_wheels[level][slot]);
+
+        for (const Entry& entry : m_scratch) {
+            if (isLive(entry)) {
+                insert(entry);
+            }
+        }
+    }
+
+    void BlockTickScheduler::advance(std::vector<glm::ivec3>& due) {
+        m_currentTick++;
+
+        // Outermost first, so a slot redistributed from level 2 can be redistributed again from level 1
+        for (unsigned int level = TICK_WHEEL_LEVELS - 1; level > 0; level--) {
+            if ((m_currentTick & ((1ull << (TICK_WHEEL_BITS * level)) - 1)) == 0) {
+                cascade(level);
+            }
+        }
+
+        m_scratch.clear();
+        std::swap(m_scratch, m_wheels[0][m_currentTick & (TICK_WHEEL_SLOTS - 1)]);
+
+        for (const Entry& entry : m_scratch) {
+            if (!isLive(entry)) {
+                continue;
+            }
+
+            m_chunks[entry.chunkIndex].pending.reset(getPendingBit(entry.position));
+            m_pendingCount--;
+
+            due.push_back(entry.position);
+        }
+    }
+
+    void BlockTickScheduler::sampleRandomTicks(const unsigned int count, std::vector<glm::ivec3>& positions) {
+        for (unsigned int index = 0; index < m_world.getChunkCount(); index++) {
+            if (index < m_chunks.size() && m_chunks[index].unloaded) {
+                continue;
+            }
+
+            const Chunk& chunk = m_world.getChunk(index);
+            const glm::ivec3 origin(chunk.getOrigin());
+
+            for (unsigned int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+                if (chunk.isSectionEmpty(section)) {
+                    continue;
+                }
+
+                // Nine bits pick a cell in the 8x8x8 section
+                for (unsigned int i = 0; i < count; i++) {
+                    const auto bits = static_cast<unsigned int>(m_random.next() >> 55);
+
+                    positions.push_back(origin + glm::ivec3(
+                        bits & (CHUNK_SIZE - 1),
+                        section * CHUNK_SECTION_HEIGHT + (bits >> 3 & (CHUNK_SECTION_HEIGHT - 1)),
+                        bits >> 6 & (CHUNK_SIZE - 1)
+                    ));
+                }
+            }
+        }
+    }
+
+    uint64_t BlockTickScheduler::getCurrentTick() const {
+        return m_currentTick;
+    }
+
+    size_t BlockTickScheduler::getPendingCount() const {
+        return m_pendingCount;
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "world.hpp"
+#include "random.hpp"
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+namespace minecraft::world {
+    constexpr unsigned int TICK_WHEEL_BITS = 8;
+    constexpr unsigned int TICK_WHEEL_SLOTS = 1u << TICK_WHEEL_BITS;
+    constexpr unsigned int TICK_WHEEL_LEVELS = 3;
+    // Longest delay the wheels hold, later ticks are clamped to it
+    constexpr uint64_t MAX_TICK_DELAY = (1ull << (TICK_WHEEL_BITS * TICK_WHEEL_LEVELS)) - 1;
+
+    // Minecraft's default randomTickSpeed
+    constexpr unsigned int RANDOM_TICKS_PER_SECTION = 3;
+
+    // Hierarchical timing wheel of pending block updates. Level 0 has a slot per tick, each higher level a slot
+    // per lap of the one below, and a higher slot is redistributed downwards when time reaches it.
+    // Each block holds at most one pending tick, tracked by a bit in its chunk, and unloading a chunk
+    // bumps its generation so its entries are dropped as they come due without being searched for
+    class BlockTickScheduler {
+    public:
+        explicit BlockTickScheduler(const World& world, uint64_t seed = 0);
+
+        // delay is at least one tick. False when the block already has a tick pending or its chunk isn't loaded
+        bool schedule(glm::ivec3 position, uint64_t delay);
+        [[nodiscard]]
+        bool isScheduled(glm::ivec3 position) const;
+
+        void unloadChunk(int chunkIndex);
+        void loadChunk(int chunkIndex);
+
+        // Moves to the next tick and appends every block due on it, in the order they were scheduled
+        void advance(std::vector<glm::ivec3>& due);
+        // Appends count random positions from each non empty section of every loaded chunk
+        void sampleRandomTicks(unsigned int count, std::vector<glm::ivec3>& positions);
+
+        [[nodiscard]]
+        uint64_t getCurrentTick() const;
+        [[nodiscard]]
+        size_t getPendingCount() const;
+
+    private:
+        struct Entry {
+            glm::ivec3 position;
+            int chunkIndex;
+            uint32_t generation;
+            uint64_t due;
+        };
+
+        struct ChunkTicks {
+            std::bitset<CHUNK_VOLUME> pending{};
+            uint32_t generation{};
+            bool unloaded{};
+        };
+
+        // -1 outside the generated area
+        [[nodiscard]]
+        int findChunkIndex(glm::ivec3 position) const;
+        static unsigned int getPendingBit(glm::ivec3 position);
+        ChunkTicks& getChunkTicks(int chunkIndex);
+        [[nodiscard]]
+        bool isLive(const Entry& entry) const;
+
+        void insert(const Entry& entry);
+        void cascade(unsigned int level);
+
+        const World& m_world;
+        std::vector<ChunkTicks> m_chunks{};
+
+        std::array<std::array<std::vector<Entry>, TICK_WHEEL_SLOTS>, TICK_WHEEL_LEVELS> m_wheels{};
+        std::vector<Entry> m_scratch{};
+
+        uint64_t m_currentTick{};
+        size_t m_pendingCount{};
+
+        system::Random m_random;
+    };
+}
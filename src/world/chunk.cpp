@@ -1,87 +1,160 @@
 #include "chunk.hpp"
+#include "profiler.hpp"
 
 #include <glad/glad.h>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 namespace minecraft::world {
 
+    system::LinearArena& Chunk::getMeshArena() {
+        // One per meshing thread, reset after every chunk and kept for the thread's lifetime
+        thread_local system::LinearArena arena(system::MemoryTag::GENERATION);
+        return arena;
+    }
+
     void Chunk::buildData() {
+        system::ProfileZone zone("Chunk::buildData");
 
         for (int y = 0; y < CHUNK_HEIGHT; y++) {
             for (int x = 0; x < CHUNK_SIZE; x++) {
                 for (int z = 0; z < CHUNK_SIZE; z++) {
 
                     const auto position = glm::ivec3(x, y, z);
-                    m_blocks[getBlockIndex(position)] = Block(BlockType::TEST);
+                    const int height = getTerrainHeight(
+                        m_position.x * static_cast<int>(CHUNK_SIZE) + x,
+                        m_position.y * static_cast<int>(CHUNK_SIZE) + z
+                    );
+
+                    m_blocks[getBlockIndex(position)] = y < height ? Block(BlockType::TEST) : Block();
                 }
             }
         }
+
+        updateSections();
+        m_dirtySections = (1u << CHUNK_SECTION_COUNT) - 1;
+        m_solidityChangedSections = m_dirtySections;
     }
 
-    bool Chunk::buildMesh() {
-        std::vector<primitive::Quad> quads{};
+    bool Chunk::buildMesh(const opengl::QuadIndexBuffer& quadIndices) {
+        system::ProfileZone zone("Chunk::buildMesh");
 
-        for (int y = 0; y < CHUNK_HEIGHT; y++) {
-            for (int x = 0; x < CHUNK_SIZE; x++) {
-                for (int z = 0; z < CHUNK_SIZE; z++) {
+        updateSections();
+        updateSectionVisibility();
+        m_dirtySections = 0;
+        m_solidityChangedSections = 0;
 
-                    const glm::ivec3 position(x, y, z);
-                    if (auto [current, left, down, back] = getAdjacentBlocks(position);
-                        current->solid()) {
-
-                        if (left->solid()) {
-                            loadQuad(quads, primitive::Direction::LEFT, position);
-                        }
-                        if (down->solid()) {
-                            loadQuad(quads, primitive::Direction::DOWN, position);
-                        }
-                        if (back->solid()) {
-                            loadQuad(quads, primitive::Direction::BACK, position);
-                        }
-                    }
-                    else {
-                        if (!left->solid()) {
-                            loadQuad(quads, primitive::Direction::RIGHT, position);
-                        }
-                        if (!down->solid()) {
-                            loadQuad(quads, primitive::Direction::UP, position);
-                        }
-                        if (!back->solid()) {
-                            loadQuad(quads, primitive::Direction::FRONT, position);
-                        }
-                    }
-                }
+        system::LinearArena& arena = getMeshArena();
+        const auto vertices = buildVertices(arena);
+
+        bool built = false;
+        if (vertices.empty()) {
+            std::cerr << "No quads to render!" << std::endl;
+        } else {
+            built = createBuffers(vertices, quadIndices);
+        }
+
+        arena.reset();
+        return built;
+    }
+
+    std::span<const primitive::Vertex> Chunk::buildVertices(system::LinearArena& arena) const {
+        // The worst case is reserved up front and written in place, the indices come from the shared quad index buffer
+        const auto vertices = arena.allocate<primitive::Vertex>(MAX_CHUNK_QUADS * primitive::QUAD_VERTEX_COUNT);
+        unsigned int quadCount = 0;
+
+        forEachVisibleFace([&](const primitive::Direction direction, const glm::ivec3 position, const Block&) {
+            const unsigned int directionID = primitive::getDirectionID(direction);
+            const unsigned int index = quadCount * primitive::QUAD_VERTEX_COUNT;
+
+            for (unsigned int i = 0; i < primitive::QUAD_VERTEX_COUNT; i++) {
+                vertices[index + i] = primitive::Vertex {
+                    glm::vec3(position) + primitive::QUAD_CORNERS[directionID][i],
+                    primitive::QUAD_TEX_COORDS[i],
+                    directionID,
+                };
             }
+
+            quadCount++;
+        });
+
+        return vertices.first(quadCount * primitive::QUAD_VERTEX_COUNT);
+    }
+
+    bool Chunk::buildFaces() {
+        system::ProfileZone zone("Chunk::buildFaces");
+
+        updateSections();
+        updateSectionVisibility();
+        m_faces.clear();
+        m_dirtySections = 0;
+        m_solidityChangedSections = 0;
+
+        for (unsigned int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            const int baseY = static_cast<int>(section * CHUNK_SECTION_HEIGHT);
+            m_sectionFaceOffsets[section] = static_cast<unsigned int>(m_faces.size());
+
+            forEachVisibleFace([&](const primitive::Direction direction, const glm::ivec3 position, const Block& block) {
+                m_faces.push_back(packBlockFace(direction, position, block));
+            }, baseY, baseY + static_cast<int>(CHUNK_SECTION_HEIGHT));
         }
 
-        if (quads.empty()) {
-            std::cerr << "No quads to render!" << std::endl;
+        m_sectionFaceOffsets[CHUNK_SECTION_COUNT] = static_cast<unsigned int>(m_faces.size());
+        return !m_faces.empty();
+    }
+
+    bool Chunk::rebuildDirtySections() {
+        if (m_dirtySections == 0) {
             return false;
         }
 
-        auto vertices = std::vector<primitive::Vertex>{};
-        auto indices = std::vector<unsigned int>{};
+        system::ProfileZone zone("Chunk::rebuildDirtySections");
+
+        if (m_solidityChangedSections != 0) {
+            updateSections();
+        }
+
+        system::LinearArena& arena = getMeshArena();
+        const auto sectionFaces = arena.allocate<primitive::PackedFace>(MAX_SECTION_QUADS);
 
-        unsigned int index = 0;
-        for (const auto& quad : quads) {
-            for (int i = 0; i < 4; i++) {
-                vertices.push_back(primitive::Vertex {
-                    quad.vertices[i],
-                    quad.texCoord[i],
-                    primitive::getDirectionID(quad.direction),
-                });
+        for (unsigned int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            if ((m_dirtySections >> section & 1u) == 0) {
+                continue;
             }
 
-            const auto nextIndices = {
-                index, index + 1, index + 2,
-                index, index + 2, index + 3,
-            };
+            if (m_solidityChangedSections >> section & 1u) {
+                m_sectionVisibility[section] = computeSectionVisibility(section);
+            }
+
+            const int baseY = static_cast<int>(section * CHUNK_SECTION_HEIGHT);
+            unsigned int faceCount = 0;
+
+            forEachVisibleFace([&](const primitive::Direction direction, const glm::ivec3 position, const Block& block) {
+                sectionFaces[faceCount++] = packBlockFace(direction, position, block);
+            }, baseY, baseY + static_cast<int>(CHUNK_SECTION_HEIGHT));
+
+            // Overwrite the section's run in place, growing or shrinking it shifts the runs above
+            const unsigned int first = m_sectionFaceOffsets[section];
+            const unsigned int oldCount = m_sectionFaceOffsets[section + 1] - first;
+            const unsigned int kept = std::min(faceCount, oldCount);
 
-            indices.insert(indices.end(), nextIndices);
-            index += 4;
+            std::copy_n(sectionFaces.begin(), kept, m_faces.begin() + first);
+            if (faceCount > oldCount) {
+                m_faces.insert(m_faces.begin() + first + kept, sectionFaces.begin() + kept, sectionFaces.begin() + faceCount);
+            } else {
+                m_faces.erase(m_faces.begin() + first + kept, m_faces.begin() + first + oldCount);
+            }
+
+            for (unsigned int above = section + 1; above <= CHUNK_SECTION_COUNT; above++) {
+                m_sectionFaceOffsets[above] = m_sectionFaceOffsets[above] + faceCount - oldCount;
+            }
         }
 
-        return createBuffers(vertices, indices);
+        arena.reset();
+        m_dirtySections = 0;
+        m_solidityChangedSections = 0;
+        return true;
     }
 
     void Chunk::draw() const {
@@ -90,11 +163,93 @@ namespace minecraft::world {
         glBindVertexArray(0);
     }
 
+    const ChunkFaces& Chunk::getFaces() const {
+        return m_faces;
+    }
+
+    bool Chunk::isSectionSolid(const unsigned int section) const {
+        return m_solidSections[section];
+    }
+
+    bool Chunk::isSectionEmpty(const unsigned int section) const {
+        return m_emptySections[section];
+    }
+
+    const Block& Chunk::getLocalBlock(const glm::ivec3 position) const {
+        return m_blocks[getBlockIndex(position)];
+    }
+
+    void Chunk::setLocalBlock(const glm::ivec3 position, const Block block) {
+        Block& current = m_blocks[getBlockIndex(position)];
+        const unsigned int section = position.y / CHUNK_SECTION_HEIGHT;
+
+        if (current.solid() != block.solid()) {
+            m_solidityChangedSections |= 1u << section;
+        }
+
+        current = block;
+
+        // The face between the top row of a section and the one above belongs to the section above
+        m_dirtySections |= 1u << section;
+
+        if ((position.y + 1) % CHUNK_SECTION_HEIGHT == 0 && section + 1 < CHUNK_SECTION_COUNT) {
+            m_dirtySections |= 1u << (section + 1);
+        }
+    }
+
+    void Chunk::markSectionDirty(const unsigned int section) {
+        m_dirtySections |= 1u << section;
+    }
+
+    void Chunk::setNeighbours(const Chunk* left, const Chunk* back) {
+        m_leftNeighbour = left;
+        m_backNeighbour = back;
+    }
+
+    unsigned int Chunk::getDirtySections() const {
+        return m_dirtySections;
+    }
+
+    SectionVisibility Chunk::getSectionVisibility(const unsigned int section) const {
+        return m_sectionVisibility[section];
+    }
+
+    glm::vec3 Chunk::getOrigin() const {
+        return glm::vec3(
+            static_cast<float>(m_position.x * static_cast<int>(CHUNK_SIZE)),
+            0.0f,
+            static_cast<float>(m_position.y * static_cast<int>(CHUNK_SIZE))
+        );
+    }
+
+    glm::ivec2 Chunk::getPosition() const {
+        return m_position;
+    }
+
+    int Chunk::getTerrainHeight(const int worldX, const int worldZ) {
+        const auto fx = static_cast<float>(worldX);
+        const auto fz = static_cast<float>(worldZ);
+
+        const float height = TERRAIN_BASE_HEIGHT
+            + std::sin(fx * 0.11f) * std::cos(fz * 0.07f) * TERRAIN_AMPLITUDE
+            + std::sin((fx + fz) * 0.03f) * TERRAIN_AMPLITUDE * 0.5f;
+
+        return std::clamp(static_cast<int>(height), 1, static_cast<int>(CHUNK_HEIGHT) - 1);
+    }
+
     const Block* Chunk::getBlock(glm::ivec3 position) const {
+        // Faces only ever look one cell past the min x and z planes
+        if (position.x < 0 && m_leftNeighbour) {
+            return &m_leftNeighbour->getLocalBlock(glm::ivec3(position.x + static_cast<int>(CHUNK_SIZE), position.y, position.z));
+        }
+        if (position.z < 0 && m_backNeighbour) {
+            return &m_backNeighbour->getLocalBlock(glm::ivec3(position.x, position.y, position.z + static_cast<int>(CHUNK_SIZE)));
+        }
+
         while (position.x < 0) { position.x += 1; }
         while (position.x > CHUNK_SIZE - 1) { position.x -= 1; }
         while (position.y < 0) { position.y += 1; }
-        while (position.y > CHUNK_SIZE - 1) { position.y -= 1; }
+        while (position.y > static_cast<int>(CHUNK_HEIGHT) - 1) { position.y -= 1; }
         while (position.z < 0) { position.z += 1; }
         while (position.z > CHUNK_SIZE - 1) { position.z -= 1; }
 
@@ -103,22 +258,21 @@ namespace minecraft::world {
 
     glm::ivec3 Chunk::getBlockPosition(const unsigned int index) {
         const glm::ivec3 position {
-            static_cast<int>(static_cast<float>(index) / static_cast<float>(CHUNK_SIZE * CHUNK_SIZE)),
-            static_cast<int>(std::fmodf(
-                    static_cast<float>(index) / static_cast<float>(CHUNK_SIZE),
-                    static_cast<float>(CHUNK_SIZE)
-              )),
-            static_cast<int>(std::fmodf(
-                static_cast<float>(index),
-                static_cast<float>(CHUNK_HEIGHT)
-            )),
+            static_cast<int>((index >> CHUNK_SIZE_BIT_OFFSET) & (CHUNK_SIZE - 1)),
+            static_cast<int>(index >> (2 * CHUNK_SIZE_BIT_OFFSET)),
+            static_cast<int>(index & (CHUNK_SIZE - 1)),
         };
 
         return position;
     }
 
+    primitive::PackedFace Chunk::packBlockFace(const primitive::Direction direction, const glm::ivec3 position, const Block& block) {
+        const unsigned int layer = block.getType() - 1;
+        return primitive::packFace(position, direction, layer, primitive::MAX_FACE_LIGHT);
+    }
+
     unsigned int Chunk::getBlockIndex(const glm::ivec3 position) {
-        const unsigned int idx =  position.z | position.y << CHUNK_SIZE_BIT_OFFSET | position.x << (2 * CHUNK_SIZE_BIT_OFFSET);
+        const unsigned int idx =  position.z | position.x << CHUNK_SIZE_BIT_OFFSET | position.y << (2 * CHUNK_SIZE_BIT_OFFSET);
         return idx;
     }
 
@@ -126,9 +280,103 @@ namespace minecraft::world {
         : m_position(position) {}
 
     Chunk::~Chunk() {
+        if (m_vertexArray == 0) {
+            return;
+        }
+
         glDeleteVertexArrays(1, &m_vertexArray);
         glDeleteBuffers(1, &m_vertexBuffer);
-        glDeleteBuffers(1, &m_indexBuffer);
+    }
+
+    void Chunk::updateSections() {
+        constexpr unsigned int sectionVolume = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SECTION_HEIGHT;
+
+        // Blocks are stored y-major, so each section is one contiguous run
+        for (unsigned int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            const auto begin = m_blocks.begin() + section * sectionVolume;
+
+            m_solidSections[section] = std::all_of(begin, begin + sectionVolume, [](const Block& block) {
+                return block.solid();
+            });
+            m_emptySections[section] = std::none_of(begin, begin + sectionVolume, [](const Block& block) {
+                return block.solid();
+            });
+        }
+    }
+
+    void Chunk::updateSectionVisibility() {
+        for (unsigned int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            m_sectionVisibility[section] = computeSectionVisibility(section);
+        }
+    }
+
+    SectionVisibility Chunk::computeSectionVisibility(const unsigned int section) const {
+        constexpr int sectionVolume = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SECTION_HEIGHT;
+        const int baseY = static_cast<int>(section * CHUNK_SECTION_HEIGHT);
+
+        if (m_solidSections[section]) {
+            return SectionVisibility{};
+        }
+
+        const auto getCellIndex = [](const glm::ivec3 cell) {
+            return (cell.y * CHUNK_SIZE + cell.x) * CHUNK_SIZE + cell.z;
+        };
+
+        SectionVisibility visibility{};
+        std::array<bool, sectionVolume> visited{};
+        std::array<glm::ivec3, sectionVolume> queue{};
+
+        for (int start = 0; start < sectionVolume; start++) {
+            const glm::ivec3 startCell(start / CHUNK_SIZE % CHUNK_SIZE, start / (CHUNK_SIZE * CHUNK_SIZE), start % CHUNK_SIZE);
+            if (visited[start] || getBlock(startCell + glm::ivec3(0, baseY, 0))->solid()) {
+                continue;
+            }
+
+            unsigned int touchedFaces = 0;
+            int head = 0, tail = 0;
+
+            visited[start] = true;
+            queue[tail++] = startCell;
+
+            // Flood fill one open region and record every section face it reaches
+            while (head < tail) {
+                const glm::ivec3 cell = queue[head++];
+
+                for (unsigned int id = 0; id < primitive::DIRECTION_COUNT; id++) {
+                    const auto direction = static_cast<primitive::Direction>(id);
+                    const glm::ivec3 next = cell + primitive::getDirectionOffset(direction);
+
+                    if (next.x < 0 || next.x >= static_cast<int>(CHUNK_SIZE) ||
+                        next.y < 0 || next.y >= static_cast<int>(CHUNK_SECTION_HEIGHT) ||
+                        next.z < 0 || next.z >= static_cast<int>(CHUNK_SIZE)) {
+                        touchedFaces |= 1u << id;
+                        continue;
+                    }
+
+                    const int nextIndex = getCellIndex(next);
+                    if (visited[nextIndex] || getBlock(next + glm::ivec3(0, baseY, 0))->solid()) {
+                        continue;
+                    }
+
+                    visited[nextIndex] = true;
+                    queue[tail++] = next;
+                }
+            }
+
+            for (unsigned int a = 0; a < primitive::DIRECTION_COUNT; a++) {
+                for (unsigned int b = a + 1; b < primitive::DIRECTION_COUNT; b++) {
+                    if ((touchedFaces >> a & 1u) && (touchedFaces >> b & 1u)) {
+                        visibility.connect(static_cast<primitive::Direction>(a), static_cast<primitive::Direction>(b));
+                    }
+                }
+            }
+
+            if (visibility.getMask() == SectionVisibility::ALL_VISIBLE) {
+                break;
+            }
+        }
+
+        return visibility;
     }
 
     std::array<const Block*, 4> Chunk::getAdjacentBlocks(const glm::ivec3 position) const {
@@ -142,33 +390,22 @@ namespace minecraft::world {
         return adjacentBlocks;
     }
 
-    void Chunk::loadQuad(
-        std::vector<primitive::Quad> &quads,
-        const primitive::Direction direction,
-        const glm::ivec3 position
-    ) const {
+    bool Chunk::createBuffers(const std::span<const primitive::Vertex> vertices, const opengl::QuadIndexBuffer& quadIndices) {
+        system::ProfileZone zone("Chunk::createBuffers");
 
-        if (const Block* block = getBlock(position); !block->solid()) {
-            return;
+        // A rebuilt chunk refills the buffers it already has
+        if (m_vertexArray == 0) {
+            glGenVertexArrays(1, &m_vertexArray);
+            glGenBuffers(1, &m_vertexBuffer);
         }
 
-        const auto quad = primitive::Quad{ direction, position };
-        quads.push_back(quad);
-    }
-
-    bool Chunk::createBuffers(const std::vector<primitive::Vertex> &vertices, const std::vector<unsigned int> &indices) {
-        glGenVertexArrays(1, &m_vertexArray);
-        glGenBuffers(1, &m_vertexBuffer);
-        glGenBuffers(1, &m_indexBuffer);
-
         glBindVertexArray(m_vertexArray);
         constexpr auto vertexSize = sizeof(primitive::Vertex);
 
         glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
         glBufferData(GL_ARRAY_BUFFER, vertices.size() * vertexSize, vertices.data(), GL_STATIC_DRAW);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        quadIndices.bind();
 
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, vertexSize, nullptr);
@@ -182,7 +419,8 @@ namespace minecraft::world {
         glBindVertexArray(0);
 
         m_vertexCount = vertices.size();
-        m_indexCount = indices.size();
+        m_indexCount = vertices.size() / primitive::QUAD_VERTEX_COUNT * primitive::QUAD_INDEX_COUNT;
+        m_meshMemory.set(vertices.size() * vertexSize);
 
         return m_indexCount != 0;
     }
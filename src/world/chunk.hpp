@@ -2,9 +2,15 @@
 
 #include "vertex.hpp"
 #include "quad.hpp"
+#include "packed_face.hpp"
 #include "block.hpp"
+#include "section_visibility.hpp"
+#include "quad_index_buffer.hpp"
+#include "memory_tracker.hpp"
+#include "linear_arena.hpp"
 #include <vector>
 #include <array>
+#include <span>
 
 namespace minecraft::world {
     constexpr unsigned int CHUNK_SIZE = 8;
@@ -13,40 +19,145 @@ namespace minecraft::world {
 
     const unsigned int CHUNK_SIZE_BIT_OFFSET = static_cast<unsigned int>(std::log2f(static_cast<float>(CHUNK_SIZE)));
 
+    constexpr unsigned int CHUNK_SECTION_HEIGHT = CHUNK_SIZE;
+    constexpr unsigned int CHUNK_SECTION_COUNT = CHUNK_HEIGHT / CHUNK_SECTION_HEIGHT;
+
+    // Every cell owns at most three faces
+    constexpr unsigned int MAX_CHUNK_QUADS = CHUNK_VOLUME * 3;
+    constexpr unsigned int MAX_SECTION_QUADS = MAX_CHUNK_QUADS / CHUNK_SECTION_COUNT;
+
+    constexpr float TERRAIN_BASE_HEIGHT = 14.0f;
+    constexpr float TERRAIN_AMPLITUDE = 8.0f;
+
+    using ChunkFaces = system::TrackedVector<primitive::PackedFace, system::MemoryTag::MESHES>;
+    template <typename T>
+    using MeshScratch = system::TrackedVector<T, system::MemoryTag::GENERATION>;
+
     class Chunk {
     public:
         explicit Chunk(glm::ivec2 position);
         ~Chunk();
 
         void buildData();
-        bool buildMesh();
+        bool buildMesh(const opengl::QuadIndexBuffer& quadIndices);
+        // The CPU half of buildMesh, four vertices per visible face living in arena until its next reset
+        [[nodiscard]]
+        std::span<const primitive::Vertex> buildVertices(system::LinearArena& arena) const;
+        bool buildFaces();
+        // Refaces only the sections setLocalBlock touched since the last build, false when there were none
+        bool rebuildDirtySections();
+        // The shader's chunkOrigin must already hold getOrigin()
         void draw() const;
 
+        [[nodiscard]]
+        glm::vec3 getOrigin() const;
+        [[nodiscard]]
+        glm::ivec2 getPosition() const;
+        [[nodiscard]]
+        const ChunkFaces& getFaces() const;
+        [[nodiscard]]
+        bool isSectionSolid(unsigned int section) const;
+        [[nodiscard]]
+        bool isSectionEmpty(unsigned int section) const;
+        // Position must lie inside the chunk
+        [[nodiscard]]
+        const Block& getLocalBlock(glm::ivec3 position) const;
+        // Marks the sections whose faces the block takes part in as dirty
+        void setLocalBlock(glm::ivec3 position, Block block);
+        // For a neighbour's border block changing, which only moves faces on this chunk's min planes
+        void markSectionDirty(unsigned int section);
+        // The chunks across the min x and z planes, faces on those planes look into them. Null at the world's
+        // edge, where the border cells stand in for their missing neighbours and no faces are emitted
+        void setNeighbours(const Chunk* left, const Chunk* back);
+        // One bit per section
+        [[nodiscard]]
+        unsigned int getDirtySections() const;
+        [[nodiscard]]
+        SectionVisibility getSectionVisibility(unsigned int section) const;
+
+        static int getTerrainHeight(int worldX, int worldZ);
+        // Scratch memory for buildMesh on the calling thread
+        static system::LinearArena& getMeshArena();
+
     private:
         [[nodiscard]]
         const Block* getBlock(glm::ivec3 position) const;
         [[nodiscard]]
         std::array<const Block*, 4> getAdjacentBlocks(glm::ivec3 position) const;
 
+        void updateSections();
+        void updateSectionVisibility();
+        [[nodiscard]]
+        SectionVisibility computeSectionVisibility(unsigned int section) const;
+
         static unsigned int getBlockIndex(glm::ivec3 position);
         static glm::ivec3 getBlockPosition(unsigned int index);
+        static primitive::PackedFace packBlockFace(primitive::Direction direction, glm::ivec3 position, const Block& block);
+
+        // Faces in rows firstY to endY, emitted in y order
+        template<typename Emit>
+        void forEachVisibleFace(Emit&& emit, int firstY = 0, int endY = CHUNK_HEIGHT) const;
 
-        void loadQuad(
-            std::vector<primitive::Quad>& quads, primitive::Direction direction, glm::ivec3 position
-        ) const;
-        bool createBuffers(const std::vector<primitive::Vertex>& vertices, const std::vector<unsigned int>& indices);
+        bool createBuffers(std::span<const primitive::Vertex> vertices, const opengl::QuadIndexBuffer& quadIndices);
 
         glm::ivec2 m_position{};
+        const Chunk* m_leftNeighbour{};
+        const Chunk* m_backNeighbour{};
         std::array<Block, CHUNK_VOLUME> m_blocks{};
+        system::MemoryReservation m_blockMemory{system::MemoryTag::BLOCKS, sizeof(m_blocks)};
+        std::array<bool, CHUNK_SECTION_COUNT> m_solidSections{};
+        std::array<bool, CHUNK_SECTION_COUNT> m_emptySections{};
+        std::array<SectionVisibility, CHUNK_SECTION_COUNT> m_sectionVisibility{};
 
-        std::vector<primitive::Vertex> m_vertices{};
-        std::vector<unsigned int> m_indices{};
+        ChunkFaces m_faces{};
+        // Faces of section i are m_faces[m_sectionFaceOffsets[i], m_sectionFaceOffsets[i + 1])
+        std::array<unsigned int, CHUNK_SECTION_COUNT + 1> m_sectionFaceOffsets{};
+        unsigned int m_dirtySections{};
+        // Sections where a block became or stopped being solid, the only change that affects visibility
+        unsigned int m_solidityChangedSections{};
+        system::MemoryReservation m_meshMemory{system::MemoryTag::GPU_BUFFERS};
 
         unsigned int m_vertexBuffer{};
-        unsigned int m_indexBuffer{};
         unsigned int m_vertexArray{};
 
         int m_vertexCount{};
         int m_indexCount{};
     };
+
+    // Faces lie on the min planes of each cell, owned by whichever side is visible
+    template<typename Emit>
+    void Chunk::forEachVisibleFace(Emit&& emit, const int firstY, const int endY) const {
+        for (int y = firstY; y < endY; y++) {
+            for (int x = 0; x < static_cast<int>(CHUNK_SIZE); x++) {
+                for (int z = 0; z < static_cast<int>(CHUNK_SIZE); z++) {
+
+                    const glm::ivec3 position(x, y, z);
+                    if (auto [current, left, down, back] = getAdjacentBlocks(position);
+                        current->visible()) {
+
+                        if (!left->visible()) {
+                            emit(primitive::Direction::LEFT, position, *current);
+                        }
+                        if (!down->visible()) {
+                            emit(primitive::Direction::DOWN, position, *current);
+                        }
+                        if (!back->visible()) {
+                            emit(primitive::Direction::BACK, position, *current);
+                        }
+                    }
+                    else {
+                        if (left->visible()) {
+                            emit(primitive::Direction::RIGHT, position, *left);
+                        }
+                        if (down->visible()) {
+                            emit(primitive::Direction::UP, position, *down);
+                        }
+                        if (back->visible()) {
+                            emit(primitive::Direction::FRONT, position, *back);
+                        }
+                    }
+                }
+            }
+        }
+    }
 }
@@ -0,0 +1,113 @@
+#include "entities.hpp"
+
+namespace minecraft::world {
+
+    namespace {
+        template <typename Fn>
+        void forEachComponentArray(Archetype& archetype, Fn&& fn) {
+            fn(archetype.Entities);
+            fn(archetype.Transforms);
+            fn(archetype.Velocities);
+            fn(archetype.Colliders);
+            fn(archetype.Renderables);
+        }
+    }
+
+    Entity EntityRegistry::create(const ComponentMask mask) {
+        uint32_t index;
+        if (!m_freeIndices.empty()) {
+            index = m_freeIndices.back();
+            m_freeIndices.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_locations.size());
+            m_locations.push_back(Location { NO_ARCHETYPE, 0, 0 });
+        }
+
+        const uint32_t archetypeIndex = findArchetype(mask);
+        Archetype& archetype = m_archetypes[archetypeIndex];
+        Location& location = m_locations[index];
+
+        location.archetype = archetypeIndex;
+        location.row = static_cast<uint32_t>(archetype.size());
+
+        const Entity entity { index, location.generation };
+        archetype.Entities.push_back(entity);
+
+        if (mask & COMPONENT_TRANSFORM) {
+            archetype.Transforms.emplace_back();
+        }
+        if (mask & COMPONENT_VELOCITY) {
+            archetype.Velocities.emplace_back();
+        }
+        if (mask & COMPONENT_COLLIDER) {
+            archetype.Colliders.emplace_back();
+        }
+        if (mask & COMPONENT_RENDERABLE) {
+            archetype.Renderables.emplace_back();
+        }
+
+        m_entityCount++;
+        return entity;
+    }
+
+    bool EntityRegistry::destroy(const Entity entity) {
+        if (!isAlive(entity)) {
+            return false;
+        }
+
+        Location& location = m_locations[entity.index];
+        Archetype& archetype = m_archetypes[location.archetype];
+        const size_t last = archetype.size() - 1;
+
+        if (location.row != last) {
+            const Entity moved = archetype.Entities[last];
+
+            forEachComponentArray(archetype, [&](auto& components) {
+                if (!components.empty()) {
+                    components[location.row] = components[last];
+                }
+            });
+
+            m_locations[moved.index].row = location.row;
+        }
+
+        forEachComponentArray(archetype, [](auto& components) {
+            if (!components.empty()) {
+                components.pop_back();
+            }
+        });
+
+        location.archetype = NO_ARCHETYPE;
+        location.generation++;
+        m_freeIndices.push_back(entity.index);
+
+        m_entityCount--;
+        return true;
+    }
+
+    bool EntityRegistry::isAlive(const Entity entity) const {
+        return entity.index < m_locations.size()
+            && m_locations[entity.index].archetype != NO_ARCHETYPE
+            && m_locations[entity.index].generation == entity.generation;
+    }
+
+    size_t EntityRegistry::getEntityCount() const {
+        return m_entityCount;
+    }
+
+    const std::vector<Archetype>& EntityRegistry::getArchetypes() const {
+        return m_archetypes;
+    }
+
+    uint32_t EntityRegistry::findArchetype(const ComponentMask mask) {
+        // A handful of component sets at most, so a scan beats hashing
+        for (uint32_t i = 0; i < m_archetypes.size(); i++) {
+            if (m_archetypes[i].Mask == mask) {
+                return i;
+            }
+        }
+
+        m_archetypes.push_back(Archetype { mask });
+        return static_cast<uint32_t>(m_archetypes.size() - 1);
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "memory_tracker.hpp"
+#include "worker_pool.hpp"
+
+#include <glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace minecraft::world {
+    // Rows of one archetype handed to a worker at a time
+    constexpr size_t ENTITY_BATCH_SIZE = 4096;
+
+    struct Transform {
+        glm::vec3 Position{};
+        // Degrees, as PlayerCamera::getYaw
+        float Yaw{};
+    };
+
+    struct Velocity {
+        glm::vec3 Linear{};
+    };
+
+    // Box with the same layout as PhysicsBody, centred on Position in x and z with Position.y at its base
+    struct Collider {
+        glm::vec3 HalfExtents{};
+        bool OnGround{};
+    };
+
+    struct Renderable {
+        unsigned int Layer{};
+        float Scale = 1.0f;
+    };
+
+    using ComponentMask = uint32_t;
+    constexpr ComponentMask COMPONENT_TRANSFORM = 1u << 0;
+    constexpr ComponentMask COMPONENT_VELOCITY = 1u << 1;
+    constexpr ComponentMask COMPONENT_COLLIDER = 1u << 2;
+    constexpr ComponentMask COMPONENT_RENDERABLE = 1u << 3;
+
+    // Stale once destroyed, the slot's generation moves on
+    struct Entity {
+        uint32_t index;
+        uint32_t generation;
+
+        bool operator==(const Entity&) const = default;
+    };
+
+    template <typename T>
+    using EntityComponents = system::TrackedVector<T, system::MemoryTag::ENTITIES>;
+
+    // Every entity with exactly one set of components. Each component is its own densely packed array, row i of
+    // every array belongs to Entities[i], and the arrays for components outside Mask stay empty
+    struct Archetype {
+        ComponentMask Mask{};
+        EntityComponents<Entity> Entities{};
+        EntityComponents<Transform> Transforms{};
+        EntityComponents<Velocity> Velocities{};
+        EntityComponents<Collider> Colliders{};
+        EntityComponents<Renderable> Renderables{};
+
+        template <typename T>
+        EntityComponents<T>& getComponents() {
+            if constexpr (std::is_same_v<T, Transform>) {
+                return Transforms;
+            } else if constexpr (std::is_same_v<T, Velocity>) {
+                return Velocities;
+            } else if constexpr (std::is_same_v<T, Collider>) {
+                return Colliders;
+            } else {
+                static_assert(std::is_same_v<T, Renderable>, "Not a component");
+                return Renderables;
+            }
+        }
+
+        [[nodiscard]]
+        size_t size() const {
+            return Entities.size();
+        }
+    };
+
+    // Entities grouped into archetypes by their component set, so a system only walks the arrays it uses
+    class EntityRegistry {
+    public:
+        // Components start default initialised
+        Entity create(ComponentMask mask);
+        // The last row of the archetype fills the hole, so rows move but arrays stay dense
+        bool destroy(Entity entity);
+
+        [[nodiscard]]
+        bool isAlive(Entity entity) const;
+        [[nodiscard]]
+        size_t getEntityCount() const;
+        [[nodiscard]]
+        const std::vector<Archetype>& getArchetypes() const;
+
+        // Null when the entity is dead or lacks the component. Invalidated by create and destroy
+        template <typename T>
+        T* get(Entity entity);
+
+        // Calls work(archetype, begin, end) for runs of at most ENTITY_BATCH_SIZE rows, over every archetype with
+        // all of required and none of excluded, spread across the worker pool. Runs never overlap, so work may
+        // write the rows it was given but mustn't create or destroy entities
+        template <typename Work>
+        void forEachBatch(ComponentMask required, ComponentMask excluded, Work&& work);
+
+    private:
+        struct Location {
+            uint32_t archetype;
+            uint32_t row;
+            uint32_t generation;
+        };
+
+        static constexpr uint32_t NO_ARCHETYPE = UINT32_MAX;
+
+        uint32_t findArchetype(ComponentMask mask);
+
+        std::vector<Archetype> m_archetypes{};
+        std::vector<Location> m_locations{};
+        std::vector<uint32_t> m_freeIndices{};
+        size_t m_entityCount{};
+    };
+
+    template <typename T>
+    T* EntityRegistry::get(const Entity entity) {
+        if (!isAlive(entity)) {
+            return nullptr;
+        }
+
+        const Location& location = m_locations[entity.index];
+        auto& components = m_archetypes[location.archetype].getComponents<T>();
+        return components.empty() ? nullptr : &components[location.row];
+    }
+
+    template <typename Work>
+    void EntityRegistry::forEachBatch(const ComponentMask required, const ComponentMask excluded, Work&& work) {
+        struct Batch {
+            Archetype* archetype;
+            size_t begin;
+            size_t end;
+        };
+
+        std::vector<Batch> batches{};
+
+        for (Archetype& archetype : m_archetypes) {
+            if ((archetype.Mask & required) != required || (archetype.Mask & excluded) != 0) {
+                continue;
+            }
+
+            for (size_t begin = 0; begin < archetype.size(); begin += ENTITY_BATCH_SIZE) {
+                batches.push_back(Batch { &archetype, begin, std::min(archetype.size(), begin + ENTITY_BATCH_SIZE) });
+            }
+        }
+
+        system::WorkerPool::get().parallelFor(batches.size(), [&](const size_t batch) {
+            work(*batches[batch].archetype, batches[batch].begin, batches[batch].end);
+        });
+    }
+}
@@ -0,0 +1,38 @@
+#include "entity_systems.hpp"
+#include "profiler.hpp"
+
+namespace minecraft::world {
+
+    void runMovementSystem(EntityRegistry& registry, const float timestep) {
+        system::ProfileZone zone("runMovementSystem");
+
+        registry.forEachBatch(COMPONENT_TRANSFORM | COMPONENT_VELOCITY, COMPONENT_COLLIDER, [timestep](Archetype& archetype, const size_t begin, const size_t end) {
+            Transform* transforms = archetype.Transforms.data();
+            const Velocity* velocities = archetype.Velocities.data();
+
+            for (size_t row = begin; row < end; row++) {
+                transforms[row].Position += velocities[row].Linear * timestep;
+            }
+        });
+    }
+
+    void runPhysicsSystem(const World& world, EntityRegistry& registry, const float timestep) {
+        system::ProfileZone zone("runPhysicsSystem");
+
+        // The world is only read, so batches share it without locking
+        registry.forEachBatch(COMPONENT_TRANSFORM | COMPONENT_VELOCITY | COMPONENT_COLLIDER, 0, [&world, timestep](Archetype& archetype, const size_t begin, const size_t end) {
+            for (size_t row = begin; row < end; row++) {
+                Transform& transform = archetype.Transforms[row];
+                Velocity& velocity = archetype.Velocities[row];
+                Collider& collider = archetype.Colliders[row];
+
+                PhysicsBody body { transform.Position, velocity.Linear, collider.HalfExtents, collider.OnGround };
+                stepBody(world, body, timestep);
+
+                transform.Position = body.Position;
+                velocity.Linear = body.Velocity;
+                collider.OnGround = body.OnGround;
+            }
+        });
+    }
+}
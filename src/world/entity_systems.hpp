@@ -0,0 +1,12 @@
+#pragma once
+
+#include "entities.hpp"
+#include "physics.hpp"
+
+namespace minecraft::world {
+
+    // Integrates velocity into position for entities without a Collider, anything with one is left to runPhysicsSystem
+    void runMovementSystem(EntityRegistry& registry, float timestep);
+    // Steps every entity with a Collider against the block grid through stepBody
+    void runPhysicsSystem(const World& world, EntityRegistry& registry, float timestep);
+}
@@ -0,0 +1,178 @@
+#include "fluids.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace minecraft::world {
+
+    namespace {
+        constexpr std::array HORIZONTAL_DIRECTIONS {
+            primitive::Direction::RIGHT,
+            primitive::Direction::LEFT,
+            primitive::Direction::FRONT,
+            primitive::Direction::BACK,
+        };
+
+        uint64_t getTickDelay(const BlockType type) {
+            return type == BlockType::LAVA ? LAVA_TICK_DELAY : WATER_TICK_DELAY;
+        }
+    }
+
+    FluidSimulation::FluidSimulation(World& world, BlockTickScheduler& ticks)
+        : m_world(world), m_ticks(ticks) {}
+
+    bool FluidSimulation::addFluid(const glm::ivec3 position, const BlockType type, const unsigned int level) {
+        const Block* block = m_world.getBlock(position);
+        if (!block || block->visible() || level == 0) {
+            return false;
+        }
+
+        m_world.setBlock(position, Block(type, std::min(level, FLUID_MAX_LEVEL)));
+        m_ticks.schedule(position, getTickDelay(type));
+        return true;
+    }
+
+    void FluidSimulation::update(const std::span<const glm::ivec3> due) {
+        m_cells.clear();
+
+        for (const glm::ivec3 position : due) {
+            if (const Block* block = m_world.getBlock(position); block && block->fluid()) {
+                m_cells.push_back(position);
+            }
+        }
+
+        if (m_cells.empty()) {
+            return;
+        }
+
+        system::ProfileZone zone("FluidSimulation::update");
+
+        m_changed.clear();
+
+        addVerticalFlows();
+        applyFlows();
+        addHorizontalFlows();
+        applyFlows();
+
+        // A cell changes once per flow it's part of, but only needs its neighbours woken once
+        std::sort(m_changed.begin(), m_changed.end(), [](const glm::ivec3 a, const glm::ivec3 b) {
+            return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+        });
+        m_changed.erase(std::unique(m_changed.begin(), m_changed.end()), m_changed.end());
+
+        // Cells that settled drop out here, anything next to a change gets another look
+        for (const glm::ivec3 position : m_changed) {
+            scheduleAround(position);
+        }
+
+        m_cellsUpdated += m_cells.size();
+    }
+
+    const Block* FluidSimulation::getFlowTarget(const glm::ivec3 position, const BlockType type) const {
+        const Block* block = m_world.getBlock(position);
+        if (!block || block->solid()) {
+            return nullptr;
+        }
+
+        if (block->fluid()) {
+            return block->getBlockType() == type ? block : nullptr;
+        }
+
+        // Both sides of a flow read the same levels, so two fluids can't both claim this cell in one step
+        for (const primitive::Direction direction : HORIZONTAL_DIRECTIONS) {
+            const Block* neighbour = m_world.getBlock(position + primitive::getDirectionOffset(direction));
+            if (neighbour && neighbour->fluid() && neighbour->getBlockType() != type) {
+                return nullptr;
+            }
+        }
+
+        const Block* above = m_world.getBlock(position + glm::ivec3(0, 1, 0));
+        return !above || !above->fluid() || above->getBlockType() == type ? block : nullptr;
+    }
+
+    void FluidSimulation::addVerticalFlows() {
+        // Each cell only takes from the one above it, so as much as fits can fall
+        for (const glm::ivec3 position : m_cells) {
+            const Block& block = *m_world.getBlock(position);
+            const glm::ivec3 below = position - glm::ivec3(0, 1, 0);
+
+            const Block* target = getFlowTarget(below, block.getBlockType());
+            if (!target) {
+                continue;
+            }
+
+            const unsigned int amount = std::min(block.getLevel(), FLUID_MAX_LEVEL - target->getLevel());
+            if (amount > 0) {
+                m_flows.push_back(Flow { position, below, block.getBlockType(), amount });
+            }
+        }
+    }
+
+    void FluidSimulation::addHorizontalFlows() {
+        for (const glm::ivec3 position : m_cells) {
+            const Block& block = *m_world.getBlock(position);
+
+            // Drained by its fall
+            if (!block.fluid()) {
+                continue;
+            }
+
+            const BlockType type = block.getBlockType();
+
+            if (const Block* below = getFlowTarget(position - glm::ivec3(0, 1, 0), type); below && below->getLevel() < FLUID_MAX_LEVEL) {
+                continue;
+            }
+
+            // Only the higher side of a pair works out the flow, so no pair is counted twice
+            for (const primitive::Direction direction : HORIZONTAL_DIRECTIONS) {
+                const glm::ivec3 side = position + primitive::getDirectionOffset(direction);
+
+                const Block* target = getFlowTarget(side, type);
+                if (!target || target->getLevel() >= block.getLevel()) {
+                    continue;
+                }
+
+                const unsigned int amount = (block.getLevel() - target->getLevel()) / FLUID_SPREAD_DIVISOR;
+                if (amount > 0) {
+                    m_flows.push_back(Flow { position, side, type, amount });
+                }
+            }
+        }
+    }
+
+    void FluidSimulation::applyFlows() {
+        // Sums commute, so applying in any order gives the same levels
+        for (const auto& [from, to, type, amount] : m_flows) {
+            const unsigned int remaining = m_world.getBlock(from)->getLevel() - amount;
+            m_world.setBlock(from, remaining == 0 ? Block() : Block(type, remaining));
+            m_world.setBlock(to, Block(type, m_world.getBlock(to)->getLevel() + amount));
+
+            m_changed.push_back(from);
+            m_changed.push_back(to);
+        }
+
+        m_flowCount += m_flows.size();
+        m_flows.clear();
+    }
+
+    void FluidSimulation::scheduleAround(const glm::ivec3 position) {
+        for (unsigned int id = 0; id <= primitive::DIRECTION_COUNT; id++) {
+            const glm::ivec3 cell = id == primitive::DIRECTION_COUNT
+                ? position
+                : position + primitive::getDirectionOffset(static_cast<primitive::Direction>(id));
+
+            if (const Block* block = m_world.getBlock(cell); block && block->fluid()) {
+                m_ticks.schedule(cell, getTickDelay(block->getBlockType()));
+            }
+        }
+    }
+
+    uint64_t FluidSimulation::getCellsUpdated() const {
+        return m_cellsUpdated;
+    }
+
+    uint64_t FluidSimulation::getFlowCount() const {
+        return m_flowCount;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "block_ticks.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace minecraft::world {
+    // Ticks between steps of a fluid cell, lava creeps
+    constexpr uint64_t WATER_TICK_DELAY = 3;
+    constexpr uint64_t LAVA_TICK_DELAY = 15;
+    // A cell gives each lower side a fifth of the difference, so four sides can never overfill it
+    constexpr unsigned int FLUID_SPREAD_DIVISOR = 5;
+
+    // Cellular automaton over fluid levels, driven by the block tick scheduler. Only cells with a tick due are
+    // stepped, and a cell is only rescheduled when it or a neighbour changed, so settled fluid costs nothing.
+    // Every flow of a step is worked out from the levels before it and applied together, so the result doesn't
+    // depend on the order cells come due in. Fluid falls first, then spreads sideways from cells that can't
+    // fall, and the total amount never changes
+    class FluidSimulation {
+    public:
+        FluidSimulation(World& world, BlockTickScheduler& ticks);
+
+        // Fills an air cell and schedules it, false for anything else
+        bool addFluid(glm::ivec3 position, BlockType type, unsigned int level = FLUID_MAX_LEVEL);
+        // Steps the fluid cells among due, any other block is skipped
+        void update(std::span<const glm::ivec3> due);
+        // Schedules any fluid at position and its six neighbours, for a block changed outside the simulation
+        void scheduleAround(glm::ivec3 position);
+
+        // Fluid cells stepped and flows applied over the simulation's lifetime
+        [[nodiscard]]
+        uint64_t getCellsUpdated() const;
+        [[nodiscard]]
+        uint64_t getFlowCount() const;
+
+    private:
+        struct Flow {
+            glm::ivec3 from;
+            glm::ivec3 to;
+            BlockType type;
+            unsigned int amount;
+        };
+
+        // The block at position if fluid of this type can enter it: air, or the same fluid.
+        // Air next to a different fluid takes neither, so fluids never mix
+        [[nodiscard]]
+        const Block* getFlowTarget(glm::ivec3 position, BlockType type) const;
+
+        void addVerticalFlows();
+        void addHorizontalFlows();
+        void applyFlows();
+
+        World& m_world;
+        BlockTickScheduler& m_ticks;
+
+        std::vector<glm::ivec3> m_cells{};
+        std::vector<Flow> m_flows{};
+        std::vector<glm::ivec3> m_changed{};
+
+        uint64_t m_cellsUpdated{};
+        uint64_t m_flowCount{};
+    };
+}
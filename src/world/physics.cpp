@@ -0,0 +1,82 @@
+#include "physics.hpp"
+
+#include <algorithm>
+
+namespace minecraft::world {
+
+    namespace {
+        // Keeps boxes resting exactly on a block face from counting as overlapping it
+        constexpr float COLLISION_EPSILON = 1e-4f;
+
+        // Distance bounds can travel along axis before touching a solid block, at most displacement
+        float sweepAxis(const World& world, const primitive::BoundingBox& bounds, const int axis, float displacement) {
+            primitive::BoundingBox swept = bounds;
+            if (displacement > 0.0f) {
+                swept.max[axis] += displacement;
+            } else {
+                swept.min[axis] += displacement;
+            }
+
+            const glm::ivec3 first(glm::floor(swept.min + COLLISION_EPSILON));
+            const glm::ivec3 last(glm::floor(swept.max - COLLISION_EPSILON));
+
+            const int firstY = std::max(first.y, 0);
+            const int lastY = std::min(last.y, static_cast<int>(CHUNK_HEIGHT) - 1);
+
+            // Column by column, so each column's chunk is looked up once rather than once per cell
+            for (int x = first.x; x <= last.x; x++) {
+                for (int z = first.z; z <= last.z; z++) {
+                    const Chunk* chunk = world.getChunkAt(glm::ivec3(x, 0, z));
+                    if (!chunk) {
+                        continue;
+                    }
+
+                    for (int y = firstY; y <= lastY; y++) {
+                        const glm::ivec3 cell(x, y, z);
+
+                        if (!chunk->getLocalBlock(glm::ivec3(x & (CHUNK_SIZE - 1), y, z & (CHUNK_SIZE - 1))).solid()) {
+                            continue;
+                        }
+
+                        // Never pulls the box backwards when it already starts inside a block
+                        if (displacement > 0.0f) {
+                            displacement = std::max(0.0f, std::min(displacement, static_cast<float>(cell[axis]) - bounds.max[axis]));
+                        } else {
+                            displacement = std::min(0.0f, std::max(displacement, static_cast<float>(cell[axis] + 1) - bounds.min[axis]));
+                        }
+                    }
+                }
+            }
+
+            return displacement;
+        }
+    }
+
+    primitive::BoundingBox getBodyBounds(const PhysicsBody& body) {
+        return primitive::BoundingBox {
+            body.Position - glm::vec3(body.HalfExtents.x, 0.0f, body.HalfExtents.z),
+            body.Position + glm::vec3(body.HalfExtents.x, 2.0f * body.HalfExtents.y, body.HalfExtents.z),
+        };
+    }
+
+    void stepBody(const World& world, PhysicsBody& body, const float timestep) {
+        body.Velocity.y = std::max(body.Velocity.y - GRAVITY * timestep, -TERMINAL_VELOCITY);
+        body.OnGround = false;
+
+        // Vertical first, so walking off a ledge and landing resolve before sliding along walls
+        for (const int axis : { 1, 0, 2 }) {
+            const float displacement = body.Velocity[axis] * timestep;
+            if (displacement == 0.0f) {
+                continue;
+            }
+
+            const float moved = sweepAxis(world, getBodyBounds(body), axis, displacement);
+            body.Position[axis] += moved;
+
+            if (moved != displacement) {
+                body.OnGround |= axis == 1 && displacement < 0.0f;
+                body.Velocity[axis] = 0.0f;
+            }
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "world.hpp"
+
+namespace minecraft::world {
+    constexpr float GRAVITY = 28.0f;
+    constexpr float TERMINAL_VELOCITY = 60.0f;
+
+    constexpr glm::vec3 PLAYER_HALF_EXTENTS(0.3f, 0.9f, 0.3f);
+    constexpr float PLAYER_EYE_HEIGHT = 1.62f;
+    constexpr float PLAYER_WALK_SPEED = 4.3f;
+    // Clears a one block step under GRAVITY
+    constexpr float PLAYER_JUMP_VELOCITY = 8.5f;
+
+    // Axis aligned box centred on Position in x and z, with Position.y at its base
+    struct PhysicsBody {
+        glm::vec3 Position{};
+        glm::vec3 Velocity{};
+        glm::vec3 HalfExtents = PLAYER_HALF_EXTENTS;
+        bool OnGround{};
+    };
+
+    [[nodiscard]]
+    primitive::BoundingBox getBodyBounds(const PhysicsBody& body);
+
+    // One step of gravity and movement, resolved against solid blocks one axis at a time (y, x, z).
+    // Only the blocks inside the box swept along each axis are read, and the result depends on nothing
+    // but the body, the world and timestep, so replaying the same inputs gives the same positions
+    void stepBody(const World& world, PhysicsBody& body, float timestep);
+}
@@ -0,0 +1,184 @@
+#include "raycast.hpp"
+#include "profiler.hpp"
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+
+namespace minecraft::world {
+
+    namespace {
+        primitive::Direction getEntryFace(const int axis, const int step) {
+            switch (axis) {
+                case 0:     return step > 0 ? primitive::Direction::LEFT : primitive::Direction::RIGHT;
+                case 1:     return step > 0 ? primitive::Direction::DOWN : primitive::Direction::UP;
+                default:    return step > 0 ? primitive::Direction::BACK : primitive::Direction::FRONT;
+            }
+        }
+    }
+
+    std::optional<RaycastHit> raycast(const World& world, const Ray& ray) {
+        const float length = glm::length(ray.direction);
+        if (length == 0.0f || ray.maxDistance <= 0.0f) {
+            return std::nullopt;
+        }
+
+        const glm::vec3 direction = ray.direction / length;
+        const glm::ivec3 minBlock = world.getMinBlock();
+        const glm::ivec3 maxBlock = world.getMaxBlock();
+
+        // Clip to the generated area first, so the walk never starts or wanders outside it
+        float tEnter = 0.0f;
+        float tExit = ray.maxDistance;
+        int axis = -1;
+
+        for (int i = 0; i < 3; i++) {
+            if (direction[i] == 0.0f) {
+                if (ray.origin[i] < static_cast<float>(minBlock[i]) || ray.origin[i] >= static_cast<float>(maxBlock[i])) {
+                    return std::nullopt;
+                }
+
+                continue;
+            }
+
+            float tNear = (static_cast<float>(minBlock[i]) - ray.origin[i]) / direction[i];
+            float tFar = (static_cast<float>(maxBlock[i]) - ray.origin[i]) / direction[i];
+            if (tNear > tFar) {
+                std::swap(tNear, tFar);
+            }
+
+            if (tNear > tEnter) {
+                tEnter = tNear;
+                axis = i;
+            }
+
+            tExit = std::min(tExit, tFar);
+        }
+
+        if (tEnter > tExit) {
+            return std::nullopt;
+        }
+
+        const glm::vec3 start = ray.origin + direction * tEnter;
+        glm::ivec3 cell = glm::clamp(glm::ivec3(glm::floor(start)), minBlock, maxBlock - 1);
+
+        glm::ivec3 step{};
+        glm::vec3 tMax{};
+        glm::vec3 tDelta{};
+
+        for (int i = 0; i < 3; i++) {
+            if (direction[i] == 0.0f) {
+                tMax[i] = std::numeric_limits<float>::infinity();
+                tDelta[i] = std::numeric_limits<float>::infinity();
+                continue;
+            }
+
+            step[i] = direction[i] > 0.0f ? 1 : -1;
+            tMax[i] = (static_cast<float>(cell[i] + (step[i] > 0 ? 1 : 0)) - ray.origin[i]) / direction[i];
+            tDelta[i] = std::abs(1.0f / direction[i]);
+        }
+
+        // A ray starting inside a block reports the face it would have entered through along its main axis
+        if (axis < 0) {
+            const glm::vec3 magnitude = glm::abs(direction);
+            axis = magnitude.x >= magnitude.y && magnitude.x >= magnitude.z ? 0 : magnitude.y >= magnitude.z ? 1 : 2;
+        }
+
+        float t = tEnter;
+        const Chunk* chunk = nullptr;
+        glm::ivec3 section(INT_MIN);
+        bool sectionEmpty = true;
+
+        while (true) {
+            // Sections are CHUNK_SIZE cubes, so a shift finds the one the cell is in
+            const glm::ivec3 cellSection = cell >> glm::ivec3(CHUNK_SIZE_BIT_OFFSET);
+            if (cellSection != section) {
+                section = cellSection;
+                chunk = world.getChunkAt(cell);
+                sectionEmpty = !chunk || chunk->isSectionEmpty(static_cast<unsigned int>(cell.y) / CHUNK_SECTION_HEIGHT);
+            }
+
+            if (sectionEmpty) {
+                // Nothing to hit before the ray leaves the section, so jump to the first cell past it
+                const glm::ivec3 sectionMin = section * static_cast<int>(CHUNK_SIZE);
+                float tLeave = std::numeric_limits<float>::infinity();
+
+                for (int i = 0; i < 3; i++) {
+                    if (step[i] == 0) {
+                        continue;
+                    }
+
+                    const int boundary = sectionMin[i] + (step[i] > 0 ? static_cast<int>(CHUNK_SIZE) : 0);
+                    // Ties go to the later axis, as in the cell by cell walk
+                    if (const float tBoundary = (static_cast<float>(boundary) - ray.origin[i]) / direction[i]; tBoundary <= tLeave) {
+                        tLeave = tBoundary;
+                        axis = i;
+                    }
+                }
+
+                if (tLeave > tExit) {
+                    return std::nullopt;
+                }
+
+                // The same state the walk would reach cell by cell, rebuilt from where the ray crosses the boundary
+                for (int i = 0; i < 3; i++) {
+                    if (step[i] == 0) {
+                        continue;
+                    }
+
+                    if (i == axis) {
+                        cell[i] = sectionMin[i] + (step[i] > 0 ? static_cast<int>(CHUNK_SIZE) : -1);
+                    } else {
+                        const auto crossing = static_cast<int>(std::floor(ray.origin[i] + direction[i] * tLeave));
+                        cell[i] = std::clamp(crossing, sectionMin[i], sectionMin[i] + static_cast<int>(CHUNK_SIZE) - 1);
+                    }
+
+                    tMax[i] = (static_cast<float>(cell[i] + (step[i] > 0 ? 1 : 0)) - ray.origin[i]) / direction[i];
+
+                    // A ray crossing exactly on an edge has stepped the later axes first
+                    if (i != axis && (i > axis ? tMax[i] <= tLeave : tMax[i] < tLeave)) {
+                        cell[i] += step[i];
+                        tMax[i] += tDelta[i];
+                    }
+                }
+
+                t = tLeave;
+                continue;
+            }
+
+            const glm::ivec3 local(cell.x & (CHUNK_SIZE - 1), cell.y, cell.z & (CHUNK_SIZE - 1));
+            if (chunk->getLocalBlock(local).solid()) {
+                return RaycastHit { cell, getEntryFace(axis, step[axis]), t };
+            }
+
+            axis = tMax.x < tMax.y ? (tMax.x < tMax.z ? 0 : 2) : (tMax.y < tMax.z ? 1 : 2);
+            t = tMax[axis];
+
+            if (t > tExit) {
+                return std::nullopt;
+            }
+
+            cell[axis] += step[axis];
+            tMax[axis] += tDelta[axis];
+        }
+    }
+
+    void raycastBatch(const World& world, const std::span<const Ray> rays, const std::span<std::optional<RaycastHit>> hits) {
+        system::ProfileZone zone("raycastBatch");
+
+        const size_t workCount = (rays.size() + RAYCAST_BATCH_GRAIN - 1) / RAYCAST_BATCH_GRAIN;
+
+        const auto castWork = [&](const size_t work) {
+            const size_t end = std::min(rays.size(), (work + 1) * RAYCAST_BATCH_GRAIN);
+
+            for (size_t i = work * RAYCAST_BATCH_GRAIN; i < end; i++) {
+                hits[i] = raycast(world, rays[i]);
+            }
+        };
+
+        // The world is only read, so workers share it without locking
+        system::WorkerPool::get().parallelFor(workCount, castWork);
+    }
+}
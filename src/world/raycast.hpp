@@ -0,0 +1,32 @@
+#pragma once
+
+#include "world.hpp"
+
+#include <optional>
+#include <span>
+
+namespace minecraft::world {
+    constexpr float DEFAULT_REACH = 8.0f;
+    // Rays per work item in raycastBatch, also the smallest batch worth spreading over threads
+    constexpr size_t RAYCAST_BATCH_GRAIN = 4096;
+
+    struct Ray {
+        glm::vec3 origin;
+        // Needn't be normalised
+        glm::vec3 direction;
+        float maxDistance;
+    };
+
+    struct RaycastHit {
+        glm::ivec3 block;
+        // Face of the hit block the ray entered through
+        primitive::Direction face;
+        float distance;
+    };
+
+    // Amanatides-Woo traversal over the block grid, clipped to the generated area. An empty section is crossed in
+    // one jump to where the ray leaves it, without touching block storage
+    std::optional<RaycastHit> raycast(const World& world, const Ray& ray);
+    // hits must be as long as rays, large batches are split over worker threads
+    void raycastBatch(const World& world, std::span<const Ray> rays, std::span<std::optional<RaycastHit>> hits);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "direction.hpp"
+#include <cstdint>
+
+namespace minecraft::world {
+
+    // Which pairs of the six section faces can see each other through non-solid blocks, one bit per pair
+    class SectionVisibility {
+    public:
+        static constexpr unsigned int PAIR_COUNT = 15;
+        static constexpr uint16_t ALL_VISIBLE = (1u << PAIR_COUNT) - 1;
+
+        SectionVisibility() = default;
+
+        explicit SectionVisibility(const uint16_t mask)
+            : m_mask(mask) {}
+
+        void connect(const primitive::Direction a, const primitive::Direction b) {
+            if (a != b) {
+                m_mask |= 1u << getPairIndex(a, b);
+            }
+        }
+
+        [[nodiscard]]
+        bool canSee(const primitive::Direction a, const primitive::Direction b) const {
+            return a != b && (m_mask >> getPairIndex(a, b) & 1u) != 0;
+        }
+
+        [[nodiscard]]
+        uint16_t getMask() const {
+            return m_mask;
+        }
+
+        static constexpr unsigned int getPairIndex(const primitive::Direction a, const primitive::Direction b) {
+            unsigned int low = primitive::getDirectionID(a);
+            unsigned int high = primitive::getDirectionID(b);
+
+            if (low > high) {
+                const unsigned int swap = low;
+                low = high;
+                high = swap;
+            }
+
+            return low * (11 - low) / 2 + high - low - 1;
+        }
+
+    private:
+        uint16_t m_mask{};
+    };
+}
@@ -0,0 +1,104 @@
+#include "simulation.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace minecraft::world {
+
+    Simulation::Simulation(World& world)
+        : m_world(world), m_blockTicks(world), m_fluids(world, m_blockTicks) {}
+
+    unsigned int Simulation::advance(const float frameTime, const SimulationInput& input) {
+        m_accumulator += std::clamp(frameTime, 0.0f, SIMULATION_MAX_FRAME_TIME);
+        unsigned int ticks = 0;
+
+        while (m_accumulator >= SIMULATION_TIMESTEP) {
+            tick(input);
+            m_accumulator -= SIMULATION_TIMESTEP;
+            ticks++;
+        }
+
+        return ticks;
+    }
+
+    void Simulation::tick(const SimulationInput& input) {
+        system::ProfileZone zone("Simulation::tick");
+
+        m_previousPosition = m_player.Position;
+
+        // Walk along the heading, flattened so looking down doesn't slow the player
+        const float yaw = glm::radians(input.yaw);
+        const glm::vec3 forward(std::cos(yaw), 0.0f, std::sin(yaw));
+        const glm::vec3 right(-forward.z, 0.0f, forward.x);
+
+        glm::vec3 walk = forward * input.movement.z + right * input.movement.x;
+        if (glm::length(walk) > 1.0f) {
+            walk = glm::normalize(walk);
+        }
+
+        m_player.Velocity.x = walk.x * PLAYER_WALK_SPEED;
+        m_player.Velocity.z = walk.z * PLAYER_WALK_SPEED;
+
+        if (input.movement.y > 0.0f && m_player.OnGround) {
+            m_player.Velocity.y = PLAYER_JUMP_VELOCITY;
+        }
+
+        stepBody(m_world, m_player, SIMULATION_TIMESTEP);
+
+        m_dueBlocks.clear();
+        m_randomBlocks.clear();
+        m_blockTicks.advance(m_dueBlocks);
+        m_blockTicks.sampleRandomTicks(RANDOM_TICKS_PER_SECTION, m_randomBlocks);
+
+        m_fluids.update(m_dueBlocks);
+
+        runPhysicsSystem(m_world, m_entities, SIMULATION_TIMESTEP);
+        runMovementSystem(m_entities, SIMULATION_TIMESTEP);
+        m_entityHash.build(m_entities);
+
+        m_tickCount++;
+    }
+
+    void Simulation::setPlayerPosition(const glm::vec3 position) {
+        m_player.Position = position;
+        m_previousPosition = position;
+    }
+
+    const PhysicsBody& Simulation::getPlayer() const {
+        return m_player;
+    }
+
+    glm::vec3 Simulation::getInterpolatedEyePosition() const {
+        const float alpha = m_accumulator / SIMULATION_TIMESTEP;
+        return glm::mix(m_previousPosition, m_player.Position, alpha) + glm::vec3(0.0f, PLAYER_EYE_HEIGHT, 0.0f);
+    }
+
+    uint64_t Simulation::getTickCount() const {
+        return m_tickCount;
+    }
+
+    BlockTickScheduler& Simulation::getBlockTicks() {
+        return m_blockTicks;
+    }
+
+    const std::vector<glm::ivec3>& Simulation::getDueBlocks() const {
+        return m_dueBlocks;
+    }
+
+    const std::vector<glm::ivec3>& Simulation::getRandomBlocks() const {
+        return m_randomBlocks;
+    }
+
+    FluidSimulation& Simulation::getFluids() {
+        return m_fluids;
+    }
+
+    EntityRegistry& Simulation::getEntities() {
+        return m_entities;
+    }
+
+    const SpatialHash& Simulation::getEntityHash() const {
+        return m_entityHash;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "physics.hpp"
+#include "block_ticks.hpp"
+#include "fluids.hpp"
+#include "entity_systems.hpp"
+#include "spatial_hash.hpp"
+
+#include <cstdint>
+
+namespace minecraft::world {
+    constexpr float SIMULATION_TICK_RATE = 60.0f;
+    constexpr float SIMULATION_TIMESTEP = 1.0f / SIMULATION_TICK_RATE;
+    // Frames longer than this only simulate this much, rather than spiralling into ever more ticks
+    constexpr float SIMULATION_MAX_FRAME_TIME = 0.25f;
+
+    struct SimulationInput {
+        // Right, up and forward in -1 to 1, up jumps
+        glm::vec3 movement;
+        // Heading in degrees, as PlayerCamera::getYaw
+        float yaw;
+    };
+
+    // Game state advanced in fixed ticks, independent of the frame rate and of any window or GL context.
+    // Rendering reads the state interpolated between the last two ticks
+    class Simulation {
+    public:
+        explicit Simulation(World& world);
+
+        // Runs every whole tick that fits in the accumulated frame time, returns how many ran
+        unsigned int advance(float frameTime, const SimulationInput& input);
+        void tick(const SimulationInput& input);
+
+        void setPlayerPosition(glm::vec3 position);
+        [[nodiscard]]
+        const PhysicsBody& getPlayer() const;
+        // Eye position between the previous and current tick, by how far the accumulator is into the next one
+        [[nodiscard]]
+        glm::vec3 getInterpolatedEyePosition() const;
+
+        [[nodiscard]]
+        uint64_t getTickCount() const;
+
+        BlockTickScheduler& getBlockTicks();
+        // Blocks whose scheduled tick came due, and the random tick samples, on the latest tick
+        [[nodiscard]]
+        const std::vector<glm::ivec3>& getDueBlocks() const;
+        [[nodiscard]]
+        const std::vector<glm::ivec3>& getRandomBlocks() const;
+        FluidSimulation& getFluids();
+        EntityRegistry& getEntities();
+        // Rebuilt at the end of every tick
+        [[nodiscard]]
+        const SpatialHash& getEntityHash() const;
+
+    private:
+        World& m_world;
+        BlockTickScheduler m_blockTicks;
+        FluidSimulation m_fluids;
+
+        EntityRegistry m_entities{};
+        SpatialHash m_entityHash{};
+        std::vector<glm::ivec3> m_dueBlocks{};
+        std::vector<glm::ivec3> m_randomBlocks{};
+
+        PhysicsBody m_player{};
+        glm::vec3 m_previousPosition{};
+
+        float m_accumulator{};
+        uint64_t m_tickCount{};
+    };
+}
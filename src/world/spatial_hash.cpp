@@ -0,0 +1,98 @@
+#include "spatial_hash.hpp"
+#include "chunk.hpp"
+#include "profiler.hpp"
+
+#include <bit>
+
+namespace minecraft::world {
+
+    namespace {
+        constexpr size_t MIN_BUCKET_COUNT = 64;
+    }
+
+    glm::ivec2 SpatialHash::getCell(const glm::vec3 position) {
+        // Arithmetic shift floors, so negative positions land in the right chunk
+        return glm::ivec2(
+            static_cast<int>(std::floor(position.x)) >> CHUNK_SIZE_BIT_OFFSET,
+            static_cast<int>(std::floor(position.z)) >> CHUNK_SIZE_BIT_OFFSET
+        );
+    }
+
+    size_t SpatialHash::getBucket(const glm::ivec2 cell) const {
+        // Teschner et al.'s primes, the bucket count is a power of two
+        const uint32_t hash = static_cast<uint32_t>(cell.x) * 73856093u ^ static_cast<uint32_t>(cell.y) * 19349663u;
+        return hash & (m_bucketStarts.size() - 2);
+    }
+
+    void SpatialHash::build(const EntityRegistry& registry) {
+        system::ProfileZone zone("SpatialHash::build");
+
+        m_items.clear();
+
+        for (const Archetype& archetype : registry.getArchetypes()) {
+            if ((archetype.Mask & COMPONENT_TRANSFORM) == 0) {
+                continue;
+            }
+
+            for (size_t row = 0; row < archetype.size(); row++) {
+                const glm::vec3 position = archetype.Transforms[row].Position;
+                m_items.push_back(Item { getCell(position), position, archetype.Entities[row] });
+            }
+        }
+
+        // A counting sort by bucket: count, prefix sum, then scatter
+        const size_t bucketCount = std::bit_ceil(std::max(m_items.size(), MIN_BUCKET_COUNT));
+        m_bucketStarts.assign(bucketCount + 1, 0);
+
+        for (const Item& item : m_items) {
+            m_bucketStarts[getBucket(item.cell) + 1]++;
+        }
+
+        for (size_t bucket = 1; bucket <= bucketCount; bucket++) {
+            m_bucketStarts[bucket] += m_bucketStarts[bucket - 1];
+        }
+
+        m_bucketItems.resize(m_items.size());
+
+        for (const Item& item : m_items) {
+            // Shifted down a slot while scattering, then restored below
+            m_bucketItems[m_bucketStarts[getBucket(item.cell)]++] = item;
+        }
+
+        for (size_t bucket = bucketCount; bucket > 0; bucket--) {
+            m_bucketStarts[bucket] = m_bucketStarts[bucket - 1];
+        }
+        m_bucketStarts[0] = 0;
+    }
+
+    void SpatialHash::query(const glm::vec3 position, const float radius, std::vector<Entity>& results) const {
+        if (m_bucketItems.empty()) {
+            return;
+        }
+
+        const glm::ivec2 first = getCell(position - radius);
+        const glm::ivec2 last = getCell(position + radius);
+        const float radiusSquared = radius * radius;
+
+        for (int x = first.x; x <= last.x; x++) {
+            for (int z = first.y; z <= last.y; z++) {
+                const glm::ivec2 cell(x, z);
+                const size_t bucket = getBucket(cell);
+
+                // Other cells can share the bucket, so each item is checked against the cell too
+                for (uint32_t i = m_bucketStarts[bucket]; i < m_bucketStarts[bucket + 1]; i++) {
+                    const Item& item = m_bucketItems[i];
+                    const glm::vec3 offset = item.position - position;
+
+                    if (item.cell == cell && glm::dot(offset, offset) <= radiusSquared) {
+                        results.push_back(item.entity);
+                    }
+                }
+            }
+        }
+    }
+
+    size_t SpatialHash::getEntityCount() const {
+        return m_bucketItems.size();
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "entities.hpp"
+
+namespace minecraft::world {
+
+    // Entities bucketed by the chunk column they stand in, rebuilt from scratch each tick in two linear passes.
+    // Cells hash into a table sized to the entity count, so it works for any position, inside the world or not
+    class SpatialHash {
+    public:
+        // Every entity with a Transform
+        void build(const EntityRegistry& registry);
+        // Appends the entities within radius of position, in no particular order
+        void query(glm::vec3 position, float radius, std::vector<Entity>& results) const;
+
+        [[nodiscard]]
+        size_t getEntityCount() const;
+
+        [[nodiscard]]
+        static glm::ivec2 getCell(glm::vec3 position);
+
+    private:
+        struct Item {
+            glm::ivec2 cell;
+            glm::vec3 position;
+            Entity entity;
+        };
+
+        [[nodiscard]]
+        size_t getBucket(glm::ivec2 cell) const;
+
+        EntityComponents<Item> m_items{};
+        // Items grouped by bucket, bucket b is m_bucketItems[m_bucketStarts[b], m_bucketStarts[b + 1])
+        EntityComponents<Item> m_bucketItems{};
+        EntityComponents<uint32_t> m_bucketStarts{};
+    };
+}
@@ -0,0 +1,106 @@
+#include "visibility_graph.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace minecraft::world {
+
+    VisibilityStats VisibilityGraph::traverse(
+        const World& world, const glm::vec3 cameraPosition, const system::Frustum& frustum
+    ) {
+        const auto start = std::chrono::steady_clock::now();
+
+        const unsigned int chunkCount = world.getChunkCount();
+        const unsigned int totalSections = chunkCount * CHUNK_SECTION_COUNT;
+
+        m_visitedSections.assign(totalSections, 0);
+        m_visibleChunks.assign(chunkCount, 0);
+        m_queue.clear();
+
+        const auto chunkPosition = glm::ivec2(glm::floor(glm::vec2(cameraPosition.x, cameraPosition.z) / static_cast<float>(CHUNK_SIZE)));
+        const int cameraSection = static_cast<int>(std::floor(cameraPosition.y / static_cast<float>(CHUNK_SECTION_HEIGHT)));
+
+        if (const int chunkIndex = world.getChunkIndex(chunkPosition); chunkIndex < 0) {
+            // Outside the loaded area there is no start section, fall back to drawing everything
+            std::ranges::fill(m_visibleChunks, 1);
+            return VisibilityStats { totalSections, totalSections, 0.0f };
+        }
+        else if (cameraSection >= 0 && cameraSection < static_cast<int>(CHUNK_SECTION_COUNT)) {
+            visit(world, frustum, Node { chunkIndex, cameraSection, primitive::Direction::UP, false, 0 });
+        }
+        else {
+            // Above or below the world, enter every boundary section facing the camera
+            const bool above = cameraSection >= 0;
+            const int section = above ? static_cast<int>(CHUNK_SECTION_COUNT) - 1 : 0;
+            const auto entry = above ? primitive::Direction::UP : primitive::Direction::DOWN;
+            const unsigned int directions = 1u << primitive::getDirectionID(primitive::getOppositeDirection(entry));
+
+            for (unsigned int i = 0; i < chunkCount; i++) {
+                visit(world, frustum, Node { static_cast<int>(i), section, entry, true, directions });
+            }
+        }
+
+        for (size_t head = 0; head < m_queue.size(); head++) {
+            const Node node = m_queue[head];
+            const Chunk& chunk = world.getChunk(node.chunkIndex);
+            const SectionVisibility visibility = chunk.getSectionVisibility(node.section);
+
+            m_visibleChunks[node.chunkIndex] = 1;
+
+            for (unsigned int id = 0; id < primitive::DIRECTION_COUNT; id++) {
+                const auto direction = static_cast<primitive::Direction>(id);
+                const auto opposite = primitive::getOppositeDirection(direction);
+
+                // Never walk back towards the camera, and only leave through faces visible from the entry face
+                if (node.directions & 1u << primitive::getDirectionID(opposite)) {
+                    continue;
+                }
+
+                if (node.hasEntry && !visibility.canSee(node.entry, direction)) {
+                    continue;
+                }
+
+                const glm::ivec3 offset = primitive::getDirectionOffset(direction);
+                const int section = node.section + offset.y;
+                const int chunkIndex = world.getChunkIndex(chunk.getPosition() + glm::ivec2(offset.x, offset.z));
+
+                if (section < 0 || section >= static_cast<int>(CHUNK_SECTION_COUNT) || chunkIndex < 0) {
+                    continue;
+                }
+
+                visit(world, frustum, Node { chunkIndex, section, opposite, true, node.directions | 1u << id });
+            }
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+
+        return VisibilityStats {
+            static_cast<unsigned int>(m_queue.size()),
+            totalSections,
+            std::chrono::duration<float, std::micro>(end - start).count(),
+        };
+    }
+
+    bool VisibilityGraph::isChunkVisible(const unsigned int chunkIndex) const {
+        return chunkIndex < m_visibleChunks.size() && m_visibleChunks[chunkIndex] != 0;
+    }
+
+    bool VisibilityGraph::visit(const World& world, const system::Frustum& frustum, const Node& node) {
+        const unsigned int sectionIndex = node.chunkIndex * CHUNK_SECTION_COUNT + node.section;
+        if (m_visitedSections[sectionIndex]) {
+            return false;
+        }
+
+        const glm::vec3 sectionMin = world.getChunk(node.chunkIndex).getOrigin()
+            + glm::vec3(0.0f, static_cast<float>(node.section * CHUNK_SECTION_HEIGHT), 0.0f);
+        const glm::vec3 sectionMax = sectionMin + glm::vec3(CHUNK_SIZE, CHUNK_SECTION_HEIGHT, CHUNK_SIZE);
+
+        if (!frustum.intersects(sectionMin, sectionMax)) {
+            return false;
+        }
+
+        m_visitedSections[sectionIndex] = 1;
+        m_queue.push_back(node);
+        return true;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "world.hpp"
+#include "chunk_culler.hpp"
+
+namespace minecraft::world {
+
+    struct VisibilityStats {
+        unsigned int visitedSections;
+        unsigned int totalSections;
+        float microseconds;
+    };
+
+    // Breadth-first walk of chunk sections from the camera, only crossing section faces that can see each other
+    class VisibilityGraph {
+    public:
+        VisibilityStats traverse(const World& world, glm::vec3 cameraPosition, const system::Frustum& frustum);
+
+        [[nodiscard]]
+        bool isChunkVisible(unsigned int chunkIndex) const;
+
+    private:
+        struct Node {
+            int chunkIndex;
+            int section;
+            primitive::Direction entry;
+            bool hasEntry;
+            unsigned int directions;
+        };
+
+        bool visit(const World& world, const system::Frustum& frustum, const Node& node);
+
+        std::vector<unsigned char> m_visitedSections{};
+        std::vector<unsigned char> m_visibleChunks{};
+        std::vector<Node> m_queue{};
+    };
+}
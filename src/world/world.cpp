@@ -0,0 +1,455 @@
+#include "world.hpp"
+#include "profiler.hpp"
+
+#include <glad/glad.h>
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+namespace minecraft::world {
+
+    World::World(const int radius)
+        : m_radius(radius) {}
+
+    World::~World() {
+        // Never built when only simulated, and then there may be no GL context at all
+        if (m_vertexArray == 0) {
+            return;
+        }
+
+        glDeleteVertexArrays(1, &m_vertexArray);
+        glDeleteBuffers(1, &m_faceBuffer);
+        glDeleteBuffers(1, &m_recordBuffer);
+        glDeleteBuffers(1, &m_commandBuffer);
+    }
+
+    void World::generate() {
+        system::ProfileZone zone("World::generate");
+
+        m_chunks.clear();
+        m_dirtyChunks.clear();
+
+        for (int x = -m_radius; x <= m_radius; x++) {
+            for (int z = -m_radius; z <= m_radius; z++) {
+                auto chunk = std::make_unique<Chunk>(glm::ivec2(x, z));
+                chunk->buildData();
+
+                // Nothing is faced yet, so every section starts out dirty
+                m_dirtyChunks.push_back(static_cast<unsigned int>(m_chunks.size()));
+                m_chunks.push_back(std::move(chunk));
+            }
+        }
+
+        for (const auto& chunk : m_chunks) {
+            const int left = getChunkIndex(chunk->getPosition() - glm::ivec2(1, 0));
+            const int back = getChunkIndex(chunk->getPosition() - glm::ivec2(0, 1));
+
+            chunk->setNeighbours(left < 0 ? nullptr : m_chunks[left].get(), back < 0 ? nullptr : m_chunks[back].get());
+        }
+
+        m_drawRecords.assign(m_chunks.size(), primitive::ChunkDrawRecord{});
+        m_faceCapacities.assign(m_chunks.size(), 0);
+        m_uploadChunks.clear();
+        m_uploadPending.assign(m_chunks.size(), 0);
+        layoutFaces();
+    }
+
+    bool World::buildMeshes() {
+        system::ProfileZone zone("World::buildMeshes");
+
+        bool built = false;
+
+        // Every chunk draw shares one index buffer sized for the fullest possible chunk
+        m_quadIndices.create(MAX_CHUNK_QUADS);
+
+        for (const auto& chunk : m_chunks) {
+            built |= chunk->buildMesh(m_quadIndices);
+        }
+
+        m_dirtyChunks.clear();
+        return built;
+    }
+
+    bool World::buildFaces() {
+        system::ProfileZone zone("World::buildFaces");
+
+        for (unsigned int index = 0; index < m_chunks.size(); index++) {
+            m_chunks[index]->buildFaces();
+            updateRecord(index);
+        }
+
+        m_dirtyChunks.clear();
+        layoutFaces();
+
+        const size_t faceCount = uploadFaces();
+        if (faceCount == 0) {
+            std::cerr << "No faces to render!" << std::endl;
+            return false;
+        }
+
+        std::cout << "Built " << faceCount << " faces for " << m_chunks.size() << " chunks" << std::endl;
+        return true;
+    }
+
+    unsigned int World::remeshDirtySections() {
+        system::ProfileZone zone("World::remeshDirtySections");
+
+        bool outgrown = false;
+
+        for (const unsigned int index : m_dirtyChunks) {
+            m_chunks[index]->rebuildDirtySections();
+            updateRecord(index);
+            outgrown |= m_drawRecords[index].faceCount > m_faceCapacities[index];
+        }
+
+        if (outgrown) {
+            layoutFaces();
+        }
+
+        const auto count = static_cast<unsigned int>(m_dirtyChunks.size());
+        m_dirtyChunks.clear();
+        return count;
+    }
+
+    bool World::updateFaces() {
+        if (remeshDirtySections() == 0) {
+            return false;
+        }
+
+        uploadFaces();
+        return true;
+    }
+
+    void World::invalidateFaces() {
+        m_dirtyChunks.clear();
+
+        for (unsigned int index = 0; index < m_chunks.size(); index++) {
+            for (unsigned int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+                m_chunks[index]->markSectionDirty(section);
+            }
+
+            m_dirtyChunks.push_back(index);
+        }
+    }
+
+    bool World::updateMeshes() {
+        if (m_dirtyChunks.empty()) {
+            return false;
+        }
+
+        system::ProfileZone zone("World::updateMeshes");
+
+        for (const unsigned int index : m_dirtyChunks) {
+            m_chunks[index]->buildMesh(m_quadIndices);
+        }
+
+        m_dirtyChunks.clear();
+        return true;
+    }
+
+    void World::updateRecord(const unsigned int index) {
+        const Chunk& chunk = *m_chunks[index];
+        const glm::vec3 origin = chunk.getOrigin();
+
+        glm::vec3 boundsMin(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+        glm::vec3 boundsMax(0.0f);
+
+        for (const auto& face : chunk.getFaces()) {
+            const glm::vec3 position = primitive::unpackFace(face).position;
+            boundsMin = glm::min(boundsMin, position);
+            boundsMax = glm::max(boundsMax, position + 1.0f);
+        }
+
+        primitive::ChunkDrawRecord& record = m_drawRecords[index];
+        record.origin = glm::vec4(origin, 1.0f);
+        record.aabbMin = glm::vec4(origin + glm::min(boundsMin, boundsMax), 1.0f);
+        record.aabbMax = glm::vec4(origin + boundsMax, 1.0f);
+        record.faceCount = static_cast<unsigned int>(chunk.getFaces().size());
+
+        if (!m_uploadPending[index]) {
+            m_uploadPending[index] = 1;
+            m_uploadChunks.push_back(index);
+        }
+    }
+
+    void World::layoutFaces() {
+        unsigned int firstFace = 0;
+
+        for (unsigned int index = 0; index < m_chunks.size(); index++) {
+            const unsigned int faceCount = m_drawRecords[index].faceCount;
+
+            m_drawRecords[index].firstFace = firstFace;
+            m_faceCapacities[index] = faceCount + faceCount / CHUNK_FACE_SLACK_DIVISOR + CHUNK_FACE_SLACK;
+            firstFace += m_faceCapacities[index];
+        }
+
+        m_faceCapacity = firstFace;
+        m_fullUpload = true;
+    }
+
+    FaceUpload World::getPendingUpload() const {
+        if (m_fullUpload) {
+            return FaceUpload { static_cast<unsigned int>(m_chunks.size()), getFaceBufferSize(), true };
+        }
+
+        size_t bytes = 0;
+        for (const unsigned int index : m_uploadChunks) {
+            bytes += m_drawRecords[index].faceCount * sizeof(primitive::PackedFace) + sizeof(primitive::ChunkDrawRecord);
+        }
+
+        return FaceUpload { static_cast<unsigned int>(m_uploadChunks.size()), bytes, false };
+    }
+
+    size_t World::getFaceBufferSize() const {
+        return m_faceCapacity * sizeof(primitive::PackedFace) + m_drawRecords.size() * sizeof(primitive::ChunkDrawRecord);
+    }
+
+    void World::discardPendingUpload() {
+        for (const unsigned int index : m_uploadChunks) {
+            m_uploadPending[index] = 0;
+        }
+
+        m_uploadChunks.clear();
+        m_fullUpload = false;
+    }
+
+    size_t World::uploadFaces() {
+        system::ProfileZone zone("World::uploadFaces");
+
+        size_t faceCount = 0;
+
+        if (m_fullUpload || m_vertexArray == 0) {
+            // Laid out afresh, every range moved, so the buffers are rebuilt whole with the slack left zeroed
+            MeshScratch<primitive::PackedFace> faces(m_faceCapacity);
+            unsigned int maxCapacity = 0;
+
+            for (unsigned int index = 0; index < m_chunks.size(); index++) {
+                const auto& chunkFaces = m_chunks[index]->getFaces();
+                std::ranges::copy(chunkFaces, faces.begin() + m_drawRecords[index].firstFace);
+
+                faceCount += chunkFaces.size();
+                maxCapacity = std::max(maxCapacity, m_faceCapacities[index]);
+            }
+
+            if (m_vertexArray == 0) {
+                glGenVertexArrays(1, &m_vertexArray);
+                glGenBuffers(1, &m_faceBuffer);
+                glGenBuffers(1, &m_recordBuffer);
+                glGenBuffers(1, &m_commandBuffer);
+            }
+
+            // Sized for the largest range, so a chunk growing into its slack never outruns the indices
+            m_quadIndices.create(maxCapacity);
+
+            glBindVertexArray(m_vertexArray);
+            m_quadIndices.bind();
+            glBindVertexArray(0);
+
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_faceBuffer);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, faces.size() * sizeof(primitive::PackedFace), faces.data(), GL_DYNAMIC_DRAW);
+            m_faceMemory.set(faces.size() * sizeof(primitive::PackedFace));
+
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_recordBuffer);
+            glBufferData(
+                GL_SHADER_STORAGE_BUFFER,
+                m_drawRecords.size() * sizeof(primitive::ChunkDrawRecord), m_drawRecords.data(),
+                GL_DYNAMIC_DRAW
+            );
+            m_recordMemory.set(m_drawRecords.size() * sizeof(primitive::ChunkDrawRecord));
+        } else {
+            for (const unsigned int index : m_uploadChunks) {
+                const auto& chunkFaces = m_chunks[index]->getFaces();
+                const primitive::ChunkDrawRecord& record = m_drawRecords[index];
+
+                glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_faceBuffer);
+                glBufferSubData(
+                    GL_SHADER_STORAGE_BUFFER,
+                    static_cast<GLintptr>(record.firstFace * sizeof(primitive::PackedFace)),
+                    static_cast<GLsizeiptr>(chunkFaces.size() * sizeof(primitive::PackedFace)), chunkFaces.data()
+                );
+
+                glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_recordBuffer);
+                glBufferSubData(
+                    GL_SHADER_STORAGE_BUFFER,
+                    static_cast<GLintptr>(index * sizeof(primitive::ChunkDrawRecord)),
+                    sizeof(primitive::ChunkDrawRecord), &record
+                );
+
+                faceCount += chunkFaces.size();
+            }
+        }
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        discardPendingUpload();
+
+        return faceCount;
+    }
+
+    void World::bind() const {
+        glBindVertexArray(m_vertexArray);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, primitive::FACE_BUFFER_BINDING, m_faceBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, primitive::RECORD_BUFFER_BINDING, m_recordBuffer);
+    }
+
+    void World::draw(const std::vector<primitive::DrawElementsIndirectCommand>& commands) const {
+        if (commands.empty()) {
+            return;
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+        glBufferData(
+            GL_DRAW_INDIRECT_BUFFER,
+            commands.size() * sizeof(primitive::DrawElementsIndirectCommand), commands.data(),
+            GL_STREAM_DRAW
+        );
+        m_commandMemory.set(commands.size() * sizeof(primitive::DrawElementsIndirectCommand));
+
+        bind();
+        glMultiDrawElementsIndirect(
+            GL_TRIANGLES, GL_UNSIGNED_INT, nullptr,
+            static_cast<int>(commands.size()), sizeof(primitive::DrawElementsIndirectCommand)
+        );
+
+        glBindVertexArray(0);
+    }
+
+    const std::vector<primitive::ChunkDrawRecord>& World::getDrawRecords() const {
+        return m_drawRecords;
+    }
+
+    unsigned int World::getRecordBuffer() const {
+        return m_recordBuffer;
+    }
+
+    std::vector<primitive::BoundingBox> World::getOccluders() const {
+        std::vector<primitive::BoundingBox> occluders{};
+
+        for (const auto& chunk : m_chunks) {
+            const glm::vec3 origin = chunk->getOrigin();
+
+            // Merge vertical runs of solid sections into a single box
+            for (unsigned int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+                if (!chunk->isSectionSolid(section)) {
+                    continue;
+                }
+
+                const unsigned int first = section;
+                while (section + 1 < CHUNK_SECTION_COUNT && chunk->isSectionSolid(section + 1)) {
+                    section++;
+                }
+
+                occluders.push_back(primitive::BoundingBox {
+                    origin + glm::vec3(0.0f, first * CHUNK_SECTION_HEIGHT, 0.0f),
+                    origin + glm::vec3(CHUNK_SIZE, (section + 1) * CHUNK_SECTION_HEIGHT, CHUNK_SIZE),
+                });
+            }
+        }
+
+        return occluders;
+    }
+
+    std::vector<primitive::BoundingBox> World::getOccludees() const {
+        std::vector<primitive::BoundingBox> occludees{};
+        occludees.reserve(m_drawRecords.size());
+
+        for (const auto& record : m_drawRecords) {
+            occludees.push_back(primitive::BoundingBox { record.aabbMin, record.aabbMax });
+        }
+
+        return occludees;
+    }
+
+    int World::getChunkIndex(const glm::ivec2 chunkPosition) const {
+        if (std::abs(chunkPosition.x) > m_radius || std::abs(chunkPosition.y) > m_radius) {
+            return -1;
+        }
+
+        return (chunkPosition.x + m_radius) * (2 * m_radius + 1) + chunkPosition.y + m_radius;
+    }
+
+    unsigned int World::getChunkCount() const {
+        return static_cast<unsigned int>(m_chunks.size());
+    }
+
+    const Chunk& World::getChunk(const unsigned int index) const {
+        return *m_chunks[index];
+    }
+
+    const Chunk* World::getChunkAt(const glm::ivec3 worldPosition) const {
+        if (worldPosition.y < 0 || worldPosition.y >= static_cast<int>(CHUNK_HEIGHT)) {
+            return nullptr;
+        }
+
+        // Arithmetic shift floors, so negative positions land in the right chunk
+        const int index = getChunkIndex(glm::ivec2(
+            worldPosition.x >> CHUNK_SIZE_BIT_OFFSET,
+            worldPosition.z >> CHUNK_SIZE_BIT_OFFSET
+        ));
+
+        return index < 0 || index >= static_cast<int>(m_chunks.size()) ? nullptr : m_chunks[index].get();
+    }
+
+    const Block* World::getBlock(const glm::ivec3 worldPosition) const {
+        const Chunk* chunk = getChunkAt(worldPosition);
+        if (!chunk) {
+            return nullptr;
+        }
+
+        return &chunk->getLocalBlock(glm::ivec3(
+            worldPosition.x & (CHUNK_SIZE - 1),
+            worldPosition.y,
+            worldPosition.z & (CHUNK_SIZE - 1)
+        ));
+    }
+
+    bool World::setBlock(const glm::ivec3 worldPosition, const Block block) {
+        const Chunk* found = getChunkAt(worldPosition);
+        if (!found) {
+            return false;
+        }
+
+        const int index = getChunkIndex(found->getPosition());
+        Chunk& chunk = *m_chunks[index];
+
+        if (chunk.getDirtySections() == 0) {
+            m_dirtyChunks.push_back(static_cast<unsigned int>(index));
+        }
+
+        const glm::ivec3 localPosition(worldPosition.x & (CHUNK_SIZE - 1), worldPosition.y, worldPosition.z & (CHUNK_SIZE - 1));
+        chunk.setLocalBlock(localPosition, block);
+
+        // A block on the max x or z plane shares a face with the next chunk over, which owns that face
+        const unsigned int section = worldPosition.y / CHUNK_SECTION_HEIGHT;
+
+        if (localPosition.x == static_cast<int>(CHUNK_SIZE) - 1) {
+            markChunkDirty(found->getPosition() + glm::ivec2(1, 0), section);
+        }
+        if (localPosition.z == static_cast<int>(CHUNK_SIZE) - 1) {
+            markChunkDirty(found->getPosition() + glm::ivec2(0, 1), section);
+        }
+
+        return true;
+    }
+
+    void World::markChunkDirty(const glm::ivec2 chunkPosition, const unsigned int section) {
+        const int index = getChunkIndex(chunkPosition);
+        if (index < 0) {
+            return;
+        }
+
+        Chunk& chunk = *m_chunks[index];
+        if (chunk.getDirtySections() == 0) {
+            m_dirtyChunks.push_back(static_cast<unsigned int>(index));
+        }
+
+        chunk.markSectionDirty(section);
+    }
+
+    glm::ivec3 World::getMinBlock() const {
+        return glm::ivec3(-m_radius * static_cast<int>(CHUNK_SIZE), 0, -m_radius * static_cast<int>(CHUNK_SIZE));
+    }
+
+    glm::ivec3 World::getMaxBlock() const {
+        return glm::ivec3((m_radius + 1) * static_cast<int>(CHUNK_SIZE), CHUNK_HEIGHT, (m_radius + 1) * static_cast<int>(CHUNK_SIZE));
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "chunk.hpp"
+#include "draw_command.hpp"
+#include "bounding_box.hpp"
+#include "quad_index_buffer.hpp"
+#include <memory>
+
+namespace minecraft::world {
+    constexpr int DEFAULT_WORLD_RADIUS = 8;
+    // Each chunk's range of the face buffer has room to grow by a quarter plus this many faces, so most
+    // edits patch their own range in place rather than lay the whole buffer out again
+    constexpr unsigned int CHUNK_FACE_SLACK = 64;
+    constexpr unsigned int CHUNK_FACE_SLACK_DIVISOR = 4;
+
+    // What the next face upload sends
+    struct FaceUpload {
+        unsigned int chunks;
+        size_t bytes;
+        // A chunk outgrew its range, so the buffer was laid out again and goes up whole
+        bool full;
+    };
+
+    class World {
+    public:
+        explicit World(int radius);
+        ~World();
+
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+        void generate();
+        bool buildMeshes();
+        bool buildFaces();
+        // Refaces only the sections changed by setBlock since the last build and refreshes those chunks' draw
+        // records, returns how many chunks that touched. CPU only, updateFaces also uploads the result
+        unsigned int remeshDirtySections();
+        // Uploads only the face ranges and records of the chunks remeshed, false when nothing had changed
+        bool updateFaces();
+        // Marks every section of every chunk dirty, so the next remesh refaces the whole world
+        void invalidateFaces();
+        bool updateMeshes();
+
+        void bind() const;
+        void draw(const std::vector<primitive::DrawElementsIndirectCommand>& commands) const;
+
+        // One per chunk, current after every remesh even without a GL context
+        [[nodiscard]]
+        const std::vector<primitive::ChunkDrawRecord>& getDrawRecords() const;
+        [[nodiscard]]
+        FaceUpload getPendingUpload() const;
+        // Face and record buffers as laid out, slack included
+        [[nodiscard]]
+        size_t getFaceBufferSize() const;
+        // Forgets what hasn't been uploaded as if it had been, for headless runs with nowhere to send it
+        void discardPendingUpload();
+        [[nodiscard]]
+        unsigned int getRecordBuffer() const;
+        [[nodiscard]]
+        std::vector<primitive::BoundingBox> getOccluders() const;
+        // Each chunk's draw record bounds, indexed like the records
+        [[nodiscard]]
+        std::vector<primitive::BoundingBox> getOccludees() const;
+
+        [[nodiscard]]
+        int getChunkIndex(glm::ivec2 chunkPosition) const;
+        [[nodiscard]]
+        unsigned int getChunkCount() const;
+        [[nodiscard]]
+        const Chunk& getChunk(unsigned int index) const;
+        // Null outside the generated area
+        [[nodiscard]]
+        const Chunk* getChunkAt(glm::ivec3 worldPosition) const;
+        [[nodiscard]]
+        const Block* getBlock(glm::ivec3 worldPosition) const;
+        // False outside the generated area
+        bool setBlock(glm::ivec3 worldPosition, Block block);
+
+        // Block space bounds of the generated area, max exclusive
+        [[nodiscard]]
+        glm::ivec3 getMinBlock() const;
+        [[nodiscard]]
+        glm::ivec3 getMaxBlock() const;
+
+    private:
+        // Sends the pending upload, returns how many faces went up
+        size_t uploadFaces();
+        // Bounds and face count of a chunk whose faces changed, queued for upload
+        void updateRecord(unsigned int index);
+        // Gives every chunk a range of the face buffer with slack to grow into
+        void layoutFaces();
+        // Queues a section for refacing, nothing happens outside the generated area
+        void markChunkDirty(glm::ivec2 chunkPosition, unsigned int section);
+
+        int m_radius{};
+
+        std::vector<std::unique_ptr<Chunk>> m_chunks{};
+        // Chunks with dirty sections, each listed once
+        std::vector<unsigned int> m_dirtyChunks{};
+        std::vector<primitive::ChunkDrawRecord> m_drawRecords{};
+        // Faces each chunk's range can hold, the ranges are contiguous and in chunk order
+        std::vector<unsigned int> m_faceCapacities{};
+        unsigned int m_faceCapacity{};
+        // Chunks whose range and record the GPU copy is missing, each listed once
+        std::vector<unsigned int> m_uploadChunks{};
+        std::vector<unsigned char> m_uploadPending{};
+        bool m_fullUpload{};
+
+        opengl::QuadIndexBuffer m_quadIndices{};
+
+        unsigned int m_vertexArray{};
+        unsigned int m_faceBuffer{};
+        unsigned int m_recordBuffer{};
+        unsigned int m_commandBuffer{};
+
+        system::MemoryReservation m_faceMemory{system::MemoryTag::GPU_BUFFERS};
+        system::MemoryReservation m_recordMemory{system::MemoryTag::GPU_BUFFERS};
+        // Resized by the const draw() every time the command count changes
+        mutable system::MemoryReservation m_commandMemory{system::MemoryTag::GPU_BUFFERS};
+    };
+}
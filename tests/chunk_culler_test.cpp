@@ -0,0 +1,145 @@
+#include "test.hpp"
+#include "chunk_culler.hpp"
+#include "packed_face.hpp"
+
+#include <gtc/matrix_transform.hpp>
+#include <vector>
+
+using namespace minecraft::system;
+using namespace minecraft::primitive;
+
+namespace {
+    constexpr int DEPTH_SIZE = 64;
+
+    // Looking down -z from the origin, so boxes at negative z are in front of the camera
+    glm::mat4 getViewProj() {
+        const glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return projection * view;
+    }
+
+    ChunkDrawRecord makeRecord(const glm::vec3 aabbMin, const glm::vec3 aabbMax, const unsigned int firstFace, const unsigned int faceCount) {
+        ChunkDrawRecord record{};
+        record.origin = glm::vec4(aabbMin, 0.0f);
+        record.aabbMin = glm::vec4(aabbMin, 0.0f);
+        record.aabbMax = glm::vec4(aabbMax, 0.0f);
+        record.firstFace = firstFace;
+        record.faceCount = faceCount;
+        return record;
+    }
+
+    // Window depth of a point straight ahead at distance, as the depth buffer would store it
+    float getDepthAt(const float distance) {
+        const glm::vec4 clip = getViewProj() * glm::vec4(0.0f, 0.0f, -distance, 1.0f);
+        return clip.z / clip.w * 0.5f + 0.5f;
+    }
+
+    std::vector<ChunkDrawRecord> makeRecords() {
+        return {
+            makeRecord(glm::vec3(-1.0f, -1.0f, -20.0f), glm::vec3(1.0f, 1.0f, -10.0f), 0, 10),
+            // Behind the camera
+            makeRecord(glm::vec3(-1.0f, -1.0f, 10.0f), glm::vec3(1.0f, 1.0f, 20.0f), 10, 4),
+            // In view but empty
+            makeRecord(glm::vec3(-1.0f, -1.0f, -20.0f), glm::vec3(1.0f, 1.0f, -10.0f), 14, 0),
+            // Far off to the left
+            makeRecord(glm::vec3(-200.0f, -1.0f, -20.0f), glm::vec3(-190.0f, 1.0f, -10.0f), 14, 6),
+            makeRecord(glm::vec3(2.0f, -1.0f, -30.0f), glm::vec3(4.0f, 1.0f, -25.0f), 50, 3),
+            // In front of the wall the Hi-Z tests put at distance 5
+            makeRecord(glm::vec3(-1.0f, -1.0f, -3.0f), glm::vec3(1.0f, 1.0f, -2.0f), 60, 2),
+        };
+    }
+
+    void testFrustumRejection() {
+        const Frustum frustum = Frustum::fromMatrix(getViewProj());
+
+        CHECK(frustum.intersects(glm::vec3(-1.0f, -1.0f, -20.0f), glm::vec3(1.0f, 1.0f, -10.0f)));
+        CHECK(!frustum.intersects(glm::vec3(-1.0f, -1.0f, 10.0f), glm::vec3(1.0f, 1.0f, 20.0f)));
+        CHECK(!frustum.intersects(glm::vec3(-200.0f, -1.0f, -20.0f), glm::vec3(-190.0f, 1.0f, -10.0f)));
+        CHECK(!frustum.intersects(glm::vec3(-1.0f, -1.0f, -120.0f), glm::vec3(1.0f, 1.0f, -110.0f)));
+        // Straddling a plane still counts as visible
+        CHECK(frustum.intersects(glm::vec3(-30.0f, -1.0f, -20.0f), glm::vec3(-15.0f, 1.0f, -10.0f)));
+    }
+
+    void testCommandsAreCompactedInRecordOrder() {
+        const ChunkCuller culler;
+        const auto records = makeRecords();
+        std::vector<DrawElementsIndirectCommand> commands{};
+
+        CHECK(culler.cull(records, getViewProj(), nullptr, commands) == 3);
+        CHECK(commands.size() == 3);
+
+        if (commands.size() == 3) {
+            CHECK(commands[0].baseInstance == 0);
+            CHECK(commands[1].baseInstance == 4);
+            CHECK(commands[2].baseInstance == 5);
+        }
+
+        // An empty pyramid skips the occlusion test, like no pyramid at all
+        const HiZPyramid empty;
+        std::vector<DrawElementsIndirectCommand> unoccluded{};
+        CHECK(culler.cull(records, getViewProj(), &empty, unoccluded) == 3);
+    }
+
+    void testCommandFields() {
+        const auto records = makeRecords();
+        const DrawElementsIndirectCommand command = ChunkCuller::makeCommand(records[4], 4);
+
+        CHECK(command.count == 3 * INDICES_PER_FACE);
+        CHECK(command.instanceCount == 1);
+        CHECK(command.firstIndex == 0);
+        CHECK(command.baseVertex == static_cast<int>(50 * CORNERS_PER_FACE));
+        CHECK(command.baseInstance == 4);
+    }
+
+    void testPyramidKeepsMaxDepth() {
+        // 3x3 folds straight into 1x1, so the odd row and column must be kept
+        HiZPyramid hiz;
+        hiz.build({ 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f, 0.9f }, 3, 3);
+
+        CHECK(hiz.getLevelCount() == 2);
+        CHECK(hiz.getLevelSize(1) == glm::ivec2(1, 1));
+        CHECK(hiz.fetch(1, glm::ivec2(0, 0)) == 0.9f);
+        // Out of range texels clamp to the edge
+        CHECK(hiz.fetch(0, glm::ivec2(5, -1)) == 0.3f);
+    }
+
+    void testHiZRejection() {
+        const ChunkCuller culler;
+        const auto records = makeRecords();
+
+        // A wall across the whole view at distance 5 hides everything behind it
+        HiZPyramid wall;
+        wall.build(std::vector<float>(DEPTH_SIZE * DEPTH_SIZE, getDepthAt(5.0f)), DEPTH_SIZE, DEPTH_SIZE);
+
+        std::vector<DrawElementsIndirectCommand> commands{};
+        CHECK(culler.cull(records, getViewProj(), &wall, commands) == 1);
+        CHECK(commands.size() == 1 && commands[0].baseInstance == 5);
+
+        // With the wall only covering the left half, the record off to the right shows through
+        std::vector<float> halfDepth(DEPTH_SIZE * DEPTH_SIZE, 1.0f);
+        for (int y = 0; y < DEPTH_SIZE; y++) {
+            for (int x = 0; x < DEPTH_SIZE / 2; x++) {
+                halfDepth[y * DEPTH_SIZE + x] = getDepthAt(5.0f);
+            }
+        }
+
+        HiZPyramid halfWall;
+        halfWall.build(halfDepth, DEPTH_SIZE, DEPTH_SIZE);
+
+        const glm::mat4 viewProj = getViewProj();
+        CHECK(ChunkCuller::occluded(halfWall, viewProj, glm::vec3(-4.0f, -1.0f, -30.0f), glm::vec3(-2.0f, 1.0f, -25.0f)));
+        CHECK(!ChunkCuller::occluded(halfWall, viewProj, glm::vec3(2.0f, -1.0f, -30.0f), glm::vec3(4.0f, 1.0f, -25.0f)));
+        // Partly behind the camera can't be projected, so it is never occluded
+        CHECK(!ChunkCuller::occluded(wall, viewProj, glm::vec3(-1.0f, -1.0f, -10.0f), glm::vec3(1.0f, 1.0f, 10.0f)));
+    }
+}
+
+int main() {
+    testFrustumRejection();
+    testCommandsAreCompactedInRecordOrder();
+    testCommandFields();
+    testPyramidKeepsMaxDepth();
+    testHiZRejection();
+
+    return minecraft::test::failures;
+}
@@ -0,0 +1,89 @@
+#include "test.hpp"
+#include "file_watcher.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace minecraft::system;
+using namespace std::chrono_literals;
+
+namespace {
+    const std::filesystem::path SHADER_PATH = std::filesystem::temp_directory_path() / "minecraft_file_watcher_test.glsl";
+
+    void testChangeWaitsForDebounce() {
+        FileWatcher watcher(100ms);
+        const auto start = FileWatcher::Clock::now();
+
+        watcher.notify(SHADER_PATH, start);
+
+        CHECK(watcher.poll(start).empty());
+        CHECK(watcher.poll(start + 99ms).empty());
+
+        const auto changed = watcher.poll(start + 100ms);
+        CHECK(changed.size() == 1);
+        CHECK(!changed.empty() && changed[0] == std::filesystem::weakly_canonical(SHADER_PATH));
+
+        // Reported once, then forgotten
+        CHECK(watcher.poll(start + 200ms).empty());
+    }
+
+    void testBurstReportsOnce() {
+        FileWatcher watcher(100ms);
+        const auto start = FileWatcher::Clock::now();
+
+        // An editor's truncate + write + rename, each event restarting the quiet period
+        watcher.notify(SHADER_PATH, start);
+        watcher.notify(SHADER_PATH, start + 60ms);
+        watcher.notify(SHADER_PATH, start + 120ms);
+
+        CHECK(watcher.poll(start + 150ms).empty());
+        CHECK(watcher.poll(start + 219ms).empty());
+        CHECK(watcher.poll(start + 220ms).size() == 1);
+    }
+
+    void testFilesDebounceSeparately() {
+        FileWatcher watcher(100ms);
+        const auto start = FileWatcher::Clock::now();
+        const auto other = SHADER_PATH.parent_path() / "minecraft_file_watcher_test_other.glsl";
+
+        watcher.notify(SHADER_PATH, start);
+        watcher.notify(other, start + 50ms);
+
+        const auto first = watcher.poll(start + 100ms);
+        CHECK(first.size() == 1 && first[0] == std::filesystem::weakly_canonical(SHADER_PATH));
+
+        const auto second = watcher.poll(start + 150ms);
+        CHECK(second.size() == 1 && second[0] == std::filesystem::weakly_canonical(other));
+    }
+
+    void testWatchedDirectoryReportsWrites() {
+        const auto directory = std::filesystem::temp_directory_path() / "minecraft_file_watcher_test";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        FileWatcher watcher(100ms);
+        CHECK(watcher.watch(directory));
+        CHECK(!watcher.watch(directory / "missing"));
+
+        std::ofstream(directory / "water.glsl") << "void main() {}\n";
+
+        // Far enough ahead for both the debounce and the scanning fallback's interval
+        const auto later = FileWatcher::Clock::now() + 1s;
+        watcher.poll(later);
+        const auto changed = watcher.poll(later + 100ms);
+
+        CHECK(changed.size() == 1);
+        CHECK(!changed.empty() && changed[0].filename() == "water.glsl");
+
+        std::filesystem::remove_all(directory);
+    }
+}
+
+int main() {
+    testChangeWaitsForDebounce();
+    testBurstReportsOnce();
+    testFilesDebounceSeparately();
+    testWatchedDirectoryReportsWrites();
+
+    return minecraft::test::failures;
+}
@@ -0,0 +1,161 @@
+#include "test.hpp"
+#include "gpu_timer.hpp"
+
+#include <unordered_map>
+
+using namespace minecraft::opengl;
+
+namespace {
+    constexpr uint64_t NANOSECONDS_PER_MILLISECOND = 1000000;
+
+    // Stands in for the GPU: timestamps read a clock the test advances, and results only become available when
+    // the test says the GPU has caught up
+    struct FakeGpu {
+        uint64_t clock{};
+        bool available = true;
+        unsigned int created{};
+        unsigned int destroyed{};
+        unsigned int availabilityChecks{};
+        std::unordered_map<unsigned int, uint64_t> timestamps{};
+    };
+
+    struct FakeQueryBackend {
+        FakeGpu* gpu;
+
+        unsigned int create() {
+            return ++gpu->created;
+        }
+
+        void destroy(unsigned int) {
+            gpu->destroyed++;
+        }
+
+        void timestamp(const unsigned int query) {
+            gpu->timestamps[query] = gpu->clock;
+        }
+
+        bool isAvailable(unsigned int) {
+            gpu->availabilityChecks++;
+            return gpu->available;
+        }
+
+        uint64_t getResult(const unsigned int query) {
+            return gpu->timestamps.at(query);
+        }
+    };
+
+    void runFrame(BasicGpuTimer<FakeQueryBackend>& timer, FakeGpu& gpu, const uint64_t shadowMilliseconds, const uint64_t mainMilliseconds) {
+        timer.beginFrame();
+
+        timer.beginPass("shadow");
+        gpu.clock += shadowMilliseconds * NANOSECONDS_PER_MILLISECOND;
+        timer.endPass();
+
+        timer.beginPass("main");
+        gpu.clock += mainMilliseconds * NANOSECONDS_PER_MILLISECOND;
+        timer.endPass();
+    }
+
+    void testFramesAreReadAfterLatency() {
+        FakeGpu gpu{};
+        BasicGpuTimer<FakeQueryBackend> timer(FakeQueryBackend { &gpu });
+
+        // A frame is read back GPU_TIMER_LATENCY - 1 frames after it was recorded
+        for (size_t frame = 0; frame < GPU_TIMER_LATENCY - 1; frame++) {
+            runFrame(timer, gpu, 2, 5);
+            CHECK(timer.getTimings().empty());
+        }
+
+        runFrame(timer, gpu, 2, 5);
+        const auto timings = timer.getTimings();
+
+        CHECK(timings.size() == 2);
+        if (timings.size() == 2) {
+            CHECK(timings[0].name == "shadow" && timings[1].name == "main");
+            CHECK(timings[0].samples == 1 && timings[1].samples == 1);
+            CHECK(timings[0].avgMilliseconds == 2.0 && timings[1].avgMilliseconds == 5.0);
+        }
+    }
+
+    void testStatisticsOverWindow() {
+        FakeGpu gpu{};
+        BasicGpuTimer<FakeQueryBackend> timer(FakeQueryBackend { &gpu });
+
+        // Main takes 1, 2, 3 then 1, 2, 3 ms... for a whole window, plus the frames still in flight
+        for (size_t frame = 0; frame < GPU_TIMER_WINDOW + GPU_TIMER_LATENCY - 1; frame++) {
+            runFrame(timer, gpu, 1, frame % 3 + 1);
+        }
+
+        const auto timings = timer.getTimings();
+
+        CHECK(timings.size() == 2);
+        if (timings.size() == 2) {
+            const PassTiming& main = timings[1];
+            CHECK(main.samples == GPU_TIMER_WINDOW);
+            CHECK(main.minMilliseconds == 1.0 && main.maxMilliseconds == 3.0);
+            CHECK(main.avgMilliseconds > 1.9 && main.avgMilliseconds < 2.1);
+        }
+
+        // Older samples fall out of the window, once a whole window of newer frames has been read
+        for (size_t frame = 0; frame < GPU_TIMER_WINDOW + GPU_TIMER_LATENCY - 1; frame++) {
+            runFrame(timer, gpu, 1, 4);
+        }
+
+        const auto later = timer.getTimings();
+        CHECK(later.size() == 2 && later[1].minMilliseconds == 4.0 && later[1].maxMilliseconds == 4.0);
+    }
+
+    void testUnavailableFramesAreDropped() {
+        FakeGpu gpu{};
+        gpu.available = false;
+        BasicGpuTimer<FakeQueryBackend> timer(FakeQueryBackend { &gpu });
+
+        // Nothing is read while the GPU lags, and every frame still unread a lap later is dropped
+        for (size_t frame = 0; frame < GPU_TIMER_LATENCY * 2; frame++) {
+            runFrame(timer, gpu, 2, 5);
+        }
+
+        CHECK(timer.getTimings().empty());
+        CHECK(timer.getDroppedFrames() == GPU_TIMER_LATENCY);
+
+        // Once the GPU catches up the frames still in flight are read
+        gpu.available = true;
+        runFrame(timer, gpu, 2, 5);
+
+        const auto timings = timer.getTimings();
+        CHECK(timings.size() == 2 && timings[0].samples == GPU_TIMER_LATENCY - 1);
+    }
+
+    void testQueriesAreReused() {
+        FakeGpu gpu{};
+
+        {
+            BasicGpuTimer<FakeQueryBackend> timer(FakeQueryBackend { &gpu });
+
+            for (size_t frame = 0; frame < 100; frame++) {
+                runFrame(timer, gpu, 2, 5);
+            }
+
+            // Two passes of two queries, for each frame in flight
+            CHECK(gpu.created == GPU_TIMER_LATENCY * 4);
+
+            // A frame without passes has nothing to wait for
+            const unsigned int checks = gpu.availabilityChecks;
+            for (size_t frame = 0; frame < GPU_TIMER_LATENCY * 2; frame++) {
+                timer.beginFrame();
+            }
+            CHECK(gpu.availabilityChecks - checks == GPU_TIMER_LATENCY - 1);
+        }
+
+        CHECK(gpu.destroyed == gpu.created);
+    }
+}
+
+int main() {
+    testFramesAreReadAfterLatency();
+    testStatisticsOverWindow();
+    testUnavailableFramesAreDropped();
+    testQueriesAreReused();
+
+    return minecraft::test::failures;
+}
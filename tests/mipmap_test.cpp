@@ -0,0 +1,91 @@
+#include "test.hpp"
+#include "mipmap.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace minecraft::system;
+
+namespace {
+    // Straightforward 2x2 box filter with clamped edges, what the SIMD rows must agree with
+    std::vector<unsigned char> downsampleReference(const std::vector<unsigned char>& source, const int width, const int height) {
+        const int nextWidth = std::max(width / 2, 1);
+        const int nextHeight = std::max(height / 2, 1);
+        std::vector<unsigned char> result(nextWidth * nextHeight * 4);
+
+        for (int y = 0; y < nextHeight; y++) {
+            for (int x = 0; x < nextWidth; x++) {
+                const int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+                const int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+
+                for (int ch = 0; ch < 4; ch++) {
+                    const int sum = source[(y0 * width + x0) * 4 + ch] + source[(y0 * width + x1) * 4 + ch]
+                        + source[(y1 * width + x0) * 4 + ch] + source[(y1 * width + x1) * 4 + ch];
+                    result[(y * nextWidth + x) * 4 + ch] = static_cast<unsigned char>((sum + 2) >> 2);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<unsigned char> makeNoise(const int width, const int height, Random& random) {
+        std::vector<unsigned char> pixels(width * height * 4);
+        std::ranges::generate(pixels, [&random] { return static_cast<unsigned char>(random.next()); });
+        return pixels;
+    }
+
+    void testDownsampleMatchesReference() {
+        Random random(1);
+
+        // Widths either side of the four-pixel SIMD step, and odd sizes that clamp
+        for (const int width : { 1, 2, 3, 7, 8, 9, 16, 17, 33 }) {
+            for (const int height : { 1, 2, 5, 16 }) {
+                const std::vector<unsigned char> source = makeNoise(width, height, random);
+                std::vector<unsigned char> result(std::max(width / 2, 1) * std::max(height / 2, 1) * 4);
+
+                downsampleRGBA(source.data(), width, height, result.data());
+                CHECK(result == downsampleReference(source, width, height));
+            }
+        }
+    }
+
+    void testChainLevels() {
+        Random random(2);
+
+        for (const auto& [width, height] : { std::pair { 16, 16 }, std::pair { 32, 8 }, std::pair { 5, 3 }, std::pair { 1, 1 } }) {
+            const std::vector<unsigned char> source = makeNoise(width, height, random);
+            const auto chain = buildMipChain(source.data(), width, height);
+
+            CHECK(static_cast<int>(chain.size()) == getMipLevelCount(width, height));
+            CHECK(chain.front() == source);
+            CHECK(chain.back().size() == 4);
+
+            // Every level is the one before it filtered once
+            int levelWidth = width, levelHeight = height;
+            for (size_t level = 1; level < chain.size(); level++) {
+                CHECK(chain[level] == downsampleReference(chain[level - 1], levelWidth, levelHeight));
+                levelWidth = std::max(levelWidth / 2, 1);
+                levelHeight = std::max(levelHeight / 2, 1);
+            }
+        }
+    }
+
+    void testSolidColourSurvives() {
+        const std::vector<unsigned char> source(64 * 64 * 4, 200);
+
+        for (const auto& level : buildMipChain(source.data(), 64, 64)) {
+            CHECK(std::ranges::all_of(level, [](const unsigned char value) { return value == 200; }));
+        }
+    }
+}
+
+int main() {
+    testDownsampleMatchesReference();
+    testChainLevels();
+    testSolidColourSurvives();
+
+    return minecraft::test::failures;
+}
@@ -0,0 +1,95 @@
+#include "test.hpp"
+#include "packed_face.hpp"
+#include "quad.hpp"
+
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace minecraft::primitive;
+
+namespace {
+    // The faceCorners table face_vertex.glsl expands packed faces with
+    std::vector<glm::vec3> readShaderCorners() {
+        std::ifstream file(PROJECT_SOURCE_DIR "/shaders/face_vertex.glsl");
+        std::stringstream stream;
+        stream << file.rdbuf();
+        const std::string source = stream.str();
+
+        const size_t begin = source.find("faceCorners[");
+        const size_t end = source.find(");", begin);
+        if (begin == std::string::npos || end == std::string::npos) {
+            return {};
+        }
+
+        const std::string table = source.substr(begin, end - begin);
+        const std::regex corner(R"(vec3\(([0-9.]+), ([0-9.]+), ([0-9.]+)\))");
+
+        std::vector<glm::vec3> corners;
+        for (auto it = std::sregex_iterator(table.begin(), table.end(), corner); it != std::sregex_iterator(); ++it) {
+            corners.emplace_back(std::stof((*it)[1]), std::stof((*it)[2]), std::stof((*it)[3]));
+        }
+
+        return corners;
+    }
+
+    void testRoundTrip() {
+        const glm::ivec3 positions[] = { { 0, 0, 0 }, { 3, 17, 5 }, { 31, 255, 31 } };
+
+        for (const glm::ivec3 position : positions) {
+            for (unsigned int id = 0; id < DIRECTION_COUNT; id++) {
+                const auto direction = static_cast<Direction>(id);
+                const UnpackedFace face = unpackFace(packFace(position, direction, MAX_FACE_LAYER, MAX_FACE_LIGHT));
+
+                CHECK(face.position == position);
+                CHECK(face.direction == direction);
+                CHECK(face.layer == MAX_FACE_LAYER);
+                CHECK(face.light == MAX_FACE_LIGHT);
+            }
+        }
+    }
+
+    void testFieldsDontOverlap() {
+        // Each field at its maximum on its own, OR'd together, must equal all of them packed at once
+        const uint32_t x = packFace({ 31, 0, 0 }, Direction::UP, 0, 0).data;
+        const uint32_t y = packFace({ 0, 255, 0 }, Direction::UP, 0, 0).data;
+        const uint32_t z = packFace({ 0, 0, 31 }, Direction::UP, 0, 0).data;
+        const uint32_t direction = packFace({ 0, 0, 0 }, Direction::BACK, 0, 0).data;
+        const uint32_t layer = packFace({ 0, 0, 0 }, Direction::UP, MAX_FACE_LAYER, 0).data;
+        const uint32_t light = packFace({ 0, 0, 0 }, Direction::UP, 0, MAX_FACE_LIGHT).data;
+
+        CHECK((x & y) == 0 && (y & z) == 0 && (z & direction) == 0 && (direction & layer) == 0 && (layer & light) == 0);
+        CHECK((x | y | z | direction | layer | light) == packFace({ 31, 255, 31 }, Direction::BACK, MAX_FACE_LAYER, MAX_FACE_LIGHT).data);
+    }
+
+    void testShaderCornersMatchQuad() {
+        const std::vector<glm::vec3> corners = readShaderCorners();
+        CHECK(corners.size() == DIRECTION_COUNT * CORNERS_PER_FACE);
+
+        if (corners.size() != DIRECTION_COUNT * CORNERS_PER_FACE) {
+            return;
+        }
+
+        // A face unpacked and expanded the way the shader does must land on the CPU quad's corners
+        const glm::ivec3 position(7, 42, 19);
+
+        for (unsigned int id = 0; id < DIRECTION_COUNT; id++) {
+            const UnpackedFace face = unpackFace(packFace(position, static_cast<Direction>(id), 1, MAX_FACE_LIGHT));
+
+            for (unsigned int corner = 0; corner < CORNERS_PER_FACE; corner++) {
+                const glm::vec3 shaderCorner = glm::vec3(face.position) + corners[getDirectionID(face.direction) * 4 + corner];
+                CHECK(shaderCorner == glm::vec3(position) + QUAD_CORNERS[id][corner]);
+            }
+        }
+    }
+}
+
+int main() {
+    testRoundTrip();
+    testFieldsDontOverlap();
+    testShaderCornersMatchQuad();
+
+    return minecraft::test::failures;
+}
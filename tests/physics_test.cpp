@@ -0,0 +1,169 @@
+#include "test.hpp"
+#include "physics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace minecraft::world;
+
+namespace {
+    constexpr float TIMESTEP = 1.0f / 60.0f;
+
+    // Terrain top at x, z: every block below getTerrainHeight is solid
+    float getGroundHeight(const int x, const int z) {
+        return static_cast<float>(Chunk::getTerrainHeight(x, z));
+    }
+
+    bool isBitIdentical(const glm::vec3 a, const glm::vec3 b) {
+        return std::memcmp(&a, &b, sizeof(glm::vec3)) == 0;
+    }
+
+    void testBodyLandsOnTerrain() {
+        World world(1);
+        world.generate();
+
+        const float ground = getGroundHeight(0, 0);
+        PhysicsBody body{};
+        body.Position = glm::vec3(0.5f, ground + 10.0f, 0.5f);
+
+        bool landed = false;
+        for (int tick = 0; tick < 240 && !landed; tick++) {
+            stepBody(world, body, TIMESTEP);
+            landed = body.OnGround;
+        }
+
+        CHECK(landed);
+        CHECK(std::abs(body.Position.y - ground) < 1e-4f);
+        CHECK(body.Velocity.y == 0.0f);
+
+        // Resting bodies stay put and stay grounded
+        const glm::vec3 rest = body.Position;
+        for (int tick = 0; tick < 60; tick++) {
+            stepBody(world, body, TIMESTEP);
+        }
+
+        CHECK(body.OnGround);
+        CHECK(std::abs(body.Position.y - rest.y) < 1e-4f);
+    }
+
+    void testFastFallDoesNotTunnel() {
+        World world(1);
+        world.generate();
+
+        const float ground = getGroundHeight(4, 4);
+        PhysicsBody body{};
+        body.Position = glm::vec3(4.5f, ground + 40.0f, 4.5f);
+        body.Velocity.y = -TERMINAL_VELOCITY;
+
+        // A step this long moves well over a block, the sweep must still stop on the surface
+        for (int tick = 0; tick < 20; tick++) {
+            stepBody(world, body, 0.25f);
+        }
+
+        CHECK(body.OnGround);
+        CHECK(std::abs(body.Position.y - ground) < 1e-4f);
+    }
+
+    void testWallStopsMovement() {
+        World world(1);
+        world.generate();
+
+        // The terrain is flat along x = 0 up to the wall, so only the wall can stop the walk
+        const int ground = Chunk::getTerrainHeight(0, 0);
+        for (int y = ground; y < ground + 3; y++) {
+            for (int x = -1; x <= 1; x++) {
+                CHECK(world.setBlock(glm::ivec3(x, y, 5), Block(BlockType::TEST)));
+            }
+        }
+
+        PhysicsBody body{};
+        body.Position = glm::vec3(0.5f, static_cast<float>(ground), 0.5f);
+
+        for (int tick = 0; tick < 120; tick++) {
+            body.Velocity.z = PLAYER_WALK_SPEED;
+            stepBody(world, body, TIMESTEP);
+        }
+
+        // Flush against the wall's min z face
+        CHECK(std::abs(body.Position.z + body.HalfExtents.z - 5.0f) < 1e-4f);
+        CHECK(body.Velocity.z == 0.0f);
+        CHECK(body.OnGround);
+    }
+
+    void testJumpClearsOneBlock() {
+        World world(1);
+        world.generate();
+
+        const float ground = getGroundHeight(0, 0);
+        PhysicsBody body{};
+        body.Position = glm::vec3(0.5f, ground, 0.5f);
+        stepBody(world, body, TIMESTEP);
+        CHECK(body.OnGround);
+
+        body.Velocity.y = PLAYER_JUMP_VELOCITY;
+        float peak = body.Position.y;
+
+        for (int tick = 0; tick < 120; tick++) {
+            stepBody(world, body, TIMESTEP);
+            peak = std::max(peak, body.Position.y);
+        }
+
+        CHECK(peak - ground > 1.0f);
+        CHECK(body.OnGround);
+    }
+
+    // The same inputs from the same start give bit identical positions, in separately generated worlds too
+    void testStepIsDeterministic() {
+        World first(1);
+        first.generate();
+        World second(1);
+        second.generate();
+
+        const auto run = [](const World& world) {
+            PhysicsBody body{};
+            body.Position = glm::vec3(-7.5f, 40.0f, 3.25f);
+            std::vector<glm::vec3> positions{};
+
+            for (int tick = 0; tick < 600; tick++) {
+                // Walk a wobbling path over the terrain, jumping whenever grounded
+                const float heading = static_cast<float>(tick) * 0.05f;
+                body.Velocity.x = std::cos(heading) * PLAYER_WALK_SPEED;
+                body.Velocity.z = std::sin(heading) * PLAYER_WALK_SPEED;
+
+                if (body.OnGround && tick % 40 == 0) {
+                    body.Velocity.y = PLAYER_JUMP_VELOCITY;
+                }
+
+                stepBody(world, body, TIMESTEP);
+                positions.push_back(body.Position);
+            }
+
+            return positions;
+        };
+
+        const auto a = run(first);
+        const auto b = run(first);
+        const auto c = run(second);
+
+        CHECK(a.size() == b.size() && a.size() == c.size());
+
+        bool identical = true;
+        for (size_t i = 0; i < a.size() && i < b.size() && i < c.size(); i++) {
+            identical &= isBitIdentical(a[i], b[i]) && isBitIdentical(a[i], c[i]);
+        }
+
+        CHECK(identical);
+    }
+}
+
+int main() {
+    testBodyLandsOnTerrain();
+    testFastFallDoesNotTunnel();
+    testWallStopsMovement();
+    testJumpClearsOneBlock();
+    testStepIsDeterministic();
+
+    return minecraft::test::failures;
+}
@@ -0,0 +1,103 @@
+#include "test.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+using namespace minecraft::system;
+
+namespace {
+    // Half a ring, so a round never drops events before collect() drains it
+    constexpr size_t ZONES_PER_ROUND = PROFILER_RING_CAPACITY / 2;
+    constexpr int ROUNDS = 8;
+
+    // Loose enough for an unoptimised build on a busy machine, tight enough to catch a lock or an allocation per zone
+    constexpr double MAX_ENABLED_ZONE_NANOSECONDS = 1000.0;
+    constexpr double MAX_DISABLED_ZONE_NANOSECONDS = 100.0;
+    constexpr double MAX_COLLECTED_ZONE_NANOSECONDS = 1000.0;
+
+    template <typename Work>
+    double getNanosecondsPerZone(Work&& work) {
+        const auto start = std::chrono::steady_clock::now();
+        work();
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / static_cast<double>(ZONES_PER_ROUND);
+    }
+
+    void openZones() {
+        for (size_t i = 0; i < ZONES_PER_ROUND; i++) {
+            ProfileZone zone("profiler_test");
+        }
+    }
+
+    uint64_t getZoneCount() {
+        const auto stats = Profiler::get().getStats();
+        const auto zone = std::ranges::find(stats, "profiler_test", &ZoneStats::name);
+        return zone == stats.end() ? 0 : zone->count;
+    }
+
+    void testZoneOverhead() {
+        Profiler& profiler = Profiler::get();
+        profiler.reset();
+
+        // The fastest round of each, the others mostly measure the scheduler
+        double enabled = std::numeric_limits<double>::infinity();
+        double disabled = std::numeric_limits<double>::infinity();
+        double collected = std::numeric_limits<double>::infinity();
+
+        for (int round = 0; round < ROUNDS; round++) {
+            profiler.setEnabled(true);
+            enabled = std::min(enabled, getNanosecondsPerZone(openZones));
+            collected = std::min(collected, getNanosecondsPerZone([&profiler] { profiler.collect(); }));
+
+            profiler.setEnabled(false);
+            disabled = std::min(disabled, getNanosecondsPerZone(openZones));
+            profiler.collect();
+        }
+
+        profiler.setEnabled(true);
+
+        std::cout << "Per zone: " << enabled << "ns enabled, " << disabled << "ns disabled, "
+                  << collected << "ns to collect" << std::endl;
+
+        CHECK(enabled < MAX_ENABLED_ZONE_NANOSECONDS);
+        CHECK(disabled < MAX_DISABLED_ZONE_NANOSECONDS);
+        CHECK(collected < MAX_COLLECTED_ZONE_NANOSECONDS);
+
+        // Only the enabled rounds were recorded, and none were dropped
+        CHECK(getZoneCount() == ZONES_PER_ROUND * ROUNDS);
+    }
+
+    void testNestedZonesAreRecorded() {
+        Profiler& profiler = Profiler::get();
+        profiler.reset();
+
+        {
+            ProfileZone outer("profiler_test_outer");
+            ProfileZone inner("profiler_test_inner");
+        }
+
+        profiler.collect();
+        const auto stats = profiler.getStats();
+
+        CHECK(stats.size() == 2);
+        CHECK(std::ranges::find(stats, "profiler_test_outer", &ZoneStats::name) != stats.end());
+        CHECK(std::ranges::find(stats, "profiler_test_inner", &ZoneStats::name) != stats.end());
+
+        // Printing the table leaves std::cout formatting as it found it
+        const auto flags = std::cout.flags();
+        const auto precision = std::cout.precision();
+        profiler.printStats();
+
+        CHECK(std::cout.flags() == flags);
+        CHECK(std::cout.precision() == precision);
+    }
+}
+
+int main() {
+    testZoneOverhead();
+    testNestedZonesAreRecorded();
+
+    return minecraft::test::failures;
+}
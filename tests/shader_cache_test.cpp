@@ -0,0 +1,114 @@
+#include "test.hpp"
+#include "shader_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace minecraft::system;
+
+namespace {
+    const std::filesystem::path CACHE_PATH = std::filesystem::temp_directory_path() / "minecraft_shader_cache_test";
+
+    ShaderBinary makeBinary() {
+        ShaderBinary binary { 0x8e21, {} };
+        for (int i = 0; i < 300; i++) {
+            binary.data.push_back(static_cast<unsigned char>(i * 7));
+        }
+
+        return binary;
+    }
+
+    void testStoreLoadRoundTrip() {
+        std::filesystem::remove_all(CACHE_PATH);
+        const ShaderCache cache(CACHE_PATH);
+        const uint64_t key = ShaderCache::makeKey({ "vertex", "fragment" }, "", "driver");
+
+        CHECK(!cache.load(key).has_value());
+        CHECK(cache.store(key, makeBinary()));
+
+        const auto loaded = cache.load(key);
+        CHECK(loaded.has_value());
+        if (loaded) {
+            CHECK(loaded->format == makeBinary().format);
+            CHECK(loaded->data == makeBinary().data);
+        }
+
+        // Another key never reads this entry
+        CHECK(!cache.load(key + 1).has_value());
+
+        cache.invalidate(key);
+        CHECK(!std::filesystem::exists(cache.getPath(key)));
+        CHECK(!cache.load(key).has_value());
+    }
+
+    void testKeyChangesWithInputs() {
+        const uint64_t key = ShaderCache::makeKey({ "vertex", "fragment" }, "#define FOG\n", "driver 1");
+
+        CHECK(key == ShaderCache::makeKey({ "vertex", "fragment" }, "#define FOG\n", "driver 1"));
+        CHECK(key != ShaderCache::makeKey({ "vertex", "fragment2" }, "#define FOG\n", "driver 1"));
+        CHECK(key != ShaderCache::makeKey({ "fragment", "vertex" }, "#define FOG\n", "driver 1"));
+        CHECK(key != ShaderCache::makeKey({ "vertex", "fragment" }, "", "driver 1"));
+        CHECK(key != ShaderCache::makeKey({ "vertex", "fragment" }, "#define FOG\n", "driver 2"));
+
+        // The same text split differently between the stages is a different program
+        CHECK(key != ShaderCache::makeKey({ "vertexf", "ragment" }, "#define FOG\n", "driver 1"));
+        CHECK(key != ShaderCache::makeKey({ "vertexfragment" }, "#define FOG\n", "driver 1"));
+        CHECK(ShaderCache::makeKey({ "a", "" }, "b", "") != ShaderCache::makeKey({ "a" }, "b", ""));
+    }
+
+    void testTruncatedEntryIsRemoved() {
+        std::filesystem::remove_all(CACHE_PATH);
+        const ShaderCache cache(CACHE_PATH);
+        const uint64_t key = ShaderCache::makeKey({ "truncated" }, "", "driver");
+
+        CHECK(cache.store(key, makeBinary()));
+        const auto path = cache.getPath(key);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+
+        CHECK(!cache.load(key).has_value());
+        CHECK(!std::filesystem::exists(path));
+
+        // Shorter than the header
+        std::ofstream(path, std::ios::binary) << "SHD";
+        CHECK(!cache.load(key).has_value());
+        CHECK(!std::filesystem::exists(path));
+    }
+
+    void testCorruptEntryIsRemoved() {
+        std::filesystem::remove_all(CACHE_PATH);
+        const ShaderCache cache(CACHE_PATH);
+        const uint64_t key = ShaderCache::makeKey({ "corrupt" }, "", "driver");
+
+        CHECK(cache.store(key, makeBinary()));
+        const auto path = cache.getPath(key);
+
+        // Flip a byte of the program, the checksum no longer matches
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(-1, std::ios::end);
+            file.put('\x5a');
+        }
+
+        CHECK(!cache.load(key).has_value());
+        CHECK(!std::filesystem::exists(path));
+
+        // An entry copied under another key's name is stale too
+        const uint64_t other = ShaderCache::makeKey({ "other" }, "", "driver");
+        CHECK(cache.store(key, makeBinary()));
+        std::filesystem::rename(path, cache.getPath(other));
+
+        CHECK(!cache.load(other).has_value());
+        CHECK(!std::filesystem::exists(cache.getPath(other)));
+
+        std::filesystem::remove_all(CACHE_PATH);
+    }
+}
+
+int main() {
+    testStoreLoadRoundTrip();
+    testKeyChangesWithInputs();
+    testTruncatedEntryIsRemoved();
+    testCorruptEntryIsRemoved();
+
+    return minecraft::test::failures;
+}
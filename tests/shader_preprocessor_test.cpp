@@ -0,0 +1,167 @@
+#include "test.hpp"
+#include "shader_preprocessor.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace minecraft::system;
+
+namespace {
+    // A fresh include directory per run, so earlier runs can't leave files behind
+    class ShaderDirectory {
+    public:
+        ShaderDirectory()
+            : m_path(std::filesystem::temp_directory_path() / "minecraft_shader_preprocessor_test") {
+            std::filesystem::remove_all(m_path);
+            std::filesystem::create_directories(m_path);
+        }
+
+        ~ShaderDirectory() {
+            std::filesystem::remove_all(m_path);
+        }
+
+        void write(const std::string& name, const std::string& source) const {
+            const auto path = m_path / name;
+            std::filesystem::create_directories(path.parent_path());
+            std::ofstream(path) << source;
+        }
+
+        [[nodiscard]]
+        const std::filesystem::path& getPath() const {
+            return m_path;
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+
+    size_t countOccurrences(const std::string& text, const std::string& pattern) {
+        size_t count = 0;
+
+        for (size_t at = text.find(pattern); at != std::string::npos; at = text.find(pattern, at + 1)) {
+            count++;
+        }
+
+        return count;
+    }
+
+    void testIncludeIsSpliced() {
+        const ShaderDirectory directory;
+        directory.write("main.glsl", "#version 460 core\n#include \"lib/common.glsl\"\nvoid main() {}\n");
+        directory.write("lib/common.glsl", "#version 460 core\nfloat common() { return 1.0; }\n");
+
+        const ShaderPreprocessor preprocessor(directory.getPath());
+        const auto shader = preprocessor.process("main.glsl", {});
+
+        CHECK(shader.has_value());
+        if (!shader) {
+            return;
+        }
+
+        // The include's own #version is dropped, only the outermost one is kept
+        CHECK(shader->source == "#version 460 core\nfloat common() { return 1.0; }\nvoid main() {}\n");
+        CHECK(shader->dependencies.size() == 2);
+
+        CHECK(shader->lineMap.size() == 3);
+        if (shader->lineMap.size() == 3) {
+            CHECK(shader->lineMap[0].file == "main.glsl" && shader->lineMap[0].line == 1);
+            CHECK(shader->lineMap[1].file == "lib/common.glsl" && shader->lineMap[1].line == 2);
+            CHECK(shader->lineMap[2].file == "main.glsl" && shader->lineMap[2].line == 3);
+        }
+    }
+
+    void testPragmaOnceIncludesOnce() {
+        const ShaderDirectory directory;
+        directory.write("main.glsl", "#version 460 core\n#include \"a.glsl\"\n#include \"b.glsl\"\n#include \"once.glsl\"\n");
+        directory.write("a.glsl", "#include \"once.glsl\"\n");
+        directory.write("b.glsl", "#include <once.glsl>\n");
+        directory.write("once.glsl", "#pragma once\nconst float ONCE = 1.0;\n");
+
+        const ShaderPreprocessor preprocessor(directory.getPath());
+        const auto shader = preprocessor.process("main.glsl", {});
+
+        CHECK(shader.has_value());
+        if (shader) {
+            CHECK(countOccurrences(shader->source, "const float ONCE") == 1);
+            CHECK(shader->source.find("#pragma once") == std::string::npos);
+        }
+
+        // Without the pragma every include is spliced in
+        directory.write("once.glsl", "const float ONCE = 1.0;\n");
+        const auto repeated = preprocessor.process("main.glsl", {});
+
+        CHECK(repeated.has_value());
+        if (repeated) {
+            CHECK(countOccurrences(repeated->source, "const float ONCE") == 3);
+        }
+    }
+
+    void testRecursiveIncludeFails() {
+        const ShaderDirectory directory;
+        directory.write("main.glsl", "#version 460 core\n#include \"a.glsl\"\n");
+        directory.write("a.glsl", "#include \"b.glsl\"\n");
+        directory.write("b.glsl", "#include \"a.glsl\"\n");
+        directory.write("self.glsl", "#version 460 core\n#include \"self.glsl\"\n");
+
+        const ShaderPreprocessor preprocessor(directory.getPath());
+
+        CHECK(!preprocessor.process("main.glsl", {}).has_value());
+        CHECK(!preprocessor.process("self.glsl", {}).has_value());
+    }
+
+    void testMissingIncludeFails() {
+        const ShaderDirectory directory;
+        directory.write("main.glsl", "#version 460 core\n#include \"missing.glsl\"\n");
+        directory.write("malformed.glsl", "#version 460 core\n#include missing.glsl\n");
+
+        const ShaderPreprocessor preprocessor(directory.getPath());
+
+        CHECK(!preprocessor.process("main.glsl", {}).has_value());
+        CHECK(!preprocessor.process("malformed.glsl", {}).has_value());
+    }
+
+    void testUnusedDefinesAreDropped() {
+        const ShaderDirectory directory;
+        directory.write("main.glsl", "#version 460 core\n#ifdef USE_FOG\n#endif\n");
+
+        const ShaderPreprocessor preprocessor(directory.getPath());
+        const auto used = preprocessor.process("main.glsl", { { "USE_FOG", "" }, { "UNUSED", "1" } });
+        const auto plain = preprocessor.process("main.glsl", { { "USE_FOG", "" } });
+
+        CHECK(used.has_value() && plain.has_value());
+        if (used && plain) {
+            CHECK(used->source == "#version 460 core\n#define USE_FOG\n#ifdef USE_FOG\n#endif\n");
+            CHECK(used->hash == plain->hash);
+            CHECK(used->lineMap[1].file == "<defines>");
+        }
+    }
+
+    void testErrorLogIsMapped() {
+        const ShaderDirectory directory;
+        directory.write("main.glsl", "#version 460 core\n#include \"lib.glsl\"\nvoid main() {}\n");
+        directory.write("lib.glsl", "\nfloat broken(\n");
+
+        const ShaderPreprocessor preprocessor(directory.getPath());
+        const auto shader = preprocessor.process("main.glsl", {});
+
+        CHECK(shader.has_value());
+        if (shader) {
+            // Output line 3 is lib.glsl line 2, in both the NVIDIA and Mesa formats
+            CHECK(ShaderPreprocessor::mapErrorLog("0(3) : error C0000: syntax error", *shader) == "lib.glsl:2 : error C0000: syntax error\n");
+            CHECK(ShaderPreprocessor::mapErrorLog("ERROR: 0:3: syntax error", *shader) == "ERROR: lib.glsl:2: syntax error\n");
+        }
+    }
+}
+
+int main() {
+    testIncludeIsSpliced();
+    testPragmaOnceIncludesOnce();
+    testRecursiveIncludeFails();
+    testMissingIncludeFails();
+    testUnusedDefinesAreDropped();
+    testErrorLogIsMapped();
+
+    return minecraft::test::failures;
+}
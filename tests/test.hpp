@@ -0,0 +1,16 @@
+#pragma once
+
+#include <iostream>
+
+// Minimal checks for the CTest executables, a test fails by returning a non-zero failure count from main
+namespace minecraft::test {
+    inline int failures = 0;
+}
+
+#define CHECK(condition)                                                                                    \
+    do {                                                                                                    \
+        if (!(condition)) {                                                                                 \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl;     \
+            minecraft::test::failures++;                                                                    \
+        }                                                                                                   \
+    } while (false)